@@ -0,0 +1,614 @@
+/*
+Micro-benchmarks for coordConv, for tracking performance between releases
+
+Times the following (in C++, so the numbers do not include SWIG and Python overhead):
+- CoordSys.convertFrom for every pair of coordinate systems supported by makeCoordSys (except "none"),
+  for Coord and PVTCoord, with and without proper motion and with and without orientation
+- Coord.offset, Coord.orientationTo, Coord.angularSeparation and angSideAng
+- math utilities: sind and cosd versus sincosd (scalar and array), and hypot
+- obsFromAppTopo and appTopoFromObs, with and without a RefractionCache
+- lastFromTAI, with and without a SiderealTimeCache
+- cache refresh paths: AppGeoCoordSys.setDate (cache hit and miss), computing SiderealTimeData,
+  and Tracker.prepare and Tracker.convert
+
+Conversions are performed at a fixed TAI date, so date-dependent cached data is reused;
+the cost of refreshing that data is measured separately (group "cache").
+
+Usage: benchCoordConv [--csv | --json] [--minTime=sec] [--match=substring]
+- --csv (default) or --json: output format (written to stdout)
+- --minTime: minimum time to spend timing each benchmark (sec); default 0.1
+- --match: only run benchmarks whose name includes this substring
+
+Each result reports the benchmark group and name, the number of calls timed
+and the mean time per call (ns). Each benchmark is run once before timing, to warm caches.
+The number of calls is doubled until the total time is at least minTime.
+*/
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "boost/shared_ptr.hpp"
+#include "coordConv/coordConv.h"
+#include "coordConv/appTopoFromObs.h"
+#include "coordConv/obsFromAppTopo.h"
+
+namespace {
+
+    // coordinate systems supported by makeCoordSys, excluding "none"
+    char const * const CoordSysNames[] = {"icrs", "fk5", "fk4", "gal", "appgeo", "apptopo", "obs"};
+    int const NumCoordSys = sizeof(CoordSysNames) / sizeof(CoordSysNames[0]);
+
+    double const TAI = 4.9e9;   // TAI date of conversions (MJD, sec), in 2014
+    double const FromDir = 5.0; // initial orientation (deg), for conversions that compute orientation
+
+    /*
+    Return a realistic site (for the APO 3.5m telescope)
+    */
+    coordConv::Site makeSite() {
+        coordConv::Site site(-105.822616, 32.780988, 2788);
+        site.setPoleWander(0.89e-5, 0.92e-4);
+        site.ut1_tai = -34.782;
+        site.refCoA = 1.2e-2;
+        site.refCoB = -1.3e-5;
+        return site;
+    }
+
+    /*
+    Return a coordinate system with a typical date: mean systems are not current, other systems are current
+    */
+    coordConv::CoordSys::Ptr makeBenchCoordSys(std::string const &name) {
+        if (name == "fk4") {
+            return coordConv::makeCoordSys(name, 1950);
+        } else if ((name == "fk5") || (name == "icrs") || (name == "gal")) {
+            return coordConv::makeCoordSys(name, 2000);
+        }
+        return coordConv::makeCoordSys(name, 0);
+    }
+
+    /*
+    A benchmark: run(numCalls) performs the operation numCalls times
+
+    run returns a value computed from the results, which the caller accumulates,
+    to prevent the compiler from optimizing away the operation.
+    */
+    class Benchmark {
+    public:
+        typedef boost::shared_ptr<Benchmark> Ptr;
+
+        explicit Benchmark(std::string const &group, std::string const &name) : group(group), name(name) {}
+        virtual ~Benchmark() {}
+        virtual double run(long numCalls) = 0;
+
+        std::string const group;
+        std::string const name;
+    };
+
+    class ConvertCoordBenchmark : public Benchmark {
+    public:
+        explicit ConvertCoordBenchmark(std::string const &name, coordConv::CoordSys::Ptr toSysPtr,
+            coordConv::CoordSys::Ptr fromSysPtr, coordConv::Coord const &fromCoord, bool useDir,
+            coordConv::Site const &site)
+        :
+            Benchmark("convertCoord", name), _toSysPtr(toSysPtr), _fromSysPtr(fromSysPtr),
+            _fromCoord(fromCoord), _useDir(useDir), _site(site)
+        {}
+
+        virtual double run(long numCalls) {
+            double sum = 0;
+            double toDir, scaleChange;
+            for (long i = 0; i < numCalls; ++i) {
+                if (_useDir) {
+                    sum += _toSysPtr->convertFrom(toDir, scaleChange, *_fromSysPtr, _fromCoord, FromDir, _site, TAI)
+                        .getVecPos()(0) + toDir;
+                } else {
+                    sum += _toSysPtr->convertFrom(*_fromSysPtr, _fromCoord, _site, TAI).getVecPos()(0);
+                }
+            }
+            return sum;
+        }
+
+    private:
+        coordConv::CoordSys::Ptr _toSysPtr;
+        coordConv::CoordSys::Ptr _fromSysPtr;
+        coordConv::Coord _fromCoord;
+        bool _useDir;
+        coordConv::Site _site;
+    };
+
+    class ConvertPVTCoordBenchmark : public Benchmark {
+    public:
+        explicit ConvertPVTCoordBenchmark(std::string const &name, coordConv::CoordSys::Ptr toSysPtr,
+            coordConv::CoordSys::Ptr fromSysPtr, coordConv::PVTCoord const &fromPVTCoord, bool useDir,
+            coordConv::Site const &site)
+        :
+            Benchmark("convertPVTCoord", name), _toSysPtr(toSysPtr), _fromSysPtr(fromSysPtr),
+            _fromPVTCoord(fromPVTCoord), _fromDir(FromDir, 0, TAI), _useDir(useDir), _site(site)
+        {}
+
+        virtual double run(long numCalls) {
+            double sum = 0;
+            coordConv::PVT toDir;
+            double scaleChange;
+            for (long i = 0; i < numCalls; ++i) {
+                if (_useDir) {
+                    sum += _toSysPtr->convertFrom(toDir, scaleChange, *_fromSysPtr, _fromPVTCoord, _fromDir, _site)
+                        .getCoord().getVecPos()(0) + toDir.pos;
+                } else {
+                    sum += _toSysPtr->convertFrom(*_fromSysPtr, _fromPVTCoord, _site).getCoord().getVecPos()(0);
+                }
+            }
+            return sum;
+        }
+
+    private:
+        coordConv::CoordSys::Ptr _toSysPtr;
+        coordConv::CoordSys::Ptr _fromSysPtr;
+        coordConv::PVTCoord _fromPVTCoord;
+        coordConv::PVT _fromDir;
+        bool _useDir;
+        coordConv::Site _site;
+    };
+
+    class OffsetBenchmark : public Benchmark {
+    public:
+        explicit OffsetBenchmark() : Benchmark("helper", "Coord.offset"), _coord(120, 45) {}
+
+        virtual double run(long numCalls) {
+            double sum = 0;
+            double toOrient;
+            for (long i = 0; i < numCalls; ++i) {
+                sum += _coord.offset(toOrient, 30, 0.5 + (i % 8)).getVecPos()(0) + toOrient;
+            }
+            return sum;
+        }
+
+    private:
+        coordConv::Coord _coord;
+    };
+
+    class OrientationToBenchmark : public Benchmark {
+    public:
+        explicit OrientationToBenchmark() : Benchmark("helper", "Coord.orientationTo"), _coord(120, 45), _coord2(125, 47) {}
+
+        virtual double run(long numCalls) {
+            double sum = 0;
+            for (long i = 0; i < numCalls; ++i) {
+                sum += _coord.orientationTo(_coord2);
+            }
+            return sum;
+        }
+
+    private:
+        coordConv::Coord _coord;
+        coordConv::Coord _coord2;
+    };
+
+    class AngularSeparationBenchmark : public Benchmark {
+    public:
+        explicit AngularSeparationBenchmark() : Benchmark("helper", "Coord.angularSeparation"), _coord(120, 45), _coord2(125, 47) {}
+
+        virtual double run(long numCalls) {
+            double sum = 0;
+            for (long i = 0; i < numCalls; ++i) {
+                sum += _coord.angularSeparation(_coord2);
+            }
+            return sum;
+        }
+
+    private:
+        coordConv::Coord _coord;
+        coordConv::Coord _coord2;
+    };
+
+    class AngSideAngBenchmark : public Benchmark {
+    public:
+        explicit AngSideAngBenchmark() : Benchmark("helper", "angSideAng") {}
+
+        virtual double run(long numCalls) {
+            double sum = 0;
+            double angA, sideB, angC;
+            for (long i = 0; i < numCalls; ++i) {
+                coordConv::angSideAng(angA, sideB, angC, 30 + (i % 8), 45, 60);
+                sum += angA + sideB + angC;
+            }
+            return sum;
+        }
+    };
+
+    class SinCosBenchmark : public Benchmark {
+    public:
+        explicit SinCosBenchmark(std::string const &name, bool useSinCosD)
+        :
+            Benchmark("math", name), _useSinCosD(useSinCosD)
+        {}
+
+        virtual double run(long numCalls) {
+            double sum = 0;
+            for (long i = 0; i < numCalls; ++i) {
+                double const ang = -200.0 + 0.37 * (i % 1024);
+                if (_useSinCosD) {
+                    double sinAng, cosAng;
+                    coordConv::sincosd(sinAng, cosAng, ang);
+                    sum += sinAng + cosAng;
+                } else {
+                    sum += coordConv::sind(ang) + coordConv::cosd(ang);
+                }
+            }
+            return sum;
+        }
+
+    private:
+        bool _useSinCosD;
+    };
+
+    /*
+    Compute sincosd of an array of angles; each call is one array
+    */
+    class SinCosArrayBenchmark : public Benchmark {
+    public:
+        explicit SinCosArrayBenchmark(std::string const &name, int numAng)
+        :
+            Benchmark("math", name),
+            _angArr(Eigen::ArrayXd::LinSpaced(numAng, -200.0, 200.0)),
+            _sinArr(numAng),
+            _cosArr(numAng)
+        {}
+
+        virtual double run(long numCalls) {
+            double sum = 0;
+            for (long i = 0; i < numCalls; ++i) {
+                coordConv::sincosd(_sinArr, _cosArr, _angArr);
+                sum += _sinArr(i % _sinArr.size()) + _cosArr(0);
+            }
+            return sum;
+        }
+
+    private:
+        Eigen::ArrayXd _angArr;
+        Eigen::ArrayXd _sinArr;
+        Eigen::ArrayXd _cosArr;
+    };
+
+    class HypotBenchmark : public Benchmark {
+    public:
+        explicit HypotBenchmark() : Benchmark("math", "hypot") {}
+
+        virtual double run(long numCalls) {
+            double sum = 0;
+            for (long i = 0; i < numCalls; ++i) {
+                sum += coordConv::hypot(0.3 + (i % 8), 0.7);
+            }
+            return sum;
+        }
+    };
+
+    class ObsFromAppTopoBenchmark : public Benchmark {
+    public:
+        explicit ObsFromAppTopoBenchmark(std::string const &name, double alt, coordConv::Site const &site)
+        :
+            Benchmark("helper", name), _coord(120, alt), _site(site)
+        {}
+
+        virtual double run(long numCalls) {
+            double sum = 0;
+            for (long i = 0; i < numCalls; ++i) {
+                sum += coordConv::obsFromAppTopo(_coord, _site).getVecPos()(2);
+            }
+            return sum;
+        }
+
+    private:
+        coordConv::Coord _coord;
+        coordConv::Site _site;
+    };
+
+    class AppTopoFromObsBenchmark : public Benchmark {
+    public:
+        explicit AppTopoFromObsBenchmark(std::string const &name, double alt, coordConv::Site const &site)
+        :
+            Benchmark("helper", name), _coord(120, alt), _site(site)
+        {}
+
+        virtual double run(long numCalls) {
+            double sum = 0;
+            for (long i = 0; i < numCalls; ++i) {
+                sum += coordConv::appTopoFromObs(_coord, _site).getVecPos()(2);
+            }
+            return sum;
+        }
+
+    private:
+        coordConv::Coord _coord;
+        coordConv::Site _site;
+    };
+
+    class LastFromTAIBenchmark : public Benchmark {
+    public:
+        explicit LastFromTAIBenchmark(std::string const &name, coordConv::Site const &site)
+        :
+            Benchmark("helper", name), _site(site)
+        {}
+
+        virtual double run(long numCalls) {
+            double sum = 0;
+            for (long i = 0; i < numCalls; ++i) {
+                sum += coordConv::lastFromTAI(TAI + (i % 100) * 0.01, _site);
+            }
+            return sum;
+        }
+
+    private:
+        coordConv::Site _site;
+    };
+
+    /*
+    Time AppGeoCoordSys.setDate, stepping the date by dDate (years) for each call
+    */
+    class AppGeoSetDateBenchmark : public Benchmark {
+    public:
+        explicit AppGeoSetDateBenchmark(std::string const &name, double dDate)
+        :
+            Benchmark("cache", name), _dDate(dDate), _appGeoCoordSys(2014)
+        {}
+
+        virtual double run(long numCalls) {
+            double sum = 0;
+            for (long i = 0; i < numCalls; ++i) {
+                _appGeoCoordSys.setDate(2014 + (i % 100) * _dDate);
+                sum += _appGeoCoordSys.getDate();
+            }
+            return sum;
+        }
+
+    private:
+        double _dDate;
+        coordConv::AppGeoCoordSys _appGeoCoordSys;
+    };
+
+    class SiderealTimeDataBenchmark : public Benchmark {
+    public:
+        explicit SiderealTimeDataBenchmark() : Benchmark("cache", "SiderealTimeData") {}
+
+        virtual double run(long numCalls) {
+            double sum = 0;
+            for (long i = 0; i < numCalls; ++i) {
+                double const tai = TAI + i * 1000.0;
+                coordConv::SiderealTimeData data(tai, tai + coordConv::TT_TAI);
+                sum += data.gmst;
+            }
+            return sum;
+        }
+    };
+
+    class TrackerPrepareBenchmark : public Benchmark {
+    public:
+        explicit TrackerPrepareBenchmark(coordConv::Site const &site)
+        :
+            Benchmark("cache", "Tracker.prepare"),
+            _tracker(*makeBenchCoordSys("icrs"), *makeBenchCoordSys("obs"), site)
+        {}
+
+        virtual double run(long numCalls) {
+            for (long i = 0; i < numCalls; ++i) {
+                _tracker.prepare(TAI + i * 1.0);
+            }
+            return _tracker.getPreparedTAI();
+        }
+
+    private:
+        coordConv::Tracker _tracker;
+    };
+
+    class TrackerConvertBenchmark : public Benchmark {
+    public:
+        explicit TrackerConvertBenchmark(coordConv::Coord const &fromCoord, coordConv::Site const &site)
+        :
+            Benchmark("cache", "Tracker.convert"),
+            _fromCoord(fromCoord),
+            _tracker(*makeBenchCoordSys("icrs"), *makeBenchCoordSys("obs"), site)
+        {
+            _tracker.prepare(TAI);
+        }
+
+        virtual double run(long numCalls) {
+            double sum = 0;
+            for (long i = 0; i < numCalls; ++i) {
+                sum += _tracker.convert(_fromCoord, TAI + (i % 100) * 0.01).getVecPos()(0);
+            }
+            return sum;
+        }
+
+    private:
+        coordConv::Coord _fromCoord;
+        coordConv::Tracker _tracker;
+    };
+
+    /*
+    Return a Coord with the same position as coord, plus some proper motion, parallax and radial velocity
+    */
+    coordConv::Coord addPM(coordConv::Coord const &coord) {
+        double equatAng, polarAng;
+        coord.getSphPos(equatAng, polarAng);
+        return coordConv::Coord(equatAng, polarAng, 0.1, 0.3, -0.2, 25);
+    }
+
+    /*
+    Append the conversion benchmarks for every pair of coordinate systems
+    */
+    void addConversionBenchmarks(std::vector<Benchmark::Ptr> &benchList, coordConv::Site const &site) {
+        // start at a position well above the horizon: alt 45, az 120
+        coordConv::CoordSys::Ptr appTopoSysPtr = makeBenchCoordSys("apptopo");
+        coordConv::Coord const appTopoCoord(120, 45);
+
+        for (int fromInd = 0; fromInd < NumCoordSys; ++fromInd) {
+            coordConv::CoordSys::Ptr fromSysPtr = makeBenchCoordSys(CoordSysNames[fromInd]);
+            coordConv::Coord const fromCoordNoPM = fromSysPtr->convertFrom(*appTopoSysPtr, appTopoCoord, site, TAI);
+            coordConv::Coord const fromCoordPM = addPM(fromCoordNoPM);
+            for (int toInd = 0; toInd < NumCoordSys; ++toInd) {
+                coordConv::CoordSys::Ptr toSysPtr = makeBenchCoordSys(CoordSysNames[toInd]);
+                for (int withPM = 0; withPM < 2; ++withPM) {
+                    coordConv::Coord const &fromCoord = withPM ? fromCoordPM : fromCoordNoPM;
+                    // 1 arcsec/sec (in all directions)
+                    coordConv::PVTCoord const fromPVTCoord(fromCoord,
+                        fromCoord.getVecPos() * (coordConv::RadPerDeg / 3600.0), TAI);
+                    for (int withDir = 0; withDir < 2; ++withDir) {
+                        std::ostringstream os;
+                        os << CoordSysNames[fromInd] << "->" << CoordSysNames[toInd]
+                            << (withPM ? " pm" : " nopm") << (withDir ? " dir" : " nodir");
+                        benchList.push_back(Benchmark::Ptr(new ConvertCoordBenchmark(
+                            os.str(), toSysPtr, fromSysPtr, fromCoord, withDir, site)));
+                        benchList.push_back(Benchmark::Ptr(new ConvertPVTCoordBenchmark(
+                            os.str(), toSysPtr, fromSysPtr, fromPVTCoord, withDir, site)));
+                    }
+                }
+            }
+        }
+    }
+
+    /*
+    Append the helper, math and cache benchmarks
+    */
+    void addOtherBenchmarks(std::vector<Benchmark::Ptr> &benchList, coordConv::Site const &site) {
+        benchList.push_back(Benchmark::Ptr(new OffsetBenchmark()));
+        benchList.push_back(Benchmark::Ptr(new OrientationToBenchmark()));
+        benchList.push_back(Benchmark::Ptr(new AngularSeparationBenchmark()));
+        benchList.push_back(Benchmark::Ptr(new AngSideAngBenchmark()));
+        benchList.push_back(Benchmark::Ptr(new SinCosBenchmark("sind and cosd", false)));
+        benchList.push_back(Benchmark::Ptr(new SinCosBenchmark("sincosd", true)));
+        benchList.push_back(Benchmark::Ptr(new SinCosArrayBenchmark("sincosd array of 64", 64)));
+        benchList.push_back(Benchmark::Ptr(new HypotBenchmark()));
+        benchList.push_back(Benchmark::Ptr(new ObsFromAppTopoBenchmark("obsFromAppTopo alt=45", 45, site)));
+        benchList.push_back(Benchmark::Ptr(new ObsFromAppTopoBenchmark("obsFromAppTopo alt=2", 2, site)));
+        benchList.push_back(Benchmark::Ptr(new AppTopoFromObsBenchmark("appTopoFromObs alt=45", 45, site)));
+        benchList.push_back(Benchmark::Ptr(new AppTopoFromObsBenchmark("appTopoFromObs alt=2", 2, site)));
+        coordConv::Site refractionSite(site);
+        refractionSite.refractionCachePtr.reset(new coordConv::RefractionCache());
+        benchList.push_back(Benchmark::Ptr(new ObsFromAppTopoBenchmark(
+            "obsFromAppTopo alt=45 with RefractionCache", 45, refractionSite)));
+        benchList.push_back(Benchmark::Ptr(new AppTopoFromObsBenchmark(
+            "appTopoFromObs alt=45 with RefractionCache", 45, refractionSite)));
+        benchList.push_back(Benchmark::Ptr(new LastFromTAIBenchmark("lastFromTAI", site)));
+        coordConv::Site cachedSite(site);
+        cachedSite.lastCachePtr.reset(new coordConv::SiderealTimeCache());
+        benchList.push_back(Benchmark::Ptr(new LastFromTAIBenchmark("lastFromTAI with SiderealTimeCache", cachedSite)));
+
+        // step the date by about 1 msec, so the cache is reused, or by 0.1 year, so it never is
+        benchList.push_back(Benchmark::Ptr(new AppGeoSetDateBenchmark(
+            "AppGeoCoordSys.setDate cache hit", 1.0e-3 / (coordConv::SecPerDay * coordConv::DaysPerYear))));
+        benchList.push_back(Benchmark::Ptr(new AppGeoSetDateBenchmark("AppGeoCoordSys.setDate cache miss", 0.1)));
+        benchList.push_back(Benchmark::Ptr(new SiderealTimeDataBenchmark()));
+        benchList.push_back(Benchmark::Ptr(new TrackerPrepareBenchmark(site)));
+        coordConv::Coord const icrsCoord = makeBenchCoordSys("icrs")->convertFrom(
+            *makeBenchCoordSys("apptopo"), coordConv::Coord(120, 45), site, TAI);
+        benchList.push_back(Benchmark::Ptr(new TrackerConvertBenchmark(icrsCoord, site)));
+    }
+
+    struct BenchResult {
+        std::string group;
+        std::string name;
+        long numCalls;
+        double nsPerCall;
+    };
+
+    /*
+    Time one benchmark: warm up, then double the number of calls until the time taken is at least minTime (sec)
+    */
+    BenchResult timeBenchmark(Benchmark &bench, double minTime, double &sink) {
+        sink += bench.run(1);
+        long numCalls = 1;
+        double duration = 0;
+        while (true) {
+            double const startTime = coordConv::monotonicSec();
+            sink += bench.run(numCalls);
+            duration = coordConv::monotonicSec() - startTime;
+            if (duration >= minTime) {
+                break;
+            }
+            numCalls *= 2;
+        }
+        BenchResult result;
+        result.group = bench.group;
+        result.name = bench.name;
+        result.numCalls = numCalls;
+        result.nsPerCall = duration * 1.0e9 / numCalls;
+        return result;
+    }
+
+    /*
+    Return a string quoted for CSV or JSON (names never include quotes or backslashes)
+    */
+    std::string quote(std::string const &str) {
+        return "\"" + str + "\"";
+    }
+
+    void writeCSV(std::ostream &os, std::vector<BenchResult> const &resultList) {
+        os << "group,name,calls,nsPerCall" << std::endl;
+        for (std::size_t i = 0; i < resultList.size(); ++i) {
+            BenchResult const &result = resultList[i];
+            os << result.group << "," << quote(result.name) << "," << result.numCalls << ","
+                << std::fixed << std::setprecision(1) << result.nsPerCall << std::endl;
+        }
+    }
+
+    void writeJSON(std::ostream &os, std::vector<BenchResult> const &resultList) {
+        os << "[" << std::endl;
+        for (std::size_t i = 0; i < resultList.size(); ++i) {
+            BenchResult const &result = resultList[i];
+            os << "  {\"group\": " << quote(result.group) << ", \"name\": " << quote(result.name)
+                << ", \"calls\": " << result.numCalls
+                << ", \"nsPerCall\": " << std::fixed << std::setprecision(1) << result.nsPerCall << "}"
+                << (i + 1 < resultList.size() ? "," : "") << std::endl;
+        }
+        os << "]" << std::endl;
+    }
+
+}
+
+int main(int argc, char **argv) {
+    bool useJSON = false;
+    double minTime = 0.1;
+    std::string match;
+    for (int i = 1; i < argc; ++i) {
+        std::string const arg = argv[i];
+        if (arg == "--json") {
+            useJSON = true;
+        } else if (arg == "--csv") {
+            useJSON = false;
+        } else if (arg.compare(0, 10, "--minTime=") == 0) {
+            minTime = std::atof(arg.c_str() + 10);
+        } else if (arg.compare(0, 8, "--match=") == 0) {
+            match = arg.substr(8);
+        } else {
+            std::cerr << "Usage: " << argv[0] << " [--csv | --json] [--minTime=sec] [--match=substring]" << std::endl;
+            return 1;
+        }
+    }
+
+    coordConv::Site const site = makeSite();
+    std::vector<Benchmark::Ptr> benchList;
+    addConversionBenchmarks(benchList, site);
+    addOtherBenchmarks(benchList, site);
+
+    std::vector<BenchResult> resultList;
+    double sink = 0;
+    for (std::size_t i = 0; i < benchList.size(); ++i) {
+        Benchmark &bench = *benchList[i];
+        if (!match.empty() && (bench.name.find(match) == std::string::npos)) {
+            continue;
+        }
+        resultList.push_back(timeBenchmark(bench, minTime, sink));
+    }
+
+    if (useJSON) {
+        writeJSON(std::cout, resultList);
+    } else {
+        writeCSV(std::cout, resultList);
+    }
+    if (sink == 0.123456) {
+        std::cerr << sink << std::endl;
+    }
+    return 0;
+}
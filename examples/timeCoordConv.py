@@ -1,5 +1,6 @@
 #!/usr/bin/env python
 import time
+import numpy
 import coordConv
 """
 Measure the time required to perform coordinate conversions relevant to telescope tracking
@@ -75,8 +76,7 @@ def timeFK5ToAppTopo(alt, niter):
     @param[in] alt  initial altitude (degrees)
     @param[in] niter  number of iterations
     
-    The coordinate conversion code presently does not have a special branch
-    for zero proper motion, so no attempt is made to provide proper motion.
+    No proper motion is provided, so this times the fast path for fixed targets (see Coord.hasPM).
     
     Use the approximation that TAI = UTC, which is plenty close enough for timing.
     
@@ -111,8 +111,7 @@ def timeAppTopoToFK5(alt, niter):
     @param[in] alt  initial altitude (degrees)
     @param[in] niter  number of iterations
     
-    The coordinate conversion code presently does not have a special branch
-    for zero proper motion, so no attempt is made to provide proper motion.
+    No proper motion is provided, so this times the fast path for fixed targets (see Coord.hasPM).
     
     Use the approximation that TAI = UTC, which is plenty close enough for timing.
     
@@ -141,6 +140,46 @@ def timeAppTopoToFK5(alt, niter):
     duration = time.time() - startTime
     print "AppTopo To FK5 PVTCoord with dir: %0.1f conversions/second (%d conversions in %0.2f sec) at alt=%0.1f" % (niter/duration, niter, duration, alt)
 
+def timeFK5ToAppTopoArray(alt, niter):
+    """Time converting an array of FK5 positions to apparent topocentric at the specified altitude
+
+    @param[in] alt  initial altitude (degrees)
+    @param[in] niter  number of positions in the array
+    """
+    fk5Sys = coordConv.FK5CoordSys(1980)
+    currTAI = utcFromPySec(time.time())
+    appTopoSys = coordConv.AppTopoCoordSys()
+    site = makeSite()
+    fk5CoordArr = coordConv.CoordArray(niter)
+    for i in range(niter):
+        appTopoCoord = coordConv.Coord((i * 360.0) / niter, alt)
+        fk5CoordArr.setCoord(i, fk5Sys.convertFrom(appTopoSys, appTopoCoord, site, currTAI))
+    appTopoCoordArr = coordConv.CoordArray()
+    startTime = time.time()
+    appTopoSys.convertFrom(appTopoCoordArr, fk5Sys, fk5CoordArr, site, currTAI)
+    duration = time.time() - startTime
+    print "FK5 to AppTopo       CoordArray: %8.1f conversions/second (%d conversions in %0.2f sec) at alt=%0.1f" % (niter/duration, niter, duration, alt)
+
+def timeFK5ToAppTopoSphArrays(alt, niter, numThreads):
+    """Time converting numpy arrays of FK5 spherical coordinates to apparent topocentric at the specified altitude
+
+    @param[in] alt  initial altitude (degrees)
+    @param[in] niter  number of positions in the arrays
+    @param[in] numThreads  number of threads; 0 for the number of hardware threads
+    """
+    fk5Sys = coordConv.FK5CoordSys(1980)
+    currTAI = utcFromPySec(time.time())
+    appTopoSys = coordConv.AppTopoCoordSys()
+    site = makeSite()
+    azArr = numpy.linspace(0, 360, niter, endpoint=False)
+    fk5Arrays = coordConv.convertSphArrays(appTopoSys, fk5Sys, site, currTAI, azArr, alt)
+    startTime = time.time()
+    coordConv.convertSphArrays(fk5Sys, appTopoSys, site, currTAI, fk5Arrays.equatAng, fk5Arrays.polarAng,
+        numThreads=numThreads)
+    duration = time.time() - startTime
+    print "FK5 to AppTopo    numpy arrays: %8.1f conversions/second (%d conversions in %0.2f sec) at alt=%0.1f with numThreads=%d" % \
+        (niter/duration, niter, duration, alt, numThreads)
+
 def timeAppGeoData(niter):
     """Time computation of apparent geocentric data
     
@@ -164,4 +203,10 @@ if __name__ == '__main__':
     for alt in (0, 5, 45):
         timeAppTopoToFK5(alt, 10000)
     print
+    for alt in (0, 5, 45):
+        timeFK5ToAppTopoArray(alt, 100000)
+    print
+    for numThreads in (1, 0):
+        timeFK5ToAppTopoSphArrays(45, 1000000, numThreads)
+    print
     timeAppGeoData(10000)
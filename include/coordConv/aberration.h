@@ -0,0 +1,60 @@
+#pragma once
+
+#include "Eigen/Dense"
+
+namespace coordConv {
+
+    /**
+    Correct a position for annual aberration (the relativistic formula used by slaMapqk)
+
+    @param[in] pos  position before correcting for annual aberration (AU)
+    @param[in] bcBeta  barycentric velocity of the Earth (c)
+    @param[in] gammaI  sqrt(1 - bcBeta^2)
+    @return position corrected for annual aberration (AU); it has the same magnitude as pos
+    */
+    Eigen::Vector3d addAnnualAberration(
+        Eigen::Vector3d const &pos,
+        Eigen::Vector3d const &bcBeta,
+        double gammaI
+    );
+
+    /**
+    Remove annual aberration: the inverse of addAnnualAberration
+
+    The aberration formula is a Lorentz transformation of direction, so its inverse is the same
+    transformation with the velocity negated. Thus this is closed form, with a fixed cost:
+    one square root and one division (and no iteration, so it never fails).
+    The result matches removeAnnualAberrationIter to within rounding error.
+
+    @param[in] pos  position corrected for annual aberration (AU)
+    @param[in] bcBeta  barycentric velocity of the Earth (c)
+    @param[in] gammaI  sqrt(1 - bcBeta^2)
+    @return position before correcting for annual aberration (AU); it has the same magnitude as pos
+    */
+    Eigen::Vector3d removeAnnualAberration(
+        Eigen::Vector3d const &pos,
+        Eigen::Vector3d const &bcBeta,
+        double gammaI
+    );
+
+    /**
+    Remove annual aberration by iteration
+
+    This is the algorithm formerly used by AppGeoCoordSys.toFK5J2000; it iterates until
+    all three components of (P this iteration - P last iteration) / |P| are less than 1e-10.
+    It is slower than removeAnnualAberration and its cost varies with position,
+    so it is only retained for testing and benchmarking.
+
+    @param[in] pos  position corrected for annual aberration (AU)
+    @param[in] bcBeta  barycentric velocity of the Earth (c)
+    @param[in] gammaI  sqrt(1 - bcBeta^2)
+    @return position before correcting for annual aberration (AU)
+    @throw std::runtime_error if the iteration does not converge in 20 iterations
+    */
+    Eigen::Vector3d removeAnnualAberrationIter(
+        Eigen::Vector3d const &pos,
+        Eigen::Vector3d const &bcBeta,
+        double gammaI
+    );
+
+}
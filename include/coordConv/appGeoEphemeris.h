@@ -0,0 +1,145 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include "boost/cstdint.hpp"
+#include "boost/noncopyable.hpp"
+#include "boost/shared_ptr.hpp"
+#include "boost/interprocess/mapped_region.hpp"
+#include "coordConv/physConst.h"
+#include "coordConv/coordSys.h"
+
+namespace coordConv {
+
+    /// default interval between grid points of an AppGeoEphemeris (Julian years): 6 hours
+    const double AppGeoEphemerisInterval = 0.25 / DaysPerYear;
+
+    /**
+    Header of an AppGeoEphemeris file
+
+    An ephemeris file is this header followed by numPoints AppGeoEphemerisRecords, with no padding;
+    all values are in native byte order.
+    */
+    struct AppGeoEphemerisHeader {
+        char magic[8];              ///< identifies the file format: "CCAGEPH1" (not null-terminated)
+        double startDate;           ///< date of the first grid point (TDB, Julian years)
+        double interval;            ///< interval between grid points (Julian years)
+        boost::uint64_t numPoints;  ///< number of grid points
+    };
+
+    /**
+    Star-independent parameters at one grid point of an AppGeoEphemeris
+    */
+    struct AppGeoEphemerisRecord {
+        double amprms[AmprmsSize];  ///< star-independent parameters, in the format computed by SLALIB's slaMappa
+        double rate[AmprmsSize];    ///< rate of change of amprms (per Julian year)
+    };
+
+    /**
+    A table of star-independent parameters for apparent geocentric conversion, on a regular grid of dates
+
+    Intended for simulation and replay, and for any code that wants to compute AppGeoData
+    at many dates without calling SLALIB: construct an AppGeoEphemeris once (e.g. for a night or a year),
+    optionally save it to a file, then construct an AppGeoCache from it.
+
+    Parameters between grid points are computed by cubic Hermite interpolation of the parameters
+    and their rates of change at the two surrounding grid points. The interpolation error scales as interval^4;
+    at the default interval of 6 hours it is well below 1e-6 arcsec for all parameters
+    (the fastest significant terms, lunar perturbations of the Earth's motion and short-period nutation,
+    have periods of days).
+
+    An ephemeris read from a file is memory-mapped rather than copied, so it is fast to open
+    and may be shared by several processes. An AppGeoEphemeris is immutable, so it may be shared between threads.
+    */
+    class AppGeoEphemeris : private boost::noncopyable {
+    public:
+        typedef boost::shared_ptr<const AppGeoEphemeris> ConstPtr;
+
+        /**
+        Compute an ephemeris using SLALIB
+
+        @param[in] startDate  date of first grid point (TDB, Julian years)
+        @param[in] endDate  last date that must be covered (TDB, Julian years);
+            the last grid point is at or after this date
+        @param[in] interval  interval between grid points (Julian years)
+        @throw std::invalid_argument if interval <= 0, endDate < startDate, or either date is not finite
+        */
+        explicit AppGeoEphemeris(double startDate, double endDate, double interval=AppGeoEphemerisInterval);
+
+        /**
+        Read an ephemeris file written by writeFile (by memory-mapping it)
+
+        @param[in] path  path of ephemeris file
+        @throw std::runtime_error if the file cannot be read or mapped, or is not a valid ephemeris file
+        */
+        explicit AppGeoEphemeris(std::string const &path);
+
+        ~AppGeoEphemeris() {};
+
+        /**
+        Write the ephemeris to a file
+
+        @param[in] path  path of ephemeris file; created or overwritten
+        @throw std::runtime_error if the file cannot be written
+        */
+        void writeFile(std::string const &path) const;
+
+        /// return the date of the first grid point (TDB, Julian years)
+        double getStartDate() const { return _startDate; };
+
+        /// return the date of the last grid point (TDB, Julian years)
+        double getEndDate() const { return _startDate + ((_numPoints - 1) * _interval); };
+
+        /// return the interval between grid points (Julian years)
+        double getInterval() const { return _interval; };
+
+        /// return the number of grid points
+        int size() const { return _numPoints; };
+
+        /**
+        Return true if the ephemeris covers a date, i.e. getStartDate() <= date <= getEndDate()
+
+        @param[in] date  TDB date in Julian years
+        */
+        bool contains(double date) const { return (date >= _startDate) && (date <= getEndDate()); };
+
+        /**
+        Interpolate the star-independent parameters at a date
+
+        @param[out] amprms  star-independent parameters, in the format computed by SLALIB's slaMappa
+            (AmprmsSize values)
+        @param[in] date  TDB date in Julian years
+        @throw std::runtime_error if the ephemeris does not cover the date
+        */
+        void getAmprms(double *amprms, double date) const;
+
+        /**
+        Interpolate the star-independent parameters at a date
+
+        @param[in] date  TDB date in Julian years
+        @return star-independent parameters
+        @throw std::runtime_error if the ephemeris does not cover the date
+        */
+        AppGeoData::ConstPtr getData(double date) const;
+
+        /// return the path of the ephemeris file; "" if the ephemeris was computed
+        std::string getPath() const { return _path; };
+
+        /**
+        Return a string representation
+        */
+        std::string __repr__() const;
+
+    private:
+        std::string _path;      ///< path of ephemeris file; "" if computed
+        double _startDate;      ///< date of first grid point (TDB, Julian years)
+        double _interval;       ///< interval between grid points (Julian years)
+        int _numPoints;         ///< number of grid points
+        std::vector<AppGeoEphemerisRecord> _recordVec;  ///< grid points, if computed
+        boost::interprocess::mapped_region _region;     ///< mapped file, if read from a file
+        AppGeoEphemerisRecord const *_records;          ///< grid points (in _recordVec or _region)
+    };
+
+    std::ostream &operator<<(std::ostream &os, AppGeoEphemeris const &ephem);
+
+}
@@ -3,6 +3,7 @@
 #include "Eigen/Dense"
 
 #include "coordConv/coord.h"
+#include "coordConv/coordArray.h"
 #include "coordConv/site.h"
 
 namespace coordConv {
@@ -21,4 +22,39 @@ namespace coordConv {
         double tai
     );
 
+    /**
+    Array version of appGeoFromAppTopo; faster than converting one Coord at a time
+
+    @param[out] appGeoArr  apparent geocentric positions at the specified TAI date;
+        resized as needed; may be the same object as appTopoArr
+    @param[in] appTopoArr  apparent topocentric positions at the specified TAI date
+    @param[in] site  site information
+    @param[in] tai  TAI date (MJD, sec)
+    */
+    void appGeoFromAppTopo(
+        CoordArray &appGeoArr,
+        CoordArray const &appTopoArr,
+        Site const &site,
+        double tai
+    );
+
+    /**
+    Version of appGeoFromAppTopo that also computes the local linear model of the conversion
+
+    @param[out] jacobian  partial derivative of apparent geocentric position with respect to apparent topocentric position
+    @param[out] posRate  partial derivative of apparent geocentric position with respect to TAI date (AU/sec),
+        due to the rotation of the Earth
+    @param[in] appTopoCoord  apparent topocentric coord at the specified TAI date
+    @param[in] site  site information
+    @param[in] tai  TAI date (MJD, sec)
+    @return position in apparent geocentric coordinates at the specified TAI date
+    */
+    Coord appGeoFromAppTopo(
+        Eigen::Matrix3d &jacobian,
+        Eigen::Vector3d &posRate,
+        Coord const &appTopoCoord,
+        Site const &site,
+        double tai
+    );
+
 }
@@ -3,6 +3,7 @@
 #include "Eigen/Dense"
 
 #include "coordConv/coord.h"
+#include "coordConv/coordArray.h"
 #include "coordConv/site.h"
 
 namespace coordConv {
@@ -21,4 +22,55 @@ namespace coordConv {
         double tai
     );
 
+    /**
+    Version of appTopoFromAppGeo that takes local apparent sidereal time instead of TAI date
+
+    Useful if LAST is already known, since computing it from TAI is relatively expensive.
+
+    @param[in] appGeoCoord  apparent geocentric coord at the date of observation
+    @param[in] site  site information
+    @param[in] last  local apparent sidereal time (deg), e.g. from lastFromTAI
+    @return position in apparent topocentric coordinates at the date of observation
+    */
+    Coord appTopoFromAppGeoAtLAST(
+        Coord const &appGeoCoord,
+        Site const &site,
+        double last
+    );
+
+    /**
+    Array version of appTopoFromAppGeo; faster than converting one Coord at a time
+
+    @param[out] appTopoArr  apparent topocentric positions at the specified TAI date;
+        resized as needed; may be the same object as appGeoArr
+    @param[in] appGeoArr  apparent geocentric positions at the specified TAI date
+    @param[in] site  site information
+    @param[in] tai  TAI date (MJD, sec)
+    */
+    void appTopoFromAppGeo(
+        CoordArray &appTopoArr,
+        CoordArray const &appGeoArr,
+        Site const &site,
+        double tai
+    );
+
+    /**
+    Version of appTopoFromAppGeo that also computes the local linear model of the conversion
+
+    @param[out] jacobian  partial derivative of apparent topocentric position with respect to apparent geocentric position
+    @param[out] posRate  partial derivative of apparent topocentric position with respect to TAI date (AU/sec),
+        due to the rotation of the Earth
+    @param[in] appGeoCoord  apparent geocentric coord at the specified TAI date
+    @param[in] site  site information
+    @param[in] tai  TAI date (MJD, sec)
+    @return position in apparent topocentric coordinates at the specified TAI date
+    */
+    Coord appTopoFromAppGeo(
+        Eigen::Matrix3d &jacobian,
+        Eigen::Vector3d &posRate,
+        Coord const &appGeoCoord,
+        Site const &site,
+        double tai
+    );
+
 }
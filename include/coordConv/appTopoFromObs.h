@@ -3,6 +3,7 @@
 #include "Eigen/Dense"
 
 #include "coordConv/coord.h"
+#include "coordConv/coordArray.h"
 #include "coordConv/site.h"
 
 namespace coordConv {
@@ -11,7 +12,7 @@ namespace coordConv {
     Convert observed coordinates (refracted apparent topocentric) to apparent topocentric coordinates
 
     @param[in] obsCoord  observed (refracted apparent topocentric) coord
-    @param[in] site  site information; refCoA and refCoB are read
+    @param[in] site  site information; refCoA, refCoB and refractionCachePtr are read
     @return position in observed coordinates
     */
     Coord appTopoFromObs(
@@ -19,4 +20,32 @@ namespace coordConv {
         Site const &site
     );
 
+    /**
+    Array version of appTopoFromObs; faster than converting one Coord at a time
+
+    @param[out] appTopoArr  apparent topocentric positions;
+        resized as needed; may be the same object as obsArr
+    @param[in] obsArr  observed (refracted apparent topocentric) positions
+    @param[in] site  site information; refCoA, refCoB and refractionCachePtr are read
+    */
+    void appTopoFromObs(
+        CoordArray &appTopoArr,
+        CoordArray const &obsArr,
+        Site const &site
+    );
+
+    /**
+    Version of appTopoFromObs that also computes the jacobian of the conversion
+
+    @param[out] jacobian  partial derivative of apparent topocentric position with respect to observed position
+    @param[in] obsCoord  observed coord
+    @param[in] site  site information; refCoA, refCoB and refractionCachePtr are read
+    @return position in apparent topocentric coordinates
+    */
+    Coord appTopoFromObs(
+        Eigen::Matrix3d &jacobian,
+        Coord const &obsCoord,
+        Site const &site
+    );
+
 }
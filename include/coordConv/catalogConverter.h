@@ -0,0 +1,205 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include "boost/function.hpp"
+#include "boost/noncopyable.hpp"
+#include "boost/interprocess/mapped_region.hpp"
+#include "coordConv/site.h"
+#include "coordConv/coordArray.h"
+#include "coordConv/coordSys.h"
+#include "coordConv/conversionPlan.h"
+
+namespace coordConv {
+
+    /**
+    One record of a binary star catalog, as read and written by CatalogConverter
+
+    The fields and units are the same as the arguments of Coord(equatAng, polarAng, parallax, equatPM, polarPM, radVel).
+    A catalog file is a sequence of these records with no header or padding, each field an 8-byte IEEE double
+    in native byte order (so a catalog can be read by numpy.fromfile(path, dtype=float).reshape(-1, 6)).
+    */
+    struct CatalogRecord {
+        double equatAng;    ///< equatorial angle (e.g. RA, Long, Az) (degrees)
+        double polarAng;    ///< polar angle (e.g. Dec, Latitude, Alt) (degrees)
+        double parallax;    ///< parallax (arcsec)
+        double equatPM;     ///< equatorial proper motion (arcsec/century); this is dEquatAng/dt, so it gets large near the pole
+        double polarPM;     ///< polar proper motion (arcsec/century)
+        double radVel;      ///< radial velocity (km/sec, positive receding)
+    };
+
+    /**
+    Callback for CatalogConverter::streamFile; called once per chunk of converted records
+
+    Arguments are:
+    - startInd: index of the first record of the chunk in the catalog
+    - records: converted records; only valid for the duration of the call
+    - numRecords: number of converted records
+    */
+    typedef boost::function<void (std::size_t startInd, CatalogRecord const *records, std::size_t numRecords)> CatalogCallback;
+
+    /**
+    Set a CoordArray from catalog records
+
+    Equivalent to coordArr.setCoord(i, Coord(rec.equatAng, rec.polarAng, rec.parallax, rec.equatPM, rec.polarPM, rec.radVel))
+    for each record, but without constructing a Coord for each record.
+
+    @param[out] coordArr  positions; resized to numRecords
+    @param[in] records  catalog records
+    @param[in] numRecords  number of catalog records
+    @throw std::runtime_error if a polar angle is not in range [-90, 90]
+    */
+    void coordArrayFromCatalog(CoordArray &coordArr, CatalogRecord const *records, std::size_t numRecords);
+
+    /**
+    Set catalog records from a CoordArray
+
+    Equivalent to calling getSphPos, getParallax, getPM and getRadVel on coordArr.getCoord(i) for each position,
+    but without constructing a Coord for each position. As with Coord, a position at a pole
+    has equatAng = 0 and zero proper motion, and a position at infinity has parallax = 0.
+
+    @param[out] records  catalog records; there must be room for coordArr.size() records
+    @param[in] coordArr  positions
+    */
+    void catalogFromCoordArray(CatalogRecord *records, CoordArray const &coordArr);
+
+    /**
+    A memory-mapped binary star catalog file (a sequence of CatalogRecords)
+
+    The mapping lasts as long as the MappedCatalog.
+    */
+    class MappedCatalog : private boost::noncopyable {
+    public:
+        /**
+        Map an existing catalog for reading
+
+        @param[in] path  path of catalog
+        @throw std::runtime_error if the file cannot be read or mapped,
+            or if its size is not a multiple of sizeof(CatalogRecord)
+        */
+        explicit MappedCatalog(std::string const &path);
+
+        /**
+        Create a catalog (overwriting any existing file) and map it for reading and writing
+
+        @param[in] path  path of catalog
+        @param[in] numRecords  number of records; the records are initially zero
+        @throw std::runtime_error if the file cannot be created or mapped
+        */
+        explicit MappedCatalog(std::string const &path, std::size_t numRecords);
+
+        ~MappedCatalog() {};
+
+        /// return the number of records
+        std::size_t size() const { return _numRecords; };
+
+        /// return the records (null if there are none)
+        CatalogRecord const *getRecords() const { return static_cast<CatalogRecord const *>(_region.get_address()); };
+
+        /**
+        Return the records for writing (null if there are none)
+
+        @throw std::runtime_error if the catalog was mapped for reading only
+        */
+        CatalogRecord *getWritableRecords();
+
+        /**
+        Write modified records to the file (does nothing if the catalog was mapped for reading only)
+        */
+        void flush();
+
+        /// return the path of the catalog
+        std::string getPath() const { return _path; };
+
+    private:
+        std::string _path;          ///< path of catalog
+        bool _isWritable;           ///< was the catalog mapped for writing?
+        std::size_t _numRecords;    ///< number of records
+        boost::interprocess::mapped_region _region; ///< mapped file; empty if there are no records
+    };
+
+    /**
+    Convert binary star catalogs from one coordinate system to another at a fixed TAI date
+
+    Intended for converting large reference catalogs (e.g. to apparent places for a night's observing).
+    Input catalogs are memory-mapped and converted in chunks of chunkSize records using a ConversionPlan
+    and CoordArrays that are reused for each chunk, so no per-record objects are created
+    and memory use does not depend on the size of the catalog.
+    Results match toCoordSys.convertFrom(fromCoordSys, Coord(...), site, tai) to within round-off error.
+
+    A CatalogConverter holds its own ConversionPlan and buffers, so each thread must use its own CatalogConverter.
+    */
+    class CatalogConverter {
+    public:
+        /**
+        Construct a CatalogConverter
+
+        @param[in] fromCoordSys  coordinate system of input catalogs
+        @param[in] toCoordSys  coordinate system of output catalogs
+        @param[in] site  site information
+        @param[in] tai  TAI date of conversion (MJD, sec); used for any coordinate system that is current
+        @param[in] chunkSize  number of records to convert at a time; the default keeps the buffers
+            small enough to fit in a typical L2 cache
+        @throw std::invalid_argument if chunkSize < 1
+        */
+        explicit CatalogConverter(CoordSys const &fromCoordSys, CoordSys const &toCoordSys, Site const &site, double tai,
+            int chunkSize=1024);
+
+        ~CatalogConverter() {};
+
+        /**
+        Convert catalog records in memory
+
+        @param[out] toRecords  converted records; there must be room for numRecords records;
+            may be the same as fromRecords
+        @param[in] fromRecords  records to convert
+        @param[in] numRecords  number of records
+        @throw std::runtime_error if a polar angle is not in range [-90, 90]
+        */
+        void convert(CatalogRecord *toRecords, CatalogRecord const *fromRecords, std::size_t numRecords);
+
+        /**
+        Convert a catalog file to another catalog file
+
+        @param[in] toPath  path of output catalog; created or overwritten
+        @param[in] fromPath  path of input catalog; must not be the same file as toPath
+        @return number of records converted
+        @throw std::runtime_error if a file cannot be read or written,
+            if the size of the input catalog is not a multiple of sizeof(CatalogRecord),
+            or if a polar angle is not in range [-90, 90]
+        */
+        std::size_t convertFile(std::string const &toPath, std::string const &fromPath);
+
+        /**
+        Convert a catalog file, passing each chunk of converted records to a callback
+
+        @param[in] callback  function to call for each chunk of converted records
+        @param[in] fromPath  path of input catalog
+        @return number of records converted
+        @throw std::runtime_error if the input catalog cannot be read,
+            if its size is not a multiple of sizeof(CatalogRecord),
+            or if a polar angle is not in range [-90, 90]
+        */
+        std::size_t streamFile(CatalogCallback const &callback, std::string const &fromPath);
+
+        /// return the conversion plan
+        ConversionPlan const &getPlan() const { return _plan; };
+
+        /// return the number of records converted at a time
+        int getChunkSize() const { return _chunkSize; };
+
+        /**
+        Return a string representation
+        */
+        std::string __repr__() const;
+
+    private:
+        ConversionPlan _plan;   ///< conversion plan
+        int _chunkSize;         ///< number of records to convert at a time
+        CoordArray _fromArr;    ///< buffer for one chunk of unconverted positions
+        CoordArray _toArr;      ///< buffer for one chunk of converted positions
+    };
+
+    std::ostream &operator<<(std::ostream &os, CatalogConverter const &catalogConverter);
+
+}
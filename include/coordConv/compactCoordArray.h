@@ -0,0 +1,122 @@
+#pragma once
+
+#include <string>
+#include "Eigen/Dense"
+#include "coordConv/coord.h"
+#include "coordConv/coordArray.h"
+
+namespace coordConv {
+
+    /// maximum error in direction caused by storing a position in a CompactCoordArray (arcsec)
+    const double CompactDirErr = 0.0124;
+
+    /**
+    A compact array of positions and proper motions, stored as a structure of single-precision arrays
+
+    Intended for holding very large catalogs in memory, where the 48 bytes per position of CoordArray
+    (or the larger size of Coord) dominates memory use and memory bandwidth. Each position is stored
+    as 7 floats (28 bytes):
+    - dir: a unit vector along the position
+    - parallax: parallax (arcsec), or 0 if the position is at infinity
+    - pmRate: the cartesian proper motion and radial velocity divided by the distance (1/year);
+        this is independent of distance, so it stores well as a float
+
+    Error bounds (due to rounding to float, whose relative precision is 2^-24 = 6e-8):
+    - direction: less than CompactDirErr = 0.0124 arcsec, which is well below the pointing error of a telescope
+    - distance and parallax: relative error less than 6e-8
+    - proper motion and radial velocity: relative error less than 1.2e-7 of the magnitude of the space motion;
+        for example less than 1.2e-5 arcsec/century for a star whose space motion is 100 arcsec/century
+
+    Positions are converted by expanding them to a CoordArray (see getCoordArray and setCoordArray);
+    ConversionPlan::convert does this in chunks small enough to stay in cache.
+    */
+    class CompactCoordArray {
+    public:
+        Eigen::MatrixX3f dir;       ///< unit vector along the position; one row per position
+        Eigen::VectorXf parallax;   ///< parallax (arcsec); 0 if at infinity
+        Eigen::MatrixX3f pmRate;    ///< cartesian proper motion and radial velocity / distance (1/year); one row per position
+
+        /**
+        Construct a CompactCoordArray of the specified size with unknown (NaN) position and zero proper motion
+
+        @param[in] size  number of positions
+        */
+        explicit CompactCoordArray(int size=0);
+
+        /**
+        Construct a CompactCoordArray from a CoordArray
+
+        @param[in] coordArr  positions and proper motions to store
+        */
+        explicit CompactCoordArray(CoordArray const &coordArr);
+
+        ~CompactCoordArray() {};
+
+        /**
+        Return the number of positions
+        */
+        int size() const { return dir.rows(); };
+
+        /**
+        Change the number of positions; all data is lost
+
+        @param[in] size  new number of positions
+        */
+        void resize(int size);
+
+        /**
+        Return one element as a Coord
+
+        @param[in] ind  index of element
+        @throw std::out_of_range if ind is not in range [0, size())
+        */
+        Coord getCoord(int ind) const;
+
+        /**
+        Set one element from a Coord
+
+        @param[in] ind  index of element
+        @param[in] coord  coordinate
+        @throw std::out_of_range if ind is not in range [0, size())
+        */
+        void setCoord(int ind, Coord const &coord);
+
+        /**
+        Expand a range of elements into a CoordArray
+
+        @param[out] coordArr  expanded positions; resized to num
+        @param[in] start  index of first element
+        @param[in] num  number of elements
+        @throw std::out_of_range if [start, start + num) is not a subset of [0, size())
+        */
+        void getCoordArray(CoordArray &coordArr, int start, int num) const;
+
+        /**
+        Expand all elements into a CoordArray
+
+        @param[out] coordArr  expanded positions; resized to size()
+        */
+        void getCoordArray(CoordArray &coordArr) const { getCoordArray(coordArr, 0, size()); };
+
+        /**
+        Set a range of elements from a CoordArray
+
+        @param[in] start  index of first element to set
+        @param[in] coordArr  positions to store; elements [start, start + coordArr.size()) are set
+        @throw std::out_of_range if [start, start + coordArr.size()) is not a subset of [0, size())
+        */
+        void setCoordArray(int start, CoordArray const &coordArr);
+
+        /**
+        Return a string representation
+        */
+        std::string __repr__() const;
+
+    private:
+        void _checkIndex(int ind) const;
+        void _checkRange(int start, int num) const;
+    };
+
+    std::ostream &operator<<(std::ostream &os, CompactCoordArray const &compactArr);
+
+}
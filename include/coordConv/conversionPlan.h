@@ -0,0 +1,113 @@
+#pragma once
+
+#include <string>
+#include "Eigen/Dense"
+#include "coordConv/site.h"
+#include "coordConv/coord.h"
+#include "coordConv/coordArray.h"
+#include "coordConv/compactCoordArray.h"
+#include "coordConv/coordSys.h"
+#include "coordConv/conversionShortcut.h"
+
+namespace coordConv {
+
+    /**
+    A precomputed conversion between two coordinate systems at a fixed TAI date
+
+    Intended for converting many coordinates between the same pair of coordinate systems
+    at the same date. Conversions that are a rotation plus a proper motion correction
+    (see CoordSys::getRotationToFK5J2000), such as FK5 to galactic, are fused into a single
+    rotation matrix and proper motion span, so each conversion is one matrix-vector product.
+    Other conversions use the registered conversion shortcut, if any (see ConversionShortcut),
+    else are performed in two steps via FK5 J2000, as CoordSys::convertFrom does.
+
+    The plan holds its own copies of the coordinate systems; if a coordinate system is current
+    then its copy is set to the specified TAI date. Thus the plan is not affected by later changes
+    to the coordinate systems or site from which it was constructed.
+    */
+    class ConversionPlan {
+    public:
+        /**
+        Construct a ConversionPlan
+
+        @param[in] fromCoordSys  initial coordinate system
+        @param[in] toCoordSys  final coordinate system
+        @param[in] site  site information
+        @param[in] tai  TAI date of conversion (MJD, sec); used for any coordinate system that is current
+        */
+        explicit ConversionPlan(CoordSys const &fromCoordSys, CoordSys const &toCoordSys, Site const &site, double tai);
+
+        ~ConversionPlan() {};
+
+        /**
+        Convert a coordinate
+
+        Equivalent to toCoordSys.convertFrom(fromCoordSys, fromCoord, site, tai)
+
+        @param[in] fromCoord  position in initial coordinate system
+        @return position in final coordinate system
+        */
+        Coord convert(Coord const &fromCoord) const;
+
+        /**
+        Convert an array of coordinates
+
+        Equivalent to toCoordSys.convertFrom(toCoordArr, fromCoordSys, fromCoordArr, site, tai)
+
+        @param[out] toCoordArr  positions in final coordinate system;
+            resized as needed; may be the same object as fromCoordArr
+        @param[in] fromCoordArr  positions in initial coordinate system
+        */
+        void convert(CoordArray &toCoordArr, CoordArray const &fromCoordArr) const;
+
+        /**
+        Convert a compact array of coordinates
+
+        Positions are expanded to a CoordArray, converted and compacted again, one chunk at a time,
+        so the full-precision data for only one chunk is in memory at once.
+        The results match the CoordArray version to within the precision of CompactCoordArray.
+
+        @param[out] toCompactArr  positions in final coordinate system;
+            resized as needed; may be the same object as fromCompactArr
+        @param[in] fromCompactArr  positions in initial coordinate system
+        @param[in] chunkSize  number of positions to convert at a time
+        @throw std::invalid_argument if chunkSize < 1
+        */
+        void convert(CompactCoordArray &toCompactArr, CompactCoordArray const &fromCompactArr, int chunkSize=1024) const;
+
+        /**
+        Return true if the conversion has been fused into a single rotation and proper motion correction
+        */
+        bool isRotation() const { return _isRotation; };
+
+        /// return the initial coordinate system (a copy, set to the TAI date if current)
+        CoordSys::ConstPtr getFromCoordSys() const { return _fromCoordSysPtr; };
+
+        /// return the final coordinate system (a copy, set to the TAI date if current)
+        CoordSys::ConstPtr getToCoordSys() const { return _toCoordSysPtr; };
+
+        /// return the site
+        Site getSite() const { return _site; };
+
+        /// return the TAI date of conversion (MJD, sec)
+        double getTAI() const { return _tai; };
+
+        /**
+        Return a string representation
+        */
+        std::string __repr__() const;
+
+    private:
+        CoordSys::ConstPtr _fromCoordSysPtr;    ///< initial coordinate system
+        CoordSys::ConstPtr _toCoordSysPtr;      ///< final coordinate system
+        Site _site;             ///< site information
+        double _tai;            ///< TAI date of conversion (MJD, sec)
+        bool _isRotation;       ///< is the conversion a rotation and proper motion correction?
+        Eigen::Matrix3d _rotMat;    ///< rotation matrix; only used if _isRotation
+        double _pmSpan;         ///< time over which to correct for proper motion (years); only used if _isRotation
+        ConversionShortcut::ConstPtr _shortcutPtr;  ///< conversion shortcut; null if none or if _isRotation
+    };
+
+    std::ostream &operator<<(std::ostream &os, ConversionPlan const &conversionPlan);
+
+}
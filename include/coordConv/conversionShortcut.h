@@ -0,0 +1,124 @@
+#pragma once
+
+#include <typeinfo>
+#include "boost/shared_ptr.hpp"
+#include "Eigen/Dense"
+#include "coordConv/site.h"
+#include "coordConv/coord.h"
+#include "coordConv/coordArray.h"
+#include "coordConv/coordSys.h"
+
+namespace coordConv {
+
+    /**
+    A direct conversion between two types of coordinate system, bypassing FK5 J2000
+
+    CoordSys::convertFrom normally converts via FK5 J2000: fromCoordSys.toFK5J2000 then toCoordSys.fromFK5J2000.
+    For some pairs of coordinate systems that is far more work than necessary; for instance converting
+    observed to apparent topocentric coordinates only requires removing refraction, yet the route via FK5 J2000
+    also converts to and from apparent geocentric coordinates (one direction of which is iterative).
+
+    Shortcuts are registered by coordinate system type (see registerConversionShortcut),
+    and CoordSys::convertFrom (and ConversionPlan) use the registered shortcut for a pair of coordinate systems
+    if there is one and it can convert between them at their current dates (see canConvert).
+    Built-in shortcuts are registered for:
+    - ObsCoordSys, AppTopoCoordSys and AppGeoCoordSys, in both directions, if the coordinate systems have the same date
+    - ICRSCoordSys to ICRSCoordSys, FK5CoordSys to FK5CoordSys and GalCoordSys to GalCoordSys
+        (e.g. at different dates): a single rotation and proper motion correction
+
+    Shortcuts are shared between threads, so must be immutable.
+    */
+    class ConversionShortcut {
+    public:
+        typedef boost::shared_ptr<const ConversionShortcut> ConstPtr;
+
+        virtual ~ConversionShortcut() {};
+
+        /**
+        Return true if this shortcut can convert between two coordinate systems
+
+        Called after the date of each current coordinate system has been set to the date of conversion.
+
+        @param[in] fromCoordSys  initial coordinate system
+        @param[in] toCoordSys  final coordinate system
+        */
+        virtual bool canConvert(CoordSys const &fromCoordSys, CoordSys const &toCoordSys) const = 0;
+
+        /**
+        Convert a coordinate
+
+        @param[in] fromCoordSys  initial coordinate system
+        @param[in] toCoordSys  final coordinate system
+        @param[in] fromCoord  position in initial coordinate system
+        @param[in] site  site information
+        @return position in final coordinate system
+        */
+        virtual Coord convert(CoordSys const &fromCoordSys, CoordSys const &toCoordSys,
+            Coord const &fromCoord, Site const &site) const = 0;
+
+        /**
+        Convert an array of coordinates
+
+        The default implementation converts one coordinate at a time.
+
+        @param[out] toCoordArr  positions in final coordinate system;
+            resized as needed; may be the same object as fromCoordArr
+        @param[in] fromCoordSys  initial coordinate system
+        @param[in] toCoordSys  final coordinate system
+        @param[in] fromCoordArr  positions in initial coordinate system
+        @param[in] site  site information
+        */
+        virtual void convert(CoordArray &toCoordArr, CoordSys const &fromCoordSys, CoordSys const &toCoordSys,
+            CoordArray const &fromCoordArr, Site const &site) const;
+
+        /**
+        Convert a coordinate and compute the local linear model of the conversion
+
+        The default implementation computes the jacobian by finite differences and sets posRate to zero.
+
+        @param[out] jacobian  partial derivative of final position with respect to initial position
+        @param[out] posRate  partial derivative of final position with respect to TAI date (AU/sec),
+            with the initial position held fixed; 0 unless the conversion changes with the date of conversion
+        @param[in] fromCoordSys  initial coordinate system
+        @param[in] toCoordSys  final coordinate system
+        @param[in] fromCoord  position in initial coordinate system
+        @param[in] site  site information
+        @return position in final coordinate system
+        */
+        virtual Coord convert(Eigen::Matrix3d &jacobian, Eigen::Vector3d &posRate,
+            CoordSys const &fromCoordSys, CoordSys const &toCoordSys, Coord const &fromCoord, Site const &site) const;
+    };
+
+    /**
+    Register a conversion shortcut between two types of coordinate system, replacing any existing shortcut
+
+    Types must match exactly (a shortcut registered for ObsCoordSys is not used for subclasses of ObsCoordSys).
+    Registering is thread-safe, but is intended to be done at startup.
+    Lookups never wait for registration, though each takes a short internal spinlock.
+
+    @param[in] fromType  type of initial coordinate system, e.g. typeid(ObsCoordSys)
+    @param[in] toType  type of final coordinate system
+    @param[in] shortcutPtr  shortcut; if null then any existing shortcut is removed, so the conversion goes via FK5 J2000
+    */
+    void registerConversionShortcut(std::type_info const &fromType, std::type_info const &toType,
+        ConversionShortcut::ConstPtr const &shortcutPtr);
+
+    /**
+    Find the conversion shortcut between two coordinate systems
+
+    @param[in] fromCoordSys  initial coordinate system
+    @param[in] toCoordSys  final coordinate system
+    @return the shortcut registered for the types of the coordinate systems, if there is one and it can convert
+        between them at their current dates (see ConversionShortcut::canConvert), else null
+    */
+    ConversionShortcut::ConstPtr findConversionShortcut(CoordSys const &fromCoordSys, CoordSys const &toCoordSys);
+
+    /**
+    Return true if a conversion shortcut is registered between two coordinate systems (regardless of date)
+
+    @param[in] fromCoordSys  initial coordinate system
+    @param[in] toCoordSys  final coordinate system
+    */
+    bool hasConversionShortcut(CoordSys const &fromCoordSys, CoordSys const &toCoordSys);
+
+}
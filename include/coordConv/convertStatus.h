@@ -0,0 +1,41 @@
+#pragma once
+
+namespace coordConv {
+
+    /**
+    Status returned by the non-throwing ("try") conversion methods, such as CoordSys::tryConvertFrom
+
+    These methods are intended for real-time code, which must not pay for exception handling
+    or build error messages on the heap. Each try method reports failure by returning a code other
+    than ConvertStatus_OK; the corresponding throwing method is a thin wrapper that calls
+    throwIfFailed on the returned code.
+    */
+    enum ConvertStatusEnum {
+        ConvertStatus_OK = 0,           ///< success
+        ConvertStatus_NotCurrent,       ///< cannot set current date; the coordinate system is not current
+        ConvertStatus_BadDate,          ///< date is not finite and > 0
+        ConvertStatus_DateTooLarge,     ///< date too large; perhaps TAI (MJD, sec) was used instead of TDB years
+        ConvertStatus_CacheNotValid,    ///< the coordinate system has no valid date-dependent data
+        ConvertStatus_AtPole,           ///< position is too near a pole to compute orientation or offset
+        ConvertStatus_UnknownMethod     ///< unknown velocity or orientation method
+    };
+
+    /**
+    Return a description of a conversion status
+
+    @param[in] status  conversion status
+    @return a description of the status; a static string, so no memory is allocated
+    */
+    char const *convertStatusMessage(ConvertStatusEnum status);
+
+    /**
+    Throw an exception describing a conversion status, unless the status is ConvertStatus_OK
+
+    @param[in] status  conversion status
+
+    @throw std::invalid_argument if status is ConvertStatus_UnknownMethod
+    @throw std::runtime_error if status is any other failure
+    */
+    void throwIfFailed(ConvertStatusEnum status);
+
+}
@@ -4,6 +4,7 @@
 #include <map>
 #include <string>
 #include "Eigen/Dense"
+#include "coordConv/convertStatus.h"
 
 namespace coordConv {
     
@@ -84,6 +85,14 @@ namespace coordConv {
         Return true if so near the pole that equatorial angles cannot be computed
         */
         bool atPole() const { return _atPole; }
+
+        /**
+        Return true if proper motion or radial velocity is nonzero (or unknown)
+
+        Fixed targets (those with no proper motion or radial velocity) are common, and the coordinate systems
+        use this to skip the velocity terms when converting them.
+        */
+        bool hasPM() const { return _hasPM; }
         
         /**
         Get distance in AU
@@ -188,6 +197,19 @@ namespace coordConv {
         */
         Coord offset(double &toOrient, double fromOrient, double dist) const;
 
+        /**
+        Compute a new coord offset from this coord along the arc of a great circle, without throwing
+
+        The same as offset, but reports failure with a status code, for use by real-time code.
+
+        @param[out] toCoord  offset coord; a null Coord on failure; may be this coord
+        @param[out] toOrient  orientation of offset arc at offset position (deg); NaN on failure
+        @param[in] fromOrient  orientation of offset arc at this position (deg)
+        @param[in] dist  offset distance as the length of the arc of a great circle (deg)
+        @return ConvertStatus_OK, or ConvertStatus_AtPole if this coord is too near a pole
+        */
+        ConvertStatusEnum tryOffset(Coord &toCoord, double &toOrient, double fromOrient, double dist) const;
+
         bool operator==(Coord const &rhs) {
             return (this->getVecPos() == rhs.getVecPos()) && (this->getVecPM() == rhs.getVecPM());
         }
@@ -201,28 +223,83 @@ namespace coordConv {
         */
         std::string __repr__() const;
 
-    private:
-        Eigen::Vector3d _pos;   // vector position (AU)
-        Eigen::Vector3d _pm;    // vector proper motion and radial velocity (AU/year)
-        double _dist;           // distance (AU); a cache of _pos.norm()
-        bool _atInfinity;       // true if distance far enough; a cached value
-        bool _atPole;           // true if very near the pole; a cached value
-        
         /**
-        Set _pos from spherical position; used by several constructors
-        
+        Compute cartesian position from spherical position, as Coord(equatAng, polarAng, parallax) does
+
+        This and the following static methods hold the math used by the constructors and accessors,
+        so that code which handles many positions without making a Coord for each
+        (e.g. coordArrayFromCatalog) gives the same results as Coord.
+
         @param[in] equatAng  equatorial angle (e.g. RA, Long, Az) (degrees)
         @param[in] polarAng  polar angle (e.g. Dec, Latitude, Alt) (degrees)
         @param[in] parallax  parallax (arcsec)
+        @return cartesian position (AU)
+        @throw std::runtime_error if polarAng not in range [-90, 90]
+        */
+        static Eigen::Vector3d vecPosFromSph(double equatAng, double polarAng, double parallax);
+
+        /**
+        Compute cartesian proper motion from spherical proper motion and radial velocity
 
-        @warning Does not set _pm
+        @param[in] equatAng  equatorial angle (degrees)
+        @param[in] polarAng  polar angle (degrees)
+        @param[in] dist  distance (AU)
+        @param[in] equatPM  equatorial proper motion (arcsec/century)
+        @param[in] polarPM  polar proper motion (arcsec/century)
+        @param[in] radVel  radial velocity (km/sec, positive receding)
+        @return cartesian proper motion and radial velocity (AU/year)
+        */
+        static Eigen::Vector3d vecPMFromSph(double equatAng, double polarAng, double dist,
+            double equatPM, double polarPM, double radVel);
+
+        /// return true if a position at distance dist (AU) is considered to be at infinity; see atInfinity()
+        static bool isAtInfinity(double dist);
+
+        /// return true if position pos, at distance dist (AU), is too near the pole; see atPole()
+        static bool isAtPole(Eigen::Vector3d const &pos, double dist);
+
+        /// return parallax (arcsec) for distance dist (AU), or 0 if isAtInfinity(dist); see getParallax()
+        static double parallaxFromDist(double dist);
+
+        /**
+        Compute spherical position from cartesian position; see getSphPos()
+
+        @param[out] equatAng  equatorial angle (degrees); 0 if atPole
+        @param[out] polarAng  polar angle (degrees)
+        @param[in] pos  cartesian position (AU)
+        @param[in] atPole  isAtPole(pos, distance)
+        */
+        static void sphPosFromVec(double &equatAng, double &polarAng, Eigen::Vector3d const &pos, bool atPole);
+
+        /**
+        Compute spherical proper motion from cartesian position and proper motion; see getPM()
+
+        @param[out] equatPM  equatorial proper motion (arcsec/century); 0 if atPole
+        @param[out] polarPM  polar proper motion (arcsec/century); 0 if atPole
+        @param[in] pos  cartesian position (AU)
+        @param[in] pm  cartesian proper motion and radial velocity (AU/year)
+        @param[in] dist  distance (AU): the magnitude of pos
+        @param[in] atPole  isAtPole(pos, dist)
         */
-        void _setPosFromSph(double equatAng, double polarAng, double parallax);
+        static void sphPMFromVec(double &equatPM, double &polarPM, Eigen::Vector3d const &pos,
+            Eigen::Vector3d const &pm, double dist, bool atPole);
+
+        /// return radial velocity (km/sec) from cartesian position, proper motion and distance; see getRadVel()
+        static double radVelFromVec(Eigen::Vector3d const &pos, Eigen::Vector3d const &pm, double dist);
+
+    private:
+        Eigen::Vector3d _pos;   // vector position (AU)
+        Eigen::Vector3d _pm;    // vector proper motion and radial velocity (AU/year)
+        double _dist;           // distance (AU); a cache of _pos.norm()
+        bool _atInfinity;       // true if distance far enough; a cached value
+        bool _atPole;           // true if very near the pole; a cached value
+        bool _hasPM;            // true if any element of _pm is nonzero (or NaN); a cached value
         
         /**
         Set various cached information
         
         _pos must be set before you call this; _pm need not be set.
+        Does not set _hasPM; each constructor sets that when it sets _pm.
         */
         void _setCache();
     };
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <string>
+#include "Eigen/Dense"
+#include "coordConv/coord.h"
+
+namespace coordConv {
+
+    /**
+    An array of cartesian positions and proper motions, stored as a structure of arrays
+
+    Intended for converting many positions at once (see the CoordArray version of CoordSys::convertFrom).
+    Position and proper motion are each stored as an N x 3 column-major matrix, so each cartesian
+    component (e.g. the x component of position) is contiguous in memory.
+    Units are the same as for Coord: position in AU and proper motion in AU/year.
+    */
+    class CoordArray {
+    public:
+        Eigen::MatrixX3d pos;   ///< cartesian position (AU); one row per position
+        Eigen::MatrixX3d pm;    ///< cartesian proper motion and radial velocity (AU/year); one row per position
+
+        /**
+        Construct a CoordArray of the specified size with unknown (NaN) position and zero proper motion
+
+        @param[in] size  number of positions
+        */
+        explicit CoordArray(int size=0);
+
+        /**
+        Construct a CoordArray from cartesian positions; proper motion is zero
+
+        @param[in] pos  cartesian positions (AU); one row per position
+        */
+        explicit CoordArray(Eigen::MatrixX3d const &pos);
+
+        /**
+        Construct a CoordArray from cartesian positions and proper motions
+
+        @param[in] pos  cartesian positions (AU); one row per position
+        @param[in] pm  cartesian proper motions (AU/year); one row per position
+
+        @throw std::invalid_argument if pos and pm have a different number of rows
+        */
+        explicit CoordArray(Eigen::MatrixX3d const &pos, Eigen::MatrixX3d const &pm);
+
+        ~CoordArray() {};
+
+        /**
+        Return the number of positions
+        */
+        int size() const { return pos.rows(); };
+
+        /**
+        Return true if any proper motion or radial velocity is nonzero (or unknown)
+
+        This scans pm, so it is best called once per array, as the array conversions do
+        before deciding whether to skip the velocity terms.
+        */
+        bool hasPM() const { return !pm.isZero(0); };
+
+        /**
+        Change the number of positions; all data is lost
+
+        @param[in] size  new number of positions
+        */
+        void resize(int size);
+
+        /**
+        Return one element as a Coord
+
+        @param[in] ind  index of element
+        @throw std::out_of_range if ind is not in range [0, size())
+        */
+        Coord getCoord(int ind) const;
+
+        /**
+        Set one element from a Coord
+
+        @param[in] ind  index of element
+        @param[in] coord  coordinate
+        @throw std::out_of_range if ind is not in range [0, size())
+        */
+        void setCoord(int ind, Coord const &coord);
+
+        /**
+        Return a string representation
+        */
+        std::string __repr__() const;
+
+    private:
+        void _checkIndex(int ind) const;
+    };
+
+    std::ostream &operator<<(std::ostream &os, CoordArray const &coordArr);
+
+}
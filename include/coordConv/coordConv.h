@@ -2,12 +2,27 @@
 
 #include "coordConv/physConst.h"
 #include "coordConv/mathUtils.h"
+#include "coordConv/convertStatus.h"
 #include "coordConv/time.h"
 #include "coordConv/angSideAng.h"
 #include "coordConv/rotEqPol.h"
 #include "coordConv/rotXY.h"
+#include "coordConv/aberration.h"
+#include "coordConv/siderealTime.h"
+#include "coordConv/refractionTable.h"
+#include "coordConv/refCo.h"
 #include "coordConv/site.h"
 #include "coordConv/coord.h"
+#include "coordConv/coordArray.h"
+#include "coordConv/compactCoordArray.h"
 #include "coordConv/pvt.h"
 #include "coordConv/pvtCoord.h"
 #include "coordConv/coordSys.h"
+#include "coordConv/appGeoEphemeris.h"
+#include "coordConv/conversionShortcut.h"
+#include "coordConv/conversionPlan.h"
+#include "coordConv/catalogConverter.h"
+#include "coordConv/parallelConverter.h"
+#include "coordConv/sphArray.h"
+#include "coordConv/latencyHistogram.h"
+#include "coordConv/tracker.h"
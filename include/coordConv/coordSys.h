@@ -4,9 +4,11 @@
 #include <map>
 #include <string>
 #include "boost/shared_ptr.hpp"
+#include "coordConv/convertStatus.h"
 #include "coordConv/site.h"
 #include "coordConv/time.h"
 #include "coordConv/coord.h"
+#include "coordConv/coordArray.h"
 #include "coordConv/pvtCoord.h"
 #include "coordConv/physConst.h"
 
@@ -15,12 +17,27 @@ namespace coordConv {
     const double DeltaTForPos = 0.01; ///< delta time to use when computing velocity
         ///< by computing position at two nearby times (sec)
 
+    enum VelocityMethodEnum {
+        VelocityMethod_Analytic,    ///< propagate velocity through the jacobian of each conversion (fast)
+        VelocityMethod_TwoPoint     ///< convert position at two times DeltaTForPos apart (twice as slow)
+    };
+
+    enum OrientationMethodEnum {
+        OrientationMethod_Analytic, ///< propagate orientation through the jacobian of each conversion (fast)
+        OrientationMethod_Offset    ///< convert the position and a point offset along the orientation (twice as slow)
+    };
+
     enum DateTypeEnum {
         DateType_Julian,    ///< Julian years
         DateType_Besselian, ///< Besselian years
         DateType_TAI,       ///< TAI (MJD, seconds)
         DateType_None       ///< date is irrelevant
     };
+
+    enum AppGeoCacheModeEnum {
+        AppGeoCacheMode_Hold,           ///< use one snapshot until it is too old, then replace it (positions jump slightly)
+        AppGeoCacheMode_Interpolate     ///< interpolate between snapshots on a grid of dates (positions are continuous)
+    };
     
     /**
     Abstract base class for coordinate systems
@@ -99,10 +116,59 @@ namespace coordConv {
         Set the current date of this coordinate system; only valid if isCurrent()
 
         @param[in] date  current date, in units given by getDateType
-        @throw std::runtime_error if isCurrent() false
+        @throw std::runtime_error if isCurrent() false or the date is invalid (see trySetCurrDate)
         */
         void setCurrDate(double date) const;
-        
+
+        /**
+        Set the current date of this coordinate system, without throwing
+
+        @param[in] date  current date, in units given by getDateType
+        @return one of:
+        - ConvertStatus_OK on success
+        - ConvertStatus_NotCurrent if isCurrent() false
+        - ConvertStatus_BadDate if date is not finite and > 0
+        - another status if getDateStatus rejects the date
+        The date is unchanged on failure.
+        */
+        ConvertStatusEnum trySetCurrDate(double date) const;
+
+        /**
+        Return ConvertStatus_OK if a date is acceptable to this coordinate system, else the reason it is not
+
+        The default implementation accepts any date; override if some dates cannot be used.
+
+        @param[in] date  date, in units given by getDateType
+        */
+        virtual ConvertStatusEnum getDateStatus(double date) const { return ConvertStatus_OK; };
+
+        /**
+        Return ConvertStatus_OK if this coordinate system is ready to convert coordinates, else the reason it is not
+
+        The default implementation always returns ConvertStatus_OK;
+        override if conversion depends on data that may not have been computed.
+        */
+        virtual ConvertStatusEnum getConvertStatus() const { return ConvertStatus_OK; };
+
+        /**
+        Return an immutable copy of this coordinate system, fixed at the date corresponding to a given TAI
+
+        If this coordinate system is current, the copy is a non-current coordinate system whose date is
+        dateFromTAI(tai); otherwise the copy has the same date as this coordinate system.
+        Either way the copy is not current, so no conversion will change it (not even convertFrom,
+        which calls setCurrDate only for current coordinate systems). Thus one snapshot may be used
+        by many threads at once, whereas a current coordinate system may only be used by one thread at a time.
+
+        Converting positions using a snapshot gives the same result as using this coordinate system at
+        the given TAI. However, the velocity computed by the PVTCoord version of convertFrom does not
+        include the effects of the passage of time on a current coordinate system (e.g. Earth rotation
+        for apparent topocentric coordinates), since the snapshot's date is fixed.
+
+        @param[in] tai  TAI date (MJD, seconds); ignored if this coordinate system is not current
+        @throw std::runtime_error if this coordinate system is current and dateFromTAI(tai) <= 0
+        */
+        CoordSys::ConstPtr snapshot(double tai) const;
+
         /**
         Convert a coordinate to FK5 at date of observation J2000 from this coordinate system at this date
         
@@ -120,6 +186,88 @@ namespace coordConv {
         @return position in this coordinate system
         */
         virtual Coord fromFK5J2000(Coord const &coord, Site const &site) const = 0;
+
+        /**
+        Convert an array of coordinates to FK5 at date of observation J2000 from this coordinate system at this date
+
+        The default implementation converts one element at a time using the Coord version;
+        subclasses should override it with something faster.
+
+        @param[out] fk5J2000Arr  positions in FK5 coordinates at date of observation J2000;
+            resized as needed; may be the same object as coordArr
+        @param[in] coordArr  positions in this coordinate system at this date
+        @param[in] site  site information
+        */
+        virtual void toFK5J2000(CoordArray &fk5J2000Arr, CoordArray const &coordArr, Site const &site) const;
+
+        /**
+        Convert an array of coordinates from FK5 at date of observation J2000 to this system at this date
+
+        The default implementation converts one element at a time using the Coord version;
+        subclasses should override it with something faster.
+
+        @param[out] coordArr  positions in this coordinate system; resized as needed; may be the same object as fk5J2000Arr
+        @param[in] fk5J2000Arr  positions in FK5 coordinates at date of observation J2000
+        @param[in] site  site information
+        */
+        virtual void fromFK5J2000(CoordArray &coordArr, CoordArray const &fk5J2000Arr, Site const &site) const;
+
+        /**
+        Get toFK5J2000 as a rotation and proper motion correction, if it can be expressed that way
+
+        Some conversions have the form:
+        - FK5 J2000 position = rotMat * (position + (pmSpan * proper motion))
+        - FK5 J2000 proper motion = rotMat * proper motion
+
+        A chain of such conversions can be fused into one (see ConversionPlan).
+        The default implementation returns false.
+
+        @param[out] rotMat  rotation matrix; not set if the conversion does not have this form
+        @param[out] pmSpan  time over which to correct for proper motion (Julian years);
+            not set if the conversion does not have this form
+        @return true if the conversion has this form (and rotMat and pmSpan have been set)
+        */
+        virtual bool getRotationToFK5J2000(Eigen::Matrix3d &rotMat, double &pmSpan) const { return false; };
+
+        /**
+        Convert a coordinate to FK5 at date of observation J2000 from this coordinate system at this date,
+        and compute the local linear model of the conversion
+
+        The linear model allows velocity (and small offsets) to be propagated without converting twice:
+        d(FK5 J2000 position) = jacobian * d(position in this system) + posRate * d(TAI date)
+
+        The default implementation computes the jacobian by finite differences and sets posRate to 0;
+        subclasses should override it with something faster, and must override it if the conversion
+        of a current coordinate system depends on the date.
+
+        @param[out] jacobian  partial derivative of FK5 J2000 position with respect to position in this system
+        @param[out] posRate  partial derivative of FK5 J2000 position with respect to TAI date (AU/sec);
+            0 unless this coordinate system is current and the conversion depends on date
+        @param[in] coord  position in this coordinate system at this date
+        @param[in] site  site information
+        @return position in ICRS coordinates at date of observation J2000
+        */
+        virtual Coord toFK5J2000(Eigen::Matrix3d &jacobian, Eigen::Vector3d &posRate, Coord const &coord, Site const &site) const;
+
+        /**
+        Convert a coordinate from FK5 at date of observation J2000 to this system at this date,
+        and compute the local linear model of the conversion
+
+        The linear model allows velocity (and small offsets) to be propagated without converting twice:
+        d(position in this system) = jacobian * d(FK5 J2000 position) + posRate * d(TAI date)
+
+        The default implementation computes the jacobian by finite differences and sets posRate to 0;
+        subclasses should override it with something faster, and must override it if the conversion
+        of a current coordinate system depends on the date.
+
+        @param[out] jacobian  partial derivative of position in this system with respect to FK5 J2000 position
+        @param[out] posRate  partial derivative of position in this system with respect to TAI date (AU/sec);
+            0 unless this coordinate system is current and the conversion depends on date
+        @param[in] coord  position in ICRS coordinates at date of observation J2000
+        @param[in] site  site information
+        @return position in this coordinate system
+        */
+        virtual Coord fromFK5J2000(Eigen::Matrix3d &jacobian, Eigen::Vector3d &posRate, Coord const &coord, Site const &site) const;
         
         /**
         Convert a coordinate from another coordinate system to this system
@@ -127,11 +275,31 @@ namespace coordConv {
         @param[in] fromCoordSys  initial coordinate system and date
         @param[in] fromCoord  initial position
         @param[in] site  site information
-        @param[in] tai  TAI date (MJD, sec); used as the date of this coorSys and fromCoordSys,
+        @param[in] tai  TAI date (MJD, sec); used as the date of this coordSys and fromCoordSys,
            if either is current (ignored otherwise)
         @return position in this coordinate system
         */
         virtual Coord convertFrom(CoordSys const &fromCoordSys, Coord const &fromCoord, Site const &site, double tai=0) const;
+
+        /**
+        Convert a coordinate from another coordinate system to this system, without throwing
+
+        The try versions of convertFrom are intended for real-time code: they report failure
+        as a status code, rather than throwing an exception, and (except for the CoordArray version)
+        allocate no heap memory once any AppGeoCache is up to date. The corresponding convertFrom
+        is a thin wrapper that throws if the status is not ConvertStatus_OK.
+        On failure the outputs are set to null values (e.g. Coord()).
+
+        @param[out] toCoord  position in this coordinate system; may be the same object as fromCoord
+        @param[in] fromCoordSys  initial coordinate system and date
+        @param[in] fromCoord  initial position
+        @param[in] site  site information
+        @param[in] tai  TAI date (MJD, sec); used as the date of this coordSys and fromCoordSys,
+           if either is current (ignored otherwise)
+        @return ConvertStatus_OK on success, else the reason for failure; see trySetCurrDate and getConvertStatus
+        */
+        virtual ConvertStatusEnum tryConvertFrom(Coord &toCoord,
+            CoordSys const &fromCoordSys, Coord const &fromCoord, Site const &site, double tai=0) const;
         
         /**
         Convert a PVTCoord from another coordinate system to this system
@@ -142,9 +310,65 @@ namespace coordConv {
         @param[in] fromCoordSys  initial coordinate system and date
         @param[in] fromPVTCoord  initial PVTCoord
         @param[in] site  site information
+        @param[in] velMethod  how to compute velocity:
+            - VelocityMethod_Analytic (default): convert position once and propagate velocity
+              through the jacobian of each conversion (see the jacobian version of toFK5J2000)
+            - VelocityMethod_TwoPoint: convert position at two times DeltaTForPos apart
         @return position in this coordinate system
         */
-        virtual PVTCoord convertFrom(CoordSys const &fromCoordSys, PVTCoord const &fromPVTCoord, Site const &site) const;
+        virtual PVTCoord convertFrom(CoordSys const &fromCoordSys, PVTCoord const &fromPVTCoord, Site const &site,
+            VelocityMethodEnum velMethod=VelocityMethod_Analytic) const;
+
+        /**
+        Convert a PVTCoord from another coordinate system to this system, without throwing
+
+        See the Coord version of tryConvertFrom for details.
+
+        @param[out] toPVTCoord  position in this coordinate system; may be the same object as fromPVTCoord
+        @param[in] fromCoordSys  initial coordinate system and date
+        @param[in] fromPVTCoord  initial PVTCoord
+        @param[in] site  site information
+        @param[in] velMethod  how to compute velocity; see convertFrom
+        @return ConvertStatus_OK on success, ConvertStatus_UnknownMethod if velMethod is unknown,
+            else the reason for failure; see trySetCurrDate and getConvertStatus
+        */
+        virtual ConvertStatusEnum tryConvertFrom(PVTCoord &toPVTCoord,
+            CoordSys const &fromCoordSys, PVTCoord const &fromPVTCoord, Site const &site,
+            VelocityMethodEnum velMethod=VelocityMethod_Analytic) const;
+
+        /**
+        Convert an array of coordinates from another coordinate system to this system
+
+        Much faster than converting one Coord at a time, because the date of each coordinate system
+        is set once (so cached information, such as that of AppGeoCoordSys, is computed at most once)
+        and because each coordinate system converts the entire array in one call.
+
+        @param[out] toCoordArr  positions in this coordinate system; resized as needed;
+            may be the same object as fromCoordArr
+        @param[in] fromCoordSys  initial coordinate system and date
+        @param[in] fromCoordArr  initial positions
+        @param[in] site  site information
+        @param[in] tai  TAI date (MJD, sec); used as the date of this coordSys and fromCoordSys,
+           if either is current (ignored otherwise)
+        */
+        virtual void convertFrom(CoordArray &toCoordArr, CoordSys const &fromCoordSys, CoordArray const &fromCoordArr, Site const &site, double tai=0) const;
+
+        /**
+        Convert an array of coordinates from another coordinate system to this system, without throwing
+
+        See the Coord version of tryConvertFrom for details; unlike that version, this may allocate memory.
+
+        @param[out] toCoordArr  positions in this coordinate system; resized as needed;
+            may be the same object as fromCoordArr; unchanged on failure
+        @param[in] fromCoordSys  initial coordinate system and date
+        @param[in] fromCoordArr  initial positions
+        @param[in] site  site information
+        @param[in] tai  TAI date (MJD, sec); used as the date of this coordSys and fromCoordSys,
+           if either is current (ignored otherwise)
+        @return ConvertStatus_OK on success, else the reason for failure; see trySetCurrDate and getConvertStatus
+        */
+        virtual ConvertStatusEnum tryConvertFrom(CoordArray &toCoordArr,
+            CoordSys const &fromCoordSys, CoordArray const &fromCoordArr, Site const &site, double tai=0) const;
         
         /**
         Convert a PVT coordinate from another coordinate system to this system
@@ -155,15 +379,46 @@ namespace coordConv {
         @param[in] fromCoord  initial position
         @param[in] fromDir  initial orientation (deg; 0 along increasing equatorial angle, 90 along increasing polar angle)
         @param[in] site  site information
-        @param[in] tai  TAI date (MJD, sec); used as the date of this coorSys and fromCoordSys,
+        @param[in] tai  TAI date (MJD, sec); used as the date of this coordSys and fromCoordSys,
            if either is current (ignored otherwise)
-        @return position in this coordinate system
+        @param[in] orientMethod  how to compute toDir and scaleChange:
+            - OrientationMethod_Analytic (default): convert position once and propagate an infinitesimal
+              offset along fromDir through the jacobian of each conversion (see the jacobian version of toFK5J2000)
+            - OrientationMethod_Offset: also convert a point offset 1e-3 degrees along fromDir
+        @return position in this coordinate system; toDir is NaN if the position is at a pole
+
+        @throw std::invalid_argument if orientMethod is unknown
+        @throw std::runtime_error if fromCoord is at a pole
 
         @warning the computed orientation will not round trip if converting a very nearby object
         from apparent topocentric or observed to apparent geocentric or mean coordinates.
         */
         virtual Coord convertFrom(double &toDir, double &scaleChange,
-            CoordSys const &fromCoordSys, Coord const &fromCoord, double fromDir, Site const &site, double tai=0) const;
+            CoordSys const &fromCoordSys, Coord const &fromCoord, double fromDir, Site const &site, double tai=0,
+            OrientationMethodEnum orientMethod=OrientationMethod_Analytic) const;
+
+        /**
+        Convert a coordinate from another coordinate system to this system, including orientation, without throwing
+
+        See the Coord version of tryConvertFrom for details.
+
+        @param[out] toCoord  position in this coordinate system; may be the same object as fromCoord
+        @param[out] toDir  orientation in this coordinate system (deg); see convertFrom
+        @param[out] scaleChange  change in scale: output delta sky/input delta sky, measured along the specified direction
+        @param[in] fromCoordSys  initial coordinate system
+        @param[in] fromCoord  initial position
+        @param[in] fromDir  initial orientation (deg; 0 along increasing equatorial angle, 90 along increasing polar angle)
+        @param[in] site  site information
+        @param[in] tai  TAI date (MJD, sec); used as the date of this coordSys and fromCoordSys,
+           if either is current (ignored otherwise)
+        @param[in] orientMethod  how to compute toDir and scaleChange; see convertFrom
+        @return ConvertStatus_OK on success, ConvertStatus_UnknownMethod if orientMethod is unknown,
+            ConvertStatus_AtPole if fromCoord is at a pole,
+            else the reason for failure; see trySetCurrDate and getConvertStatus
+        */
+        virtual ConvertStatusEnum tryConvertFrom(Coord &toCoord, double &toDir, double &scaleChange,
+            CoordSys const &fromCoordSys, Coord const &fromCoord, double fromDir, Site const &site, double tai=0,
+            OrientationMethodEnum orientMethod=OrientationMethod_Analytic) const;
         
         /**
         Convert a PVTCoord from another coordinate system to this system, including orientation
@@ -177,10 +432,31 @@ namespace coordConv {
         @param[in] fromPVTCoord  initial position
         @param[in] fromDir  initial orientation (deg; 0 along increasing equatorial angle, 90 along increasing polar angle)
         @param[in] site  site information
+        @param[in] orientMethod  how to compute toDir and scaleChange; see the Coord version of this method
         @return position in this coordinate system
         */
         virtual PVTCoord convertFrom(PVT &toDir, double &scaleChange,
-            CoordSys const &fromCoordSys, PVTCoord const &fromPVTCoord, PVT const &fromDir, Site const &site) const;
+            CoordSys const &fromCoordSys, PVTCoord const &fromPVTCoord, PVT const &fromDir, Site const &site,
+            OrientationMethodEnum orientMethod=OrientationMethod_Analytic) const;
+
+        /**
+        Convert a PVTCoord from another coordinate system to this system, including orientation, without throwing
+
+        See the Coord version of tryConvertFrom for details.
+
+        @param[out] toPVTCoord  position in this coordinate system; may be the same object as fromPVTCoord
+        @param[out] toDir  orientation in this coordinate system (deg); see convertFrom
+        @param[out] scaleChange  change in scale: output delta sky/input delta sky, measured along the specified direction
+        @param[in] fromCoordSys  initial coordinate system
+        @param[in] fromPVTCoord  initial position
+        @param[in] fromDir  initial orientation (deg; 0 along increasing equatorial angle, 90 along increasing polar angle)
+        @param[in] site  site information
+        @param[in] orientMethod  how to compute toDir and scaleChange; see convertFrom
+        @return status, as for the Coord version of this method
+        */
+        virtual ConvertStatusEnum tryConvertFrom(PVTCoord &toPVTCoord, PVT &toDir, double &scaleChange,
+            CoordSys const &fromCoordSys, PVTCoord const &fromPVTCoord, PVT const &fromDir, Site const &site,
+            OrientationMethodEnum orientMethod=OrientationMethod_Analytic) const;
 
         /**
         Remove the effects of proper motion and radial velocity to the specified TAI date
@@ -245,6 +521,16 @@ namespace coordConv {
         */
         virtual void _setDate(double date) const { _date = date; };
 
+        /**
+        Set the date of each current coordinate system involved in a conversion, then check that both are ready to convert
+
+        @param[in] toCoordSys  final coordinate system
+        @param[in] fromCoordSys  initial coordinate system
+        @param[in] tai  TAI date (MJD, sec); used as the date of either coordinate system that is current
+        @return ConvertStatus_OK on success, else the first failure
+        */
+        static ConvertStatusEnum _prepareConversion(CoordSys const &toCoordSys, CoordSys const &fromCoordSys, double tai);
+
         std::string _name;  /// name of coordinate system
         mutable double _date;       /// date of coordinate system (units depend on coordinate system)
         DateTypeEnum _dateType; /// date type
@@ -287,6 +573,11 @@ namespace coordConv {
         virtual CoordSys::Ptr clone(double date) const;
         virtual Coord fromFK5J2000(Coord const &coord, Site const &site) const;
         virtual Coord toFK5J2000(Coord const &coord, Site const &site) const;
+        virtual void fromFK5J2000(CoordArray &coordArr, CoordArray const &fk5J2000Arr, Site const &site) const;
+        virtual void toFK5J2000(CoordArray &fk5J2000Arr, CoordArray const &coordArr, Site const &site) const;
+        virtual Coord fromFK5J2000(Eigen::Matrix3d &jacobian, Eigen::Vector3d &posRate, Coord const &coord, Site const &site) const;
+        virtual Coord toFK5J2000(Eigen::Matrix3d &jacobian, Eigen::Vector3d &posRate, Coord const &coord, Site const &site) const;
+        virtual bool getRotationToFK5J2000(Eigen::Matrix3d &rotMat, double &pmSpan) const;
         virtual std::string __repr__() const;
     };
     
@@ -309,6 +600,11 @@ namespace coordConv {
         virtual CoordSys::Ptr clone(double date) const;
         virtual Coord fromFK5J2000(Coord const &coord, Site const &site) const;
         virtual Coord toFK5J2000(Coord const &coord, Site const &site) const;
+        virtual void fromFK5J2000(CoordArray &coordArr, CoordArray const &fk5J2000Arr, Site const &site) const;
+        virtual void toFK5J2000(CoordArray &fk5J2000Arr, CoordArray const &coordArr, Site const &site) const;
+        virtual Coord fromFK5J2000(Eigen::Matrix3d &jacobian, Eigen::Vector3d &posRate, Coord const &coord, Site const &site) const;
+        virtual Coord toFK5J2000(Eigen::Matrix3d &jacobian, Eigen::Vector3d &posRate, Coord const &coord, Site const &site) const;
+        virtual bool getRotationToFK5J2000(Eigen::Matrix3d &rotMat, double &pmSpan) const;
         virtual std::string __repr__() const;
 
     protected:
@@ -342,8 +638,13 @@ namespace coordConv {
         virtual CoordSys::Ptr clone(double date) const;
         virtual Coord fromFK5J2000(Coord const &coord, Site const &site) const;
         virtual Coord toFK5J2000(Coord const &coord, Site const &site) const;
+        virtual void fromFK5J2000(CoordArray &coordArr, CoordArray const &fk5J2000Arr, Site const &site) const;
+        virtual void toFK5J2000(CoordArray &fk5J2000Arr, CoordArray const &coordArr, Site const &site) const;
+        virtual Coord fromFK5J2000(Eigen::Matrix3d &jacobian, Eigen::Vector3d &posRate, Coord const &coord, Site const &site) const;
+        virtual Coord toFK5J2000(Eigen::Matrix3d &jacobian, Eigen::Vector3d &posRate, Coord const &coord, Site const &site) const;
         virtual double dateFromTAI(double tai) const { return besselianEpochFromTAI(tai); };
         virtual double taiFromDate(double date) const { return taiFromBesselianEpoch(date); };
+        virtual Coord removePM(Coord const &coord, double tai) const;
         virtual std::string __repr__() const;
 
     protected:
@@ -374,9 +675,211 @@ namespace coordConv {
         virtual CoordSys::Ptr clone(double date) const;
         virtual Coord fromFK5J2000(Coord const &coord, Site const &site) const;
         virtual Coord toFK5J2000(Coord const &coord, Site const &site) const;
+        virtual void fromFK5J2000(CoordArray &coordArr, CoordArray const &fk5J2000Arr, Site const &site) const;
+        virtual void toFK5J2000(CoordArray &fk5J2000Arr, CoordArray const &coordArr, Site const &site) const;
+        virtual Coord fromFK5J2000(Eigen::Matrix3d &jacobian, Eigen::Vector3d &posRate, Coord const &coord, Site const &site) const;
+        virtual Coord toFK5J2000(Eigen::Matrix3d &jacobian, Eigen::Vector3d &posRate, Coord const &coord, Site const &site) const;
+        virtual bool getRotationToFK5J2000(Eigen::Matrix3d &rotMat, double &pmSpan) const;
         virtual std::string __repr__() const;
     };
 
+    const int AmprmsSize = 21;  ///< number of star-independent parameters computed by SLALIB's slaMappa
+
+    class AppGeoEphemeris;
+
+    /**
+    Star-independent parameters for converting between FK5 J2000 and apparent geocentric coordinates
+
+    Once constructed, AppGeoData is only handled through ConstPtr (a pointer to const),
+    so a snapshot may be shared freely between threads and coordinate systems.
+    */
+    class AppGeoData {
+    public:
+        typedef boost::shared_ptr<const AppGeoData> ConstPtr;
+
+        /**
+        Construct with date and all parameters set to NaN
+        */
+        explicit AppGeoData();
+
+        /**
+        Compute star-independent parameters at a given date
+
+        @param[in] date  TDB date in Julian years (but TT will always do)
+        */
+        explicit AppGeoData(double date);
+
+        /**
+        Construct from star-independent parameters in the format computed by SLALIB's slaMappa
+
+        @param[in] date  TDB date in Julian years (but TT will always do)
+        @param[in] amprms  star-independent parameters at that date (AmprmsSize values)
+        */
+        explicit AppGeoData(double date, double const *amprms);
+
+        /**
+        Compute star-independent parameters at a given date by linear interpolation between two snapshots
+
+        @param[in] data0  snapshot at an earlier date
+        @param[in] data1  snapshot at a later date
+        @param[in] date  TDB date in Julian years; should be in the range [data0.date, data1.date]
+        */
+        explicit AppGeoData(AppGeoData const &data0, AppGeoData const &data1, double date);
+
+        double date;            ///< date at which data computed (TDB, Julian years)
+        double pmSpan;          ///< time over which to correct for proper motion (Julian years)
+        Eigen::Vector3d bcPos;  ///< barycentric position of Earth (au)
+        Eigen::Vector3d hcDir;  ///< heliocentric position of Earth (unit vector)
+        double gravRad;         ///< gravitational radius of sun * 2 / sun-earth distance
+        Eigen::Vector3d bcBeta; ///< barycentric velocity of the Earth (c)
+        double gammaI;          ///< sqrt(1 - bcBeta^2)
+        Eigen::Matrix3d pnMat;  ///< precession/nutation matrix
+
+    private:
+        void _setFromAmprms(double const *amprms);
+    };
+
+    /**
+    A cache of AppGeoData that may be shared by many AppGeoCoordSys (and thus by many threads)
+
+    The cache holds one AppGeoData snapshot, which is replaced (never modified) when a coordinate system
+    needs data for a date that the snapshot is too old to serve. Reading and replacing the snapshot
+    use boost's atomic shared pointer operations, so readers always see a consistent snapshot.
+    These are not lock-free: each one takes a short internal spinlock, held only while a shared pointer
+    is copied, so threads never wait while a snapshot is computed. An AppGeoCoordSys computes new snapshots
+    into a few buffers that it owns, reusing a buffer once nothing else refers to it,
+    so refreshing the cache does not allocate heap memory.
+
+    In AppGeoCacheMode_Interpolate mode the cache instead holds snapshots at two consecutive grid points
+    (dates that are a multiple of maxAge), and each coordinate system linearly interpolates between
+    the two grid points that surround its date. Positions then change continuously with date,
+    so the grid may be much coarser than the refresh interval of AppGeoCacheMode_Hold mode:
+    at a grid interval of one minute the interpolation error is below 1e-6 arcsec for stars,
+    and about 1e-3 arcsec for the Moon (due to the curvature of the Earth's barycentric path).
+
+    To share one cache between threads, give each thread its own coordinate system
+    (e.g. via clone, which shares the cache) rather than sharing one current coordinate system,
+    since setting the current date of a coordinate system is not thread-safe.
+    */
+    class AppGeoCache {
+    public:
+        typedef boost::shared_ptr<AppGeoCache> Ptr;
+
+        /**
+        Construct an empty AppGeoCache
+
+        @param[in] maxAge  maximum cache age (years) before setDate or setCurrDate will update the cache
+        @param[in] maxDDate  minimum delta date (date - current date) (years) before setDate or setCurrDate
+            will update the cache.
+            The intent is to never update the cache while computing velocity by computing position at two nearby times,
+            since updating the cache may introduce a small jump in position, which may result in unacceptable velocity error.
+            Thus this must be larger than your delta-T for computing velocity, but larger than the interval
+            between position updates.
+            Ignored in AppGeoCacheMode_Interpolate mode.
+        @param[in] mode  cache mode; in AppGeoCacheMode_Interpolate mode maxAge is the interval between grid points
+        @throw std::invalid_argument if mode is AppGeoCacheMode_Interpolate and maxAge is not finite and > 0
+        */
+        explicit AppGeoCache(double maxAge=0.05/(SecPerDay*DaysPerYear), double maxDDate=2*DeltaTForPos/(SecPerDay*DaysPerYear),
+            AppGeoCacheModeEnum mode=AppGeoCacheMode_Hold);
+
+        /**
+        Construct an empty AppGeoCache that computes new snapshots from a precomputed ephemeris
+
+        New snapshots are interpolated from the ephemeris, without calling SLALIB, if the ephemeris covers their date
+        (snapshots at other dates are computed as usual).
+
+        @param[in] ephemPtr  ephemeris of star-independent parameters; may be null
+        @param[in] maxAge  maximum cache age (years); see the other constructor
+        @param[in] maxDDate  minimum delta date (years); see the other constructor
+        @param[in] mode  cache mode; see the other constructor
+        @throw std::invalid_argument if mode is AppGeoCacheMode_Interpolate and maxAge is not finite and > 0
+        */
+        explicit AppGeoCache(boost::shared_ptr<const AppGeoEphemeris> const &ephemPtr,
+            double maxAge=0.05/(SecPerDay*DaysPerYear), double maxDDate=2*DeltaTForPos/(SecPerDay*DaysPerYear),
+            AppGeoCacheModeEnum mode=AppGeoCacheMode_Hold);
+        ~AppGeoCache() {};
+
+        /// return maximum cache age (years); the interval between grid points in AppGeoCacheMode_Interpolate mode
+        double getMaxAge() const { return _maxAge; };
+        /// return maximum delta date (years)
+        double getMaxDDate() const { return _maxDDate; };
+        /// return cache mode
+        AppGeoCacheModeEnum getMode() const { return _mode; };
+
+        /**
+        Return the current snapshot; null if none has been computed
+        */
+        AppGeoData::ConstPtr get() const;
+
+        /**
+        Return the current snapshot if it is young enough to use at the specified date, else a null pointer
+
+        @param[in] date  TDB date in Julian years
+        */
+        AppGeoData::ConstPtr get(double date) const;
+
+        /**
+        Replace the current snapshot
+
+        @param[in] dataPtr  new snapshot
+        @throw std::invalid_argument if dataPtr is null
+        */
+        void set(AppGeoData::ConstPtr const &dataPtr);
+
+        /**
+        Compute a new snapshot (without making it the current snapshot)
+
+        Interpolates the ephemeris, if there is one and it covers the date, else calls SLALIB.
+
+        @param[in] date  TDB date in Julian years
+        */
+        AppGeoData::ConstPtr compute(double date) const;
+
+        /**
+        Compute star-independent parameters in place (without making them the current snapshot)
+
+        Like compute(double), but fills in existing storage, so it never allocates heap memory.
+
+        @param[out] data  data to compute; must not be shared with anything that might read it
+        @param[in] date  TDB date in Julian years
+        */
+        void compute(AppGeoData &data, double date) const;
+
+        /**
+        Return the snapshot at a grid point (for AppGeoCacheMode_Interpolate mode),
+        computing it and making it current if necessary
+
+        The cache holds the two most recently used grid points (one with an even index, one with an odd index),
+        so a coordinate system moving steadily through time computes each grid point only once.
+
+        @param[in] gridInd  index of grid point, an integer; the date of the grid point is gridInd * getMaxAge()
+        */
+        AppGeoData::ConstPtr getGridData(double gridInd);
+
+        /**
+        Return the snapshot at a grid point, computing it into the supplied storage if necessary
+
+        Like getGridData(double), but never allocates heap memory.
+
+        @param[in] gridInd  index of grid point; see the other overload
+        @param[in,out] bufPtr  storage for the snapshot, if it must be computed; must not be shared
+            with anything that might read it, since it is computed in place (then it is shared by the cache)
+        */
+        AppGeoData::ConstPtr getGridData(double gridInd, boost::shared_ptr<AppGeoData> const &bufPtr);
+
+        /// return the ephemeris; null if none
+        boost::shared_ptr<const AppGeoEphemeris> getEphemeris() const { return _ephemPtr; };
+
+    private:
+        double _maxAge;     ///< maximum cache age (date - cached date) to reuse cache (years)
+        double _maxDDate;   ///< maximum date differential (date - current date) to reuse cache (years)
+        AppGeoCacheModeEnum _mode;  ///< cache mode
+        boost::shared_ptr<const AppGeoEphemeris> _ephemPtr; ///< ephemeris of star-independent parameters; may be null
+        AppGeoData::ConstPtr _dataPtr;  ///< current snapshot; only access using atomic operations
+        AppGeoData::ConstPtr _gridDataPtrArr[2];    ///< snapshots at grid points with even and odd index;
+                                                    ///< only access using atomic operations
+    };
+
     /**
     Apparent Geocentric RA, Dec coordinates; date is TDB date in Julian years
     
@@ -385,7 +888,6 @@ namespace coordConv {
     
     @warning:
     - Not fully accurate for solar system objects.
-    - This transformation requires iteration, so it will be somewhat slow.
 
     The following approximations have been used:
     - The annual aberration correction is not accurate for solar system objects.
@@ -407,39 +909,73 @@ namespace coordConv {
             between position updates.
         */
         explicit AppGeoCoordSys(double date=0, double maxAge=0.05/(SecPerDay*DaysPerYear), double maxDDate=2*DeltaTForPos/(SecPerDay*DaysPerYear));
+
+        /**
+        Construct an AppGeoCoordSys that uses a shared cache
+
+        @param[in] cachePtr  cache of star-independent data; may be shared with other AppGeoCoordSys
+        @param[in] date  TDB date in Julian years (but TT will always do)
+        @throw std::invalid_argument if cachePtr is null
+        */
+        explicit AppGeoCoordSys(AppGeoCache::Ptr const &cachePtr, double date=0);
         virtual ~AppGeoCoordSys() {};
         virtual CoordSys::Ptr clone() const;
         virtual CoordSys::Ptr clone(double date) const;
         virtual Coord fromFK5J2000(Coord const &coord, Site const &site) const;
         virtual Coord toFK5J2000(Coord const &coord, Site const &site) const;
+        virtual void fromFK5J2000(CoordArray &coordArr, CoordArray const &fk5J2000Arr, Site const &site) const;
+        virtual void toFK5J2000(CoordArray &fk5J2000Arr, CoordArray const &coordArr, Site const &site) const;
+        virtual Coord fromFK5J2000(Eigen::Matrix3d &jacobian, Eigen::Vector3d &posRate, Coord const &coord, Site const &site) const;
+        virtual Coord toFK5J2000(Eigen::Matrix3d &jacobian, Eigen::Vector3d &posRate, Coord const &coord, Site const &site) const;
         virtual double dateFromTAI(double tai) const { return julianEpochFromTAI(tai); };
         virtual double taiFromDate(double date) const { return taiFromJulianEpoch(date); };
         virtual std::string __repr__() const;
         
         /// return maximum cache age (years)
-        double getMaxAge() const { return _maxAge; };
+        double getMaxAge() const { return _cachePtr->getMaxAge(); };
         /// return maximum delta date (years)
-        double getMaxDDate() const { return _maxDDate; };
+        double getMaxDDate() const { return _cachePtr->getMaxDDate(); };
         /// return date of cache (TDB, Julian years); nan
-        double getCacheDate() const { return _cacheDate; };
+        double getCacheDate() const { return cacheOK() ? _dataPtr->date : std::numeric_limits<double>::quiet_NaN(); };
         /// return true if cache is valid
-        bool cacheOK() const { return std::isfinite(_cacheDate); };
+        bool cacheOK() const { return bool(_dataPtr); };
+        /**
+        Return the star-independent data snapshot in use; null if cache is not valid
+
+        In AppGeoCacheMode_Interpolate mode this is the snapshot at the grid point at or before the current date;
+        the data actually used are interpolated between it and the snapshot at the next grid point.
+        */
+        AppGeoData::ConstPtr getData() const { return _dataPtr; };
+        /// return the (possibly shared) cache
+        AppGeoCache::Ptr getCache() const { return _cachePtr; };
+
+        /// return ConvertStatus_DateTooLarge if date > 9999 (probably TAI, MJD seconds), else ConvertStatus_OK
+        virtual ConvertStatusEnum getDateStatus(double date) const;
+        /// return ConvertStatus_CacheNotValid if the cache is not valid, else ConvertStatus_OK
+        virtual ConvertStatusEnum getConvertStatus() const;
 
     protected:
         virtual void _setDate(double date) const;
 
     private:
-        double _maxAge;     ///< maximum cache age (date - cached date) to reuse cache (years)
-        double _maxDDate;   ///< maximum date differential (date - current date) to reuse cache (years)
-                            ///< 
-	    mutable double _cacheDate;         ///< date at which data computed (TDB, Julian years); 0 if never computed
-	    mutable double _pmSpan;             ///< time over which to correct for proper motion (Julian years)
-	    mutable Eigen::Vector3d _bcPos;     ///< barycentric position of Earth (au)
-	    mutable Eigen::Vector3d _hcDir;     ///< heliocentric position of Earth (unit vector)
-	    mutable double _gravRad;            ///< gravitational radius of sun * 2 / sun-earth distance
-	    mutable Eigen::Vector3d _bcBeta;    ///< barycentric velocity of the Earth (c)
-	    mutable double _gammaI;             ///< sqrt(1 - bcBeta^2)
-	    mutable Eigen::Matrix3d _pnMat;     ///< precession/nutation matrix
+        AppGeoCache::Ptr _cachePtr;             ///< cache of star-independent data; may be shared
+        mutable AppGeoData::ConstPtr _dataPtr;  ///< star-independent data in use; null if never computed
+        mutable AppGeoData::ConstPtr _nextDataPtr;  ///< snapshot at next grid point (AppGeoCacheMode_Interpolate only)
+        mutable AppGeoData _interpData;         ///< interpolated data (AppGeoCacheMode_Interpolate only)
+        mutable boost::shared_ptr<AppGeoData> _bufPtrArr[3];    ///< storage for snapshots this coordinate system
+                                                                ///< computes, so refreshing the cache need not allocate
+
+        /// return star-independent data in use; throw std::runtime_error if cache not valid
+        AppGeoData const &_getData() const;
+
+        /**
+        Return storage for a new snapshot: a buffer that nothing else refers to
+
+        A buffer is only reused once the cache and all coordinate systems have let go of it,
+        so snapshots are never modified while shared. Allocates a new buffer only if every buffer is still in use
+        (e.g. if other threads are still using snapshots computed by this coordinate system).
+        */
+        boost::shared_ptr<AppGeoData> const &_getFreeBuffer() const;
     };
 
     /**
@@ -453,13 +989,32 @@ namespace coordConv {
         @param[in] date  date as TAI (MJD, seconds)
         */
         explicit AppTopoCoordSys(double date=0);
+
+        /**
+        Construct an AppTopoCoordSys whose internal AppGeoCoordSys uses a shared cache
+
+        @param[in] appGeoCachePtr  cache of apparent geocentric data; may be shared with other coordinate systems
+        @param[in] date  date as TAI (MJD, seconds)
+        @throw std::invalid_argument if appGeoCachePtr is null
+        */
+        explicit AppTopoCoordSys(AppGeoCache::Ptr const &appGeoCachePtr, double date=0);
         virtual ~AppTopoCoordSys() {};
         virtual CoordSys::Ptr clone() const;
         virtual CoordSys::Ptr clone(double date) const;
         virtual Coord fromFK5J2000(Coord const &coord, Site const &site) const;
         virtual Coord toFK5J2000(Coord const &coord, Site const &site) const;
+        virtual void fromFK5J2000(CoordArray &coordArr, CoordArray const &fk5J2000Arr, Site const &site) const;
+        virtual void toFK5J2000(CoordArray &fk5J2000Arr, CoordArray const &coordArr, Site const &site) const;
+        virtual Coord fromFK5J2000(Eigen::Matrix3d &jacobian, Eigen::Vector3d &posRate, Coord const &coord, Site const &site) const;
+        virtual Coord toFK5J2000(Eigen::Matrix3d &jacobian, Eigen::Vector3d &posRate, Coord const &coord, Site const &site) const;
         virtual std::string __repr__() const;
 
+        /// return the cache of apparent geocentric data (which clones share)
+        AppGeoCache::Ptr getAppGeoCache() const { return _appGeoCoordSys.getCache(); };
+
+        virtual ConvertStatusEnum getDateStatus(double date) const;
+        virtual ConvertStatusEnum getConvertStatus() const;
+
     protected:
         virtual void _setDate(double date) const;
 
@@ -478,13 +1033,84 @@ namespace coordConv {
         @param[in] date  date as TAI (MJD, seconds)
         */
         explicit ObsCoordSys(double date=0);
+
+        /**
+        Construct an ObsCoordSys whose internal AppGeoCoordSys uses a shared cache
+
+        @param[in] appGeoCachePtr  cache of apparent geocentric data; may be shared with other coordinate systems
+        @param[in] date  date as TAI (MJD, seconds)
+        @throw std::invalid_argument if appGeoCachePtr is null
+        */
+        explicit ObsCoordSys(AppGeoCache::Ptr const &appGeoCachePtr, double date=0);
         virtual ~ObsCoordSys() {};
         virtual CoordSys::Ptr clone() const;
         virtual CoordSys::Ptr clone(double date) const;
         virtual Coord fromFK5J2000(Coord const &coord, Site const &site) const;
         virtual Coord toFK5J2000(Coord const &coord, Site const &site) const;
+        virtual void fromFK5J2000(CoordArray &coordArr, CoordArray const &fk5J2000Arr, Site const &site) const;
+        virtual void toFK5J2000(CoordArray &fk5J2000Arr, CoordArray const &coordArr, Site const &site) const;
+        virtual Coord fromFK5J2000(Eigen::Matrix3d &jacobian, Eigen::Vector3d &posRate, Coord const &coord, Site const &site) const;
+        virtual Coord toFK5J2000(Eigen::Matrix3d &jacobian, Eigen::Vector3d &posRate, Coord const &coord, Site const &site) const;
         virtual std::string __repr__() const;
 
+        /**
+        Convert a coordinate from another coordinate system to this system
+        for several sets of refraction coefficients, e.g. for several wavelengths
+
+        Intended for atmospheric dispersion correction: converts to apparent topocentric coordinates once,
+        then refracts once for each set of refraction coefficients (see the multiple refraction coefficient
+        version of obsFromAppTopo). This is much faster than calling convertFrom once for each set.
+
+        @param[out] obsArr  position in this coordinate system for each set of refraction coefficients;
+            resized as needed
+        @param[in] fromCoordSys  initial coordinate system and date
+        @param[in] fromCoord  initial position
+        @param[in] refCoArr  refraction coefficients: one row per set, with columns refCoA, refCoB (deg)
+        @param[in] site  site information; refCoA and refCoB are only used to remove refraction
+            if fromCoordSys is an ObsCoordSys
+        @param[in] tai  TAI date (MJD, sec); used as the date of this coordSys and fromCoordSys,
+           if either is current (ignored otherwise)
+        @param[in] refInd  index of the row of refCoArr at which dispersion is zero
+        @return dispersion: altitude of each observed position - altitude of observed position refInd (deg)
+        @throw std::invalid_argument if refCoArr does not have 2 columns and at least 1 row,
+            or refInd is not a valid row index
+        @throw std::runtime_error if the conversion fails (see CoordSys::convertFrom)
+        */
+        Eigen::VectorXd convertFromMultiRefCo(CoordArray &obsArr, CoordSys const &fromCoordSys, Coord const &fromCoord,
+            Eigen::MatrixXd const &refCoArr, Site const &site, double tai=0, int refInd=0) const;
+
+        /**
+        Convert a coordinate from another coordinate system to this system
+        for several sets of refraction coefficients, without throwing if the conversion fails
+
+        See convertFromMultiRefCo for details and CoordSys::tryConvertFrom for the status codes.
+        Like the CoordArray version of tryConvertFrom, this may allocate memory.
+
+        @param[out] dispersion  altitude of each observed position - altitude of observed position refInd (deg);
+            resized as needed; unchanged on failure
+        @param[out] obsArr  position in this coordinate system for each set of refraction coefficients;
+            resized as needed; unchanged on failure
+        @param[in] fromCoordSys  initial coordinate system and date
+        @param[in] fromCoord  initial position
+        @param[in] refCoArr  refraction coefficients: one row per set, with columns refCoA, refCoB (deg)
+        @param[in] site  site information
+        @param[in] tai  TAI date (MJD, sec); used as the date of this coordSys and fromCoordSys,
+           if either is current (ignored otherwise)
+        @param[in] refInd  index of the row of refCoArr at which dispersion is zero
+        @return ConvertStatus_OK on success, else the reason for failure; see trySetCurrDate and getConvertStatus
+        @throw std::invalid_argument if refCoArr does not have 2 columns and at least 1 row,
+            or refInd is not a valid row index (these are programming errors, so are not reported by status)
+        */
+        ConvertStatusEnum tryConvertFromMultiRefCo(Eigen::VectorXd &dispersion, CoordArray &obsArr,
+            CoordSys const &fromCoordSys, Coord const &fromCoord, Eigen::MatrixXd const &refCoArr, Site const &site,
+            double tai=0, int refInd=0) const;
+
+        /// return the cache of apparent geocentric data (which clones share)
+        AppGeoCache::Ptr getAppGeoCache() const { return _appTopoCoordSys.getAppGeoCache(); };
+
+        virtual ConvertStatusEnum getDateStatus(double date) const;
+        virtual ConvertStatusEnum getConvertStatus() const;
+
     protected:
         virtual void _setDate(double date) const;
 
@@ -524,6 +1150,10 @@ namespace coordConv {
         virtual Coord removePM(Coord const &coord, double tai) const { return coord; };
         virtual Coord fromFK5J2000(Coord const &coord, Site const &site) const;
         virtual Coord toFK5J2000(Coord const &coord, Site const &site) const;
+        virtual void fromFK5J2000(CoordArray &coordArr, CoordArray const &fk5J2000Arr, Site const &site) const;
+        virtual void toFK5J2000(CoordArray &fk5J2000Arr, CoordArray const &coordArr, Site const &site) const;
+        virtual Coord fromFK5J2000(Eigen::Matrix3d &jacobian, Eigen::Vector3d &posRate, Coord const &coord, Site const &site) const;
+        virtual Coord toFK5J2000(Eigen::Matrix3d &jacobian, Eigen::Vector3d &posRate, Coord const &coord, Site const &site) const;
         virtual std::string __repr__() const;
     };
     
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace coordConv {
+
+    /**
+    Return the time, in seconds, from a monotonic clock with an arbitrary zero point
+
+    Intended for measuring short intervals; the resolution is typically better than a microsecond.
+    */
+    double monotonicSec();
+
+    /**
+    Summary statistics of latency, as returned by LatencyHistogram::getStats
+
+    All times are in seconds; all are NaN if count = 0.
+    Percentiles are approximate: each is the upper edge of the histogram bin containing that percentile,
+    constrained to [min, max]; bins are 1/20 of a decade wide (about 12%).
+    */
+    class LatencyStats {
+    public:
+        long count;     ///< number of measurements
+        double min;     ///< minimum latency (sec)
+        double p50;     ///< median latency (sec)
+        double p99;     ///< 99th percentile latency (sec)
+        double max;     ///< maximum latency (sec)
+        double mean;    ///< mean latency (sec)
+
+        explicit LatencyStats();
+        ~LatencyStats() {};
+
+        /**
+        Return a string representation
+        */
+        std::string __repr__() const;
+    };
+
+    /**
+    A histogram of latency measurements with logarithmically spaced bins
+
+    Recording a measurement takes constant time and no memory allocation,
+    so a LatencyHistogram may be used inside a time-critical loop.
+    Bins are 1/20 of a decade wide and cover 10 nanoseconds to 10 seconds;
+    smaller and larger measurements are counted in the first and last bin, respectively.
+    */
+    class LatencyHistogram {
+    public:
+        explicit LatencyHistogram();
+        ~LatencyHistogram() {};
+
+        /**
+        Record one measurement
+
+        @param[in] latency  latency (sec)
+        */
+        void record(double latency);
+
+        /**
+        Discard all measurements
+        */
+        void reset();
+
+        /**
+        Return summary statistics
+        */
+        LatencyStats getStats() const;
+
+        /**
+        Return a string representation
+        */
+        std::string __repr__() const;
+
+    private:
+        std::vector<long> _binCounts;   ///< number of measurements in each bin
+        long _count;    ///< total number of measurements
+        double _min;    ///< minimum measurement (sec)
+        double _max;    ///< maximum measurement (sec)
+        double _sum;    ///< sum of all measurements (sec)
+
+        /// return the upper edge of the bin containing the specified fraction of measurements
+        double _getPercentile(double fraction) const;
+    };
+
+    std::ostream &operator<<(std::ostream &os, LatencyStats const &stats);
+
+    std::ostream &operator<<(std::ostream &os, LatencyHistogram const &hist);
+
+}
@@ -9,9 +9,72 @@ Define inline math utilities
 */
 namespace coordConv {
     
+    inline double hypot(double x, double y) {
+        double const sumSq = (x * x) + (y * y);
+        if ((sumSq >= DoubleMin) && (sumSq <= DoubleMax)) {
+            return std::sqrt(sumSq);
+        }
+        // the sum of squares overflowed, underflowed, is 0 or is NaN
+        double const absX = std::abs(x);
+        double const absY = std::abs(y);
+        if ((absX > DoubleMax) || (absY > DoubleMax)) {
+            return std::numeric_limits<double>::infinity();
+        }
+        if (std::isnan(x) || std::isnan(y)) {
+            return x + y;
+        }
+        double const maxAbs = absX > absY ? absX : absY;
+        double const minAbs = absX > absY ? absY : absX;
+        if (maxAbs == 0) {
+            return 0;
+        }
+        double const ratio = minAbs / maxAbs;
+        return maxAbs * std::sqrt(1.0 + (ratio * ratio));
+    }
+
+    inline void sincosd(double &sinAng, double &cosAng, double ang) {
+        if (!(std::abs(ang) <= 1.0e9)) {
+            if (!std::isfinite(ang)) {
+                sinAng = DoubleNaN;
+                cosAng = DoubleNaN;
+                return;
+            }
+            // fmod is exact; this keeps ang / 90 well within the range of an int
+            ang = std::fmod(ang, 360.0);
+        }
+        // reduce ang to redAng + (90 * quadrant), where |redAng| <= 45 (plus a bit, due to rounding in ang / 90);
+        // the subtraction is exact because ang and 90 * quadrant are within a factor of 2 of each other.
+        // Round ang / 90 to the nearest integer by adding and subtracting 1.5 * 2^52 (valid for |ang / 90| < 2^51,
+        // given IEEE double precision arithmetic, as on all x86_64 CPUs); this is faster than std::floor,
+        // and keeps a conversion to int off the path to std::sin and std::cos
+        double const RoundConst = 6755399441055744.0;
+        double const quadrant = ((ang * (1.0 / 90.0)) + RoundConst) - RoundConst;
+        double const redAngRad = (ang - (quadrant * 90.0)) * RadPerDeg;
+        double const sinRed = std::sin(redAngRad);
+        double const cosRed = std::cos(redAngRad);
+        switch (static_cast<int>(quadrant) & 3) {
+            case 0:
+                sinAng = sinRed;
+                cosAng = cosRed;
+                break;
+            case 1:
+                sinAng = cosRed;
+                cosAng = -sinRed;
+                break;
+            case 2:
+                sinAng = -sinRed;
+                cosAng = -cosRed;
+                break;
+            default:
+                sinAng = -cosRed;
+                cosAng = sinRed;
+                break;
+        }
+    }
+
     inline void rot2D(double &rotX, double &rotY, double x, double y, double ang) {
-        double sinAng = sind(ang);
-        double cosAng = cosd(ang);
+        double sinAng, cosAng;
+        sincosd(sinAng, cosAng, ang);
 
         rotX = cosAng * x - sinAng * y;
         rotY = sinAng * x + cosAng * y;
@@ -17,11 +17,15 @@ namespace coordConv {
 
     /**
     Hypotenuse function (also present in C++11, which I'm not using yet)
+
+    Computes sqrt(x^2 + y^2) directly unless that would overflow or underflow,
+    in which case the sides are scaled first. Returns infinity if either side is infinite,
+    else NaN if either side is NaN.
     
     @param[in] x, y: sides of right triangle
     @return hypotenuse of right triangle
     */
-    double hypot(double x, double y);
+    inline double hypot(double x, double y);
 
     /**
     Compute angle wrapped into range: 0 <= wrapped ang < 360 deg
@@ -57,6 +61,33 @@ namespace coordConv {
     /// tangent of angle in degrees
     inline double tand(double ang) { return std::tan(ang * RadPerDeg); }
 
+    /**
+    Compute sine and cosine of an angle in degrees
+
+    More accurate than calling sind and cosd: the angle is reduced (exactly) to the range [-45, 45] degrees
+    about the nearest multiple of 90 degrees before converting to radians, so the results are exact
+    at multiples of 90 degrees (e.g. cosine of 90 is 0 and sine of 180 is 0) and do not lose accuracy for large angles.
+    The reduction also saves time in std::sin and std::cos, so this is faster than sind and cosd
+    for angles beyond about 90 degrees, though slightly slower for small angles.
+
+    @param[out] sinAng  sine of ang
+    @param[out] cosAng  cosine of ang
+    @param[in] ang  angle (deg)
+    */
+    inline void sincosd(double &sinAng, double &cosAng, double ang);
+
+    /**
+    Array version of sincosd
+
+    Gives exactly the same results as calling the scalar version on each element
+    (Eigen does not vectorize sin and cos of doubles, so an Eigen array expression is no faster).
+
+    @param[out] sinArr  sine of each angle; resized as needed
+    @param[out] cosArr  cosine of each angle; resized as needed
+    @param[in] angArr  angles (deg)
+    */
+    void sincosd(Eigen::ArrayXd &sinArr, Eigen::ArrayXd &cosArr, Eigen::ArrayXd const &angArr);
+
     /// arcsine in degrees
     inline double asind(double x) { return std::asin(x) / RadPerDeg; }
 
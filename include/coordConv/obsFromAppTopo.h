@@ -3,6 +3,7 @@
 #include "Eigen/Dense"
 
 #include "coordConv/coord.h"
+#include "coordConv/coordArray.h"
 #include "coordConv/site.h"
 
 namespace coordConv {
@@ -11,7 +12,7 @@ namespace coordConv {
     Convert apparent topocentric coordinates to observed (refracted apparent topocentric)
 
     @param[in] appTopoCoord  apparent topocentric coord
-    @param[in] site  site information; refCoA and refCoB are read
+    @param[in] site  site information; refCoA, refCoB and refractionCachePtr are read
     @return position in observed coordinates
     */
     Coord obsFromAppTopo(
@@ -19,4 +20,56 @@ namespace coordConv {
         Site const &site
     );
 
+    /**
+    Array version of obsFromAppTopo; faster than converting one Coord at a time
+
+    @param[out] obsArr  observed positions;
+        resized as needed; may be the same object as appTopoArr
+    @param[in] appTopoArr  apparent topocentric positions
+    @param[in] site  site information; refCoA, refCoB and refractionCachePtr are read
+    */
+    void obsFromAppTopo(
+        CoordArray &obsArr,
+        CoordArray const &appTopoArr,
+        Site const &site
+    );
+
+    /**
+    Version of obsFromAppTopo for several sets of refraction coefficients, e.g. for several wavelengths
+
+    Intended for atmospheric dispersion correction. Refraction is computed by iteration,
+    even if site.refractionCachePtr is set (a RefractionCache holds a table for only one set of coefficients).
+
+    @param[out] obsArr  observed position for each set of refraction coefficients; resized as needed
+    @param[in] appTopoCoord  apparent topocentric coord
+    @param[in] refCoArr  refraction coefficients: one row per set, with columns refCoA, refCoB (deg)
+    @param[in] site  site information; refCoA and refCoB are ignored
+    @param[in] refInd  index of the row of refCoArr at which dispersion is zero
+    @return dispersion: altitude of each observed position - altitude of observed position refInd (deg).
+        Refraction only changes altitude, so this is the entire offset between observed positions.
+    @throw std::invalid_argument if refCoArr does not have 2 columns and at least 1 row,
+        or refInd is not a valid row index
+    */
+    Eigen::VectorXd obsFromAppTopo(
+        CoordArray &obsArr,
+        Coord const &appTopoCoord,
+        Eigen::MatrixXd const &refCoArr,
+        Site const &site,
+        int refInd=0
+    );
+
+    /**
+    Version of obsFromAppTopo that also computes the jacobian of the conversion
+
+    @param[out] jacobian  partial derivative of observed position with respect to apparent topocentric position
+    @param[in] appTopoCoord  apparent topocentric coord
+    @param[in] site  site information; refCoA, refCoB and refractionCachePtr are read
+    @return position in observed coordinates
+    */
+    Coord obsFromAppTopo(
+        Eigen::Matrix3d &jacobian,
+        Coord const &appTopoCoord,
+        Site const &site
+    );
+
 }
@@ -0,0 +1,121 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "boost/noncopyable.hpp"
+#include "boost/shared_ptr.hpp"
+#include "coordConv/site.h"
+#include "coordConv/coordArray.h"
+#include "coordConv/coordSys.h"
+#include "coordConv/conversionPlan.h"
+#include "coordConv/catalogConverter.h"
+
+namespace coordConv {
+
+    /**
+    Convert many positions from one coordinate system to another at a fixed TAI date, using multiple threads
+
+    The input is split into chunks of chunkSize positions. Each thread (worker) has its own
+    conversion state (a ConversionPlan and buffers, via a CatalogConverter), so workers share nothing
+    but the input and output. Each worker starts with an equal share of the chunks; a worker that runs out
+    steals half of the remaining chunks of another worker. This balances the load when the cost of conversion
+    varies across the input (e.g. low-altitude positions that take a different refraction branch,
+    or runs of positions with zero proper motion that take a faster path than those with proper motion).
+
+    Results match those of a ConversionPlan (or CatalogConverter) with the same arguments
+    to within round-off error, regardless of the number of threads.
+
+    Threads are started by each call to convert or convertFile and joined before it returns,
+    so each call should convert enough positions to be worth it (roughly 100 positions per thread or more).
+    A ParallelConverter may only be used by one thread at a time.
+    */
+    class ParallelConverter : private boost::noncopyable {
+    public:
+        /**
+        Construct a ParallelConverter
+
+        @param[in] fromCoordSys  initial coordinate system
+        @param[in] toCoordSys  final coordinate system
+        @param[in] site  site information
+        @param[in] tai  TAI date of conversion (MJD, sec); used for any coordinate system that is current
+        @param[in] numThreads  number of threads; if 0 then use the number of hardware threads
+        @param[in] chunkSize  number of positions in a chunk
+        @throw std::invalid_argument if numThreads < 0 or chunkSize < 1
+        */
+        explicit ParallelConverter(CoordSys const &fromCoordSys, CoordSys const &toCoordSys, Site const &site, double tai,
+            int numThreads=0, int chunkSize=1024);
+
+        ~ParallelConverter() {};
+
+        /**
+        Convert an array of coordinates
+
+        Equivalent to ConversionPlan(fromCoordSys, toCoordSys, site, tai).convert(toCoordArr, fromCoordArr)
+
+        @param[out] toCoordArr  positions in final coordinate system;
+            resized as needed; may be the same object as fromCoordArr
+        @param[in] fromCoordArr  positions in initial coordinate system
+        @throw std::runtime_error if conversion fails
+        */
+        void convert(CoordArray &toCoordArr, CoordArray const &fromCoordArr);
+
+        /**
+        Convert catalog records in memory
+
+        @param[out] toRecords  converted records; there must be room for numRecords records;
+            may be the same as fromRecords
+        @param[in] fromRecords  records to convert
+        @param[in] numRecords  number of records
+        @throw std::runtime_error if a polar angle is not in range [-90, 90]
+        */
+        void convert(CatalogRecord *toRecords, CatalogRecord const *fromRecords, std::size_t numRecords);
+
+        /**
+        Convert a catalog file to another catalog file (see CatalogConverter::convertFile)
+
+        @param[in] toPath  path of output catalog; created or overwritten
+        @param[in] fromPath  path of input catalog; must not be the same file as toPath
+        @return number of records converted
+        @throw std::runtime_error if a file cannot be read or written,
+            if the size of the input catalog is not a multiple of sizeof(CatalogRecord),
+            or if a polar angle is not in range [-90, 90]
+        */
+        std::size_t convertFile(std::string const &toPath, std::string const &fromPath);
+
+        /// return the conversion plan (that of the first worker; all workers have an equivalent plan)
+        ConversionPlan const &getPlan() const { return _catalogConverterList[0]->getPlan(); };
+
+        /// return the number of threads
+        int getNumThreads() const { return _numThreads; };
+
+        /// return the number of positions in a chunk
+        int getChunkSize() const { return _chunkSize; };
+
+        /**
+        Return a string representation
+        */
+        std::string __repr__() const;
+
+    private:
+        int _numThreads;    ///< number of threads
+        int _chunkSize;     ///< number of positions in a chunk
+        std::vector<boost::shared_ptr<CatalogConverter> > _catalogConverterList;    ///< conversion state for each worker
+        std::vector<CoordArray> _fromArrList;   ///< buffer of unconverted positions for each worker
+        std::vector<CoordArray> _toArrList;     ///< buffer of converted positions for each worker
+
+        /**
+        Convert one chunk of a CoordArray (called by a worker)
+        */
+        void _convertArrayChunk(int workerInd, std::size_t chunkInd, CoordArray *toCoordArr, CoordArray const *fromCoordArr);
+
+        /**
+        Convert one chunk of catalog records (called by a worker)
+        */
+        void _convertRecordChunk(int workerInd, std::size_t chunkInd,
+            CatalogRecord *toRecords, CatalogRecord const *fromRecords, std::size_t numRecords);
+    };
+
+    std::ostream &operator<<(std::ostream &os, ParallelConverter const &parallelConverter);
+
+}
@@ -163,6 +163,19 @@ namespace coordConv {
         */
         PVTCoord offset(PVT &toOrient, PVT const &fromOrient, PVT const &dist) const;
 
+        /**
+        Offset a PVTCoord by a specified distance in a specified direction, without throwing
+
+        The same as offset, but reports failure with a status code, for use by real-time code.
+
+        @param[out] toPVTCoord  offset PVT coord; a null PVTCoord on failure; may be this PVTCoord
+        @param[out] toOrient  orientation of offset arc at offset position (deg); invalid on failure
+        @param[in] fromOrient  orientation of offset arc at this position (deg)
+        @param[in] dist  offset distance as the length of the arc of a great circle (deg)
+        @return ConvertStatus_OK, or ConvertStatus_AtPole if this PVTCoord is too near a pole to be offset
+        */
+        ConvertStatusEnum tryOffset(PVTCoord &toPVTCoord, PVT &toOrient, PVT const &fromOrient, PVT const &dist) const;
+
         bool operator==(PVTCoord const &rhs) {
             return (this->getCoord()  == rhs.getCoord())
                 && (this->getVel()    == rhs.getVel())
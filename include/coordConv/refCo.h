@@ -0,0 +1,145 @@
+#pragma once
+
+#include <cstddef>
+#include <utility>
+#include "boost/noncopyable.hpp"
+#include "boost/shared_ptr.hpp"
+#include "boost/thread/mutex.hpp"
+#include "boost/unordered_map.hpp"
+
+namespace coordConv {
+
+    class Site;
+
+    /// default tropospheric lapse rate (K/m)
+    const double DefaultLapseRate = 0.0065;
+
+    /**
+    Compute refraction coefficients from weather (calls slaRefco, which integrates through a model atmosphere)
+
+    The coefficients are for the model used by obsFromAppTopo and appTopoFromObs;
+    see Site.refCoA and Site.refCoB for details.
+
+    @param[out] refCoA  A refraction coefficient (deg)
+    @param[out] refCoB  B refraction coefficient (deg)
+    @param[in] site  site information; elev and corrLat are read
+    @param[in] pressure  ambient air pressure at the observatory (mbar)
+    @param[in] temp  ambient air temperature at the observatory (C)
+    @param[in] relHumidity  relative humidity at the observatory (0-1)
+    @param[in] wavelen  effective wavelength of the source (Angstroms)
+    @param[in] lapseRate  tropospheric lapse rate (K/m)
+    @throw std::invalid_argument if an input is not finite, pressure < 0, temp <= absolute zero,
+        relHumidity is not in range [0, 1] or wavelen <= 0
+    */
+    void refCoFromWeather(
+        double &refCoA,
+        double &refCoB,
+        Site const &site,
+        double pressure,
+        double temp,
+        double relHumidity,
+        double wavelen,
+        double lapseRate=DefaultLapseRate
+    );
+
+    /**
+    A cache of refraction coefficients computed from weather, keyed on quantized weather
+
+    Computing refraction coefficients (refCoFromWeather) is slow, yet weather stations report often
+    and the weather usually barely changes between reports. RefCoCache rounds each weather input
+    to a multiple of a specified resolution, and computes the coefficients at the rounded weather
+    only the first time it sees that rounded weather. Thus the coefficients are a function of the rounded weather,
+    so weather that rounds the same way gives identical coefficients (and a RefractionCache need not rebuild its table).
+    The default resolutions change refCoA by no more than roughly 2e-3 arcsec.
+
+    To use, set Site.refCoCachePtr; then Site.setRefCoFromWeather will use the cache.
+
+    A cache may be shared between threads (and Site objects). The cache holds at most maxSize entries;
+    it is emptied if it is full when a new entry is needed.
+    */
+    class RefCoCache : private boost::noncopyable {
+    public:
+        typedef boost::shared_ptr<RefCoCache> Ptr;
+
+        /**
+        Construct a RefCoCache
+
+        @param[in] pressureRes  resolution of pressure (mbar)
+        @param[in] tempRes  resolution of temperature (C)
+        @param[in] relHumidityRes  resolution of relative humidity (0-1)
+        @param[in] wavelenRes  resolution of wavelength (Angstroms)
+        @param[in] lapseRateRes  resolution of lapse rate (K/m)
+        @param[in] maxSize  maximum number of entries
+        @throw std::invalid_argument if any resolution is not finite and > 0, or maxSize < 1
+        */
+        explicit RefCoCache(
+            double pressureRes=0.01,
+            double tempRes=0.01,
+            double relHumidityRes=0.001,
+            double wavelenRes=1.0,
+            double lapseRateRes=1.0e-5,
+            int maxSize=1000
+        );
+        ~RefCoCache() {};
+
+        /**
+        Return refraction coefficients computed from weather rounded to the resolutions of the cache
+
+        Arguments are as for refCoFromWeather.
+
+        @return the wavelength for which the coefficients were computed: wavelen rounded to wavelenRes (Angstroms)
+        @throw std::invalid_argument if the rounded weather is invalid (see refCoFromWeather)
+        */
+        double getRefCo(
+            double &refCoA,
+            double &refCoB,
+            Site const &site,
+            double pressure,
+            double temp,
+            double relHumidity,
+            double wavelen,
+            double lapseRate=DefaultLapseRate
+        ) const;
+
+        /// return the number of entries
+        int size() const;
+
+        /// remove all entries
+        void clear();
+
+        /// return the maximum number of entries
+        int getMaxSize() const { return _maxSize; }
+
+    private:
+        /*
+        Rounded weather and the site information used by refCoFromWeather
+        */
+        struct Key {
+            long pressure;      ///< pressure / pressureRes, rounded
+            long temp;          ///< temp / tempRes, rounded
+            long relHumidity;   ///< relHumidity / relHumidityRes, rounded
+            long wavelen;       ///< wavelen / wavelenRes, rounded
+            long lapseRate;     ///< lapseRate / lapseRateRes, rounded
+            double elev;        ///< site elevation (m)
+            double corrLat;     ///< site latitude corrected for pole wander (deg)
+
+            bool operator==(Key const &rhs) const;
+        };
+
+        struct KeyHash {
+            std::size_t operator()(Key const &key) const;
+        };
+
+        typedef boost::unordered_map<Key, std::pair<double, double>, KeyHash> RefCoMap;
+
+        double _pressureRes;
+        double _tempRes;
+        double _relHumidityRes;
+        double _wavelenRes;
+        double _lapseRateRes;
+        int _maxSize;
+        mutable boost::mutex _mutex;    ///< protects _refCoMap
+        mutable RefCoMap _refCoMap;     ///< map of key: (refCoA, refCoB)
+    };
+
+}
@@ -0,0 +1,172 @@
+#pragma once
+
+#include <vector>
+#include "boost/shared_ptr.hpp"
+#include "coordConv/physConst.h"
+
+namespace coordConv {
+
+    class Site;
+
+    /// default number of grid intervals in each direction of a RefractionTable
+    const int RefractionTableSize = 1700;
+
+    /**
+    Maximum unrefracted zenith distance at which refraction is computed (deg)
+
+    For zdu > ZDu_Max the correction is computed at ZDu_Max.
+    This is unphysical, but allows working with arbitrary positions.
+    The model used (at this writing) is not much good beyond 83 degrees
+    and going beyond ~87 requires more iterations to give reversibility.
+    */
+    const double ZDu_Max = 85.0;
+
+    /**
+    A table of refraction corrections as a function of zenith distance, computed for one pair of refraction coefficients
+
+    Refraction is modelled as in obsFromAppTopo and appTopoFromObs:
+        zdu = zdr + (refCoA * tan(zdr)) + (refCoB * tan^3(zdr))
+    where zdu is unrefracted (apparent topocentric) zenith distance and zdr is refracted (observed) zenith distance.
+    Computing zdr from zdu requires iteration; the table avoids that, and also avoids computing tan(zdr).
+    For zdu > ZDu_Max = 85 degrees the correction is held constant at its value at ZDu_Max, as in
+    obsFromAppTopo and appTopoFromObs, so that refracting then unrefracting returns the original position.
+
+    Each direction is tabulated on its own uniform grid, whose last point is where zdu = ZDu_Max,
+    and each interval is a cubic Hermite polynomial matching the exact correction and its derivative at both ends.
+    The interpolation error is largest at ZDu_Max (where the correction changes fastest); with the default
+    number of grid intervals and typical coefficients (refCoA = 1.2e-2, refCoB = -1.3e-5 deg) it is below 3e-7 arcsec,
+    and it scales as (1/numIntervals)^4. A table holds 8 * (numIntervals + 1) doubles (109 kB by default).
+
+    Once constructed, RefractionTable is only handled through ConstPtr (a pointer to const),
+    so it may be shared between threads.
+    */
+    class RefractionTable {
+    public:
+        typedef boost::shared_ptr<const RefractionTable> ConstPtr;
+
+        double refCoA;  ///< A refraction coefficient (deg); see Site.refCoA
+        double refCoB;  ///< B refraction coefficient (deg); see Site.refCoB
+
+        /**
+        Compute a refraction table
+
+        @param[in] refCoA  A refraction coefficient (deg)
+        @param[in] refCoB  B refraction coefficient (deg)
+        @param[in] numIntervals  number of grid intervals in each direction
+        @throw std::invalid_argument if numIntervals < 1
+        @throw std::runtime_error if the refraction model does not converge at ZDu_Max
+            (which requires absurd refraction coefficients)
+        */
+        explicit RefractionTable(double refCoA, double refCoB, int numIntervals=RefractionTableSize);
+        ~RefractionTable() {};
+
+        /**
+        Compute refracted - unrefracted zenith distance, given unrefracted zenith distance
+
+        @param[in] zdu  unrefracted (apparent topocentric) zenith distance (deg); must be >= 0
+        @return zdr - zdu (deg); normally negative
+        */
+        double zdrMinusZDu(double zdu) const {
+            return _interpolate(_obsCoeffs, _obsScale, zdu);
+        }
+
+        /**
+        Compute unrefracted - refracted zenith distance, given refracted zenith distance
+
+        @param[in] zdr  refracted (observed) zenith distance (deg); must be >= 0
+        @return zdu - zdr (deg); normally positive
+        */
+        double zduMinusZDr(double zdr) const {
+            return _interpolate(_appTopoCoeffs, _appTopoScale, zdr);
+        }
+
+        /// return the number of grid intervals in each direction
+        int getNumIntervals() const { return _numIntervals; }
+
+    private:
+        int _numIntervals;
+        double _obsScale;       ///< number of grid intervals per degree of zdu
+        double _appTopoScale;   ///< number of grid intervals per degree of zdr
+        // polynomial coefficients of each interval: 4 per interval, constant term first,
+        // as a function of the fractional position within the interval;
+        // the last interval is constant (the correction beyond ZDu_Max)
+        std::vector<double> _obsCoeffs;     ///< coefficients of zdr - zdu as a function of zdu
+        std::vector<double> _appTopoCoeffs; ///< coefficients of zdu - zdr as a function of zdr
+
+        double _interpolate(std::vector<double> const &coeffs, double scale, double zd) const {
+            double const gridPos = zd * scale;
+            int const ind = gridPos < _numIntervals ? static_cast<int>(gridPos) : _numIntervals;
+            double const frac = gridPos - ind;
+            double const *c = &coeffs[4 * ind];
+            return c[0] + (frac * (c[1] + (frac * (c[2] + (frac * c[3])))));
+        }
+    };
+
+    /**
+    A cache of a refraction table, for computing refraction quickly
+
+    To use, set Site.refractionCachePtr; then obsFromAppTopo and appTopoFromObs (and thus all conversions
+    to and from observed coordinates) will use the cache. The cached table is rebuilt whenever it is asked for
+    a table with different refraction coefficients (building a table with the default size takes roughly 0.4 ms),
+    so the cache is only useful if the refraction coefficients change much less often than positions are converted.
+
+    A cache may be shared between threads (and Site objects); the table is an immutable snapshot
+    that is replaced atomically when the cache is refreshed. Reading or replacing the table takes
+    a short internal spinlock (boost's atomic shared pointer operations are not lock-free).
+    */
+    class RefractionCache {
+    public:
+        typedef boost::shared_ptr<RefractionCache> Ptr;
+
+        /**
+        Construct a RefractionCache
+
+        @param[in] numIntervals  number of grid intervals in each direction of each table
+        @throw std::invalid_argument if numIntervals < 1
+        */
+        explicit RefractionCache(int numIntervals=RefractionTableSize);
+        ~RefractionCache() {};
+
+        /**
+        Return a refraction table for the specified refraction coefficients; refresh the cache if necessary
+
+        @param[in] refCoA  A refraction coefficient (deg)
+        @param[in] refCoB  B refraction coefficient (deg)
+        */
+        RefractionTable::ConstPtr getTable(double refCoA, double refCoB) const;
+
+        /// return the number of grid intervals in each direction of each table
+        int getNumIntervals() const { return _numIntervals; }
+
+        /// return the current table; null if none has been computed
+        RefractionTable::ConstPtr getTable() const;
+
+    private:
+        int _numIntervals;  ///< number of grid intervals in each direction of each table
+        mutable RefractionTable::ConstPtr _tablePtr;    ///< current table; only access using atomic operations
+    };
+
+    /**
+    Return the refraction table to use for a site, or null if refraction is to be computed without a table
+
+    @param[in] site  site information; refractionCachePtr, refCoA and refCoB are read
+    */
+    RefractionTable::ConstPtr getRefractionTable(Site const &site);
+
+    /**
+    Compute z of a position rotated towards or away from the zenith by a small angle,
+    without calling trigonometric functions
+
+    @param[in] rxymag  sqrt(x^2 + y^2) of the position (unchanged by the rotation)
+    @param[in] z  z of the position
+    @param[in] dzd  increase in zenith distance (deg); small enough that tan(dzd) is well fit by a 5th order series
+    */
+    inline double zFromZDChange(double rxymag, double z, double dzd) {
+        // cot(zd + dzd) = (cot(zd) - tan(dzd)) / (1 + cot(zd) tan(dzd)), where cot(zd) = z / rxymag
+        double const dzdRad = dzd * RadPerDeg;
+        double const dzdRadSq = dzdRad * dzdRad;
+        double const tanDZD = dzdRad * (1.0 + (dzdRadSq * ((1.0 / 3.0) + (dzdRadSq * (2.0 / 15.0)))));
+        return rxymag * (z - (rxymag * tanDZD)) / (rxymag + (z * tanDZD));
+    }
+
+}
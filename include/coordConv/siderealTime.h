@@ -0,0 +1,90 @@
+#pragma once
+
+#include "boost/shared_ptr.hpp"
+
+namespace coordConv {
+
+    class Site;
+
+    /**
+    Sidereal time data computed at one date, from which local apparent sidereal time may be extrapolated
+
+    Greenwich mean sidereal time (GMST) is very nearly a linear function of UT1 and the equation
+    of the equinoxes (apparent - mean sidereal time) is a slowly varying function of TT, so both are
+    represented by a value and a rate of change.
+
+    Once constructed, SiderealTimeData is only handled through ConstPtr (a pointer to const),
+    so it may be shared between threads.
+    */
+    class SiderealTimeData {
+    public:
+        typedef boost::shared_ptr<const SiderealTimeData> ConstPtr;
+
+        double ut1;             ///< UT1 date at which GMST was computed (MJD, seconds)
+        double tt;              ///< TT date at which the equation of the equinoxes was computed (MJD, seconds)
+        double gmst;            ///< Greenwich mean sidereal time at ut1 (deg)
+        double gmstRate;        ///< rate of change of GMST (deg/second of UT1)
+        double eqEquinox;       ///< equation of the equinoxes at tt (deg)
+        double eqEquinoxRate;   ///< rate of change of the equation of the equinoxes (deg/second of TT)
+
+        /**
+        Compute sidereal time data (calls slaGmst and slaEqeqx)
+
+        @param[in] ut1  UT1 date (MJD, seconds)
+        @param[in] tt  TT date (MJD, seconds)
+        */
+        explicit SiderealTimeData(double ut1, double tt);
+        ~SiderealTimeData() {};
+    };
+
+    /**
+    A cache of sidereal time data, for computing local apparent sidereal time (LAST) quickly
+
+    To use, set Site.lastCachePtr; then lastFromTAI (and thus all conversions to and from
+    apparent topocentric coordinates) will use the cache.
+
+    The cache is refreshed (by computing a new SiderealTimeData) when asked for LAST
+    at a TT date more than maxAge away from the date of the cached data. Between refreshes, LAST is
+    extrapolated linearly. The error in GMST is negligible (below 1e-9 arcsec for a day).
+    The error in the equation of the equinoxes is dominated by the 13.7 day nutation term
+    and is less than 0.035 arcsec * (maxAge / 1 day)^2, which is 2e-6 arcsec for the default maxAge of 600 seconds.
+    That is smaller than the round-off error in GMST computed by slaGmst (roughly 1e-5 arcsec for current dates).
+
+    A cache may be shared between threads (and Site objects); the data is an immutable snapshot
+    that is replaced atomically when the cache is refreshed. Reading or replacing the snapshot takes
+    a short internal spinlock (boost's atomic shared pointer operations are not lock-free).
+    */
+    class SiderealTimeCache {
+    public:
+        typedef boost::shared_ptr<SiderealTimeCache> Ptr;
+
+        /**
+        Construct a SiderealTimeCache
+
+        @param[in] maxAge  maximum |TT date - TT date of cached data| before the cache is refreshed (sec)
+        @throw std::invalid_argument if maxAge is negative
+        */
+        explicit SiderealTimeCache(double maxAge=600.0);
+        ~SiderealTimeCache() {};
+
+        /**
+        Return local apparent sidereal time; refresh the cache if necessary
+
+        @param[in] tai  TAI date (MJD, seconds)
+        @param[in] site  site information; ut1_tai and corrLong are read
+        @return local apparent sidereal time (deg), in range [0, 360)
+        */
+        double getLAST(double tai, Site const &site) const;
+
+        /// return maximum |TT date - TT date of cached data| before the cache is refreshed (sec)
+        double getMaxAge() const { return _maxAge; };
+
+        /// return the current snapshot; null if none has been computed
+        SiderealTimeData::ConstPtr getData() const;
+
+    private:
+        double _maxAge;     ///< maximum |TT date - TT date of cached data| before the cache is refreshed (sec)
+        mutable SiderealTimeData::ConstPtr _dataPtr;    ///< current snapshot; only access using atomic operations
+    };
+
+}
@@ -1,6 +1,9 @@
 #pragma once
 
 #include "Eigen/Dense"
+#include "coordConv/siderealTime.h"
+#include "coordConv/refractionTable.h"
+#include "coordConv/refCo.h"
 
 namespace coordConv {
 
@@ -29,6 +32,15 @@ namespace coordConv {
         double diurAbMag;   ///< magnitude of diurnal aberration vector:
             /// speed of rotation of observatory / speed of light (radians/au)
         Eigen::Vector3d pos;    ///< cartesian position of observatory (au)
+        SiderealTimeCache::Ptr lastCachePtr;    ///< cache used by lastFromTAI to compute local apparent sidereal time
+            ///< quickly, at some cost in accuracy (see SiderealTimeCache); if null (the default) then lastFromTAI
+            ///< computes sidereal time exactly. Copies of a Site share the cache.
+        RefractionCache::Ptr refractionCachePtr;    ///< cache used by obsFromAppTopo and appTopoFromObs to compute
+            ///< refraction quickly, at some cost in accuracy (see RefractionTable); if null (the default) then
+            ///< refraction is computed by iteration. Copies of a Site share the cache.
+        RefCoCache::Ptr refCoCachePtr;  ///< cache used by setRefCoFromWeather to compute refraction coefficients
+            ///< quickly, at some cost in accuracy (see RefCoCache); if null (the default) then setRefCoFromWeather
+            ///< computes the coefficients exactly. Copies of a Site share the cache.
         
         /**
         Construct a new Site.
@@ -59,6 +71,31 @@ namespace coordConv {
         - pos
         */
         void setPoleWander(double x, double y);
+
+        /**
+        Set refraction coefficients from weather
+
+        Computes the coefficients using refCoCachePtr, if set, else by calling refCoFromWeather.
+        This is the one place to set refraction coefficients for new weather: if refractionCachePtr is set,
+        its refraction table is rebuilt (the next time it is used) if and only if the coefficients change.
+
+        @param[in] pressure  ambient air pressure at the observatory (mbar)
+        @param[in] temp  ambient air temperature at the observatory (C)
+        @param[in] relHumidity  relative humidity at the observatory (0-1)
+        @param[in] wavelen  effective wavelength of the source (Angstroms)
+        @param[in] lapseRate  tropospheric lapse rate (K/m)
+
+        Updates the following fields:
+        - wavelen: the wavelength for which the coefficients were computed;
+            if refCoCachePtr is set this is wavelen rounded to the cache's wavelength resolution
+        - refCoA
+        - refCoB
+
+        @throw std::invalid_argument if the weather is invalid (see refCoFromWeather),
+            in which case no fields are changed
+        */
+        void setRefCoFromWeather(double pressure, double temp, double relHumidity, double wavelen,
+            double lapseRate=DefaultLapseRate);
         
         /**
         Print a string representation
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "Eigen/Dense"
+#include "coordConv/site.h"
+#include "coordConv/coordSys.h"
+
+namespace coordConv {
+
+    /**
+    Convert an array of spherical coordinates from one coordinate system to another
+
+    Intended for callers (especially Python callers, via numpy arrays) that have positions
+    as arrays of spherical coordinates rather than as Coords. Each row of the input and output arrays
+    holds one position as: equatAng, polarAng, parallax, equatPM, polarPM, radVel,
+    with the same units as Coord(equatAng, polarAng, parallax, equatPM, polarPM, radVel);
+    thus each converted row matches the result of:
+    @code
+    toCoord = toCoordSys.convertFrom(fromCoordSys, Coord(...), site, tai)
+    @endcode
+    (with the output fields computed as by CatalogConverter).
+
+    @param[in] fromCoordSys  initial coordinate system
+    @param[in] toCoordSys  final coordinate system
+    @param[in] fromSphArr  N x 6 array of initial positions
+    @param[in] site  site information
+    @param[in] tai  TAI date of conversion (MJD, sec); used for any coordinate system that is current
+    @param[in] numThreads  number of threads (see ParallelConverter); if 0 then use the number of hardware threads
+    @return N x 6 array of converted positions
+
+    @throw std::invalid_argument if fromSphArr does not have 6 columns or numThreads < 0
+    @throw std::runtime_error if a polar angle is not in range [-90, 90]
+    */
+    Eigen::MatrixXd convertSphArray(CoordSys const &fromCoordSys, CoordSys const &toCoordSys,
+        Eigen::MatrixXd const &fromSphArr, Site const &site, double tai, int numThreads=1);
+
+    /**
+    Convert an array of spherical coordinates from one coordinate system to another, including orientation
+
+    As convertSphArray, but also convert an orientation for each position, as the orientation version
+    of CoordSys::convertFrom does.
+
+    @param[in] fromCoordSys  initial coordinate system
+    @param[in] toCoordSys  final coordinate system
+    @param[in] fromSphArr  N x 6 array of initial positions (see convertSphArray)
+    @param[in] fromDirArr  N initial orientations (deg; 0 along increasing equatorial angle, 90 along increasing polar angle)
+    @param[in] site  site information
+    @param[in] tai  TAI date of conversion (MJD, sec); used for any coordinate system that is current
+    @param[in] orientMethod  how to compute orientation and scale change (see CoordSys::convertFrom)
+    @return N x 8 array: each row holds the six fields of the converted position (see convertSphArray),
+        followed by toDir (deg) and scaleChange
+
+    @throw std::invalid_argument if fromSphArr does not have 6 columns,
+        or fromDirArr does not have one element per row of fromSphArr
+    @throw std::runtime_error if a polar angle is not in range [-90, 90] or a position is at a pole
+    */
+    Eigen::MatrixXd convertSphDirArray(CoordSys const &fromCoordSys, CoordSys const &toCoordSys,
+        Eigen::MatrixXd const &fromSphArr, Eigen::VectorXd const &fromDirArr, Site const &site, double tai,
+        OrientationMethodEnum orientMethod=OrientationMethod_Analytic);
+
+}
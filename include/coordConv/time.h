@@ -9,8 +9,11 @@ namespace coordConv {
     
     @param[in] tai  universal time (MJD, seconds)
     @param[in] site  site information (a coordConv::Site)
-        read fields: ut1_tai, longitude
+        read fields: ut1_tai, longitude, lastCachePtr
     @return Local mean sidereal time, in degrees, in range [0, 360)
+
+    If site.lastCachePtr is not null then sidereal time is extrapolated from cached data,
+    which is much faster, but slightly less accurate; see SiderealTimeCache.
     */
     double lastFromTAI(double tai, Site const &site);
     
@@ -0,0 +1,143 @@
+#pragma once
+
+#include <string>
+#include "coordConv/site.h"
+#include "coordConv/coord.h"
+#include "coordConv/coordSys.h"
+#include "coordConv/latencyHistogram.h"
+
+namespace coordConv {
+
+    enum TrackerStageEnum {
+        TrackerStage_Prepare,   ///< Tracker.prepare
+        TrackerStage_AppGeo,    ///< convert from the initial coordinate system to apparent geocentric
+        TrackerStage_AppTopo,   ///< convert from apparent geocentric to apparent topocentric
+        TrackerStage_Obs,       ///< convert from apparent topocentric to observed (not recorded for apptopo)
+        TrackerStage_Convert,   ///< all of Tracker.convert
+        TrackerStage_NumStages  ///< number of stages (not a stage)
+    };
+
+    /**
+    Convert mean coordinates to apparent topocentric or observed coordinates with bounded latency
+
+    Intended for a telescope control loop. The expensive computations performed by
+    AppGeoCoordSys (slaMappa, when its cache is stale) and lastFromTAI (slaGmst and slaEqeqx)
+    are only performed by prepare, which the caller can schedule when convenient.
+    convert then uses the prepared data, which takes a short and nearly constant time.
+
+    prepare(taiAhead) computes the apparent geocentric data at taiAhead, plus local apparent
+    sidereal time (LAST) at taiAhead, which convert extrapolates at the sidereal rate.
+    The result is valid for TAI dates within maxDTAI of taiAhead. Compared to
+    ObsCoordSys.convertFrom, the additional error is of order 1e-5 arcsec per second of |tai - taiAhead|,
+    mostly due to the apparent geocentric data being stale (see tests/checkAppGeoTime.py);
+    the error in extrapolated LAST is far smaller.
+
+    Each stage of conversion is timed, and the latencies are accumulated in histograms (see getStats).
+
+    A Tracker is not thread-safe: each thread must use its own Tracker.
+    */
+    class Tracker {
+    public:
+        /**
+        Construct a Tracker
+
+        @param[in] fromCoordSys  initial coordinate system; must be mean (e.g. ICRS or FK5)
+        @param[in] toCoordSys  final coordinate system; must be apptopo or obs, and current
+            (conversions are performed at the tai passed to convert, not at a fixed date)
+        @param[in] site  site information
+        @param[in] maxDTAI  maximum |tai - taiAhead| for which prepared data may be used (sec)
+        @throw std::invalid_argument if fromCoordSys is not mean, toCoordSys is not apptopo or obs,
+            toCoordSys is not current, or maxDTAI is not positive
+        */
+        explicit Tracker(CoordSys const &fromCoordSys, CoordSys const &toCoordSys, Site const &site, double maxDTAI=10.0);
+
+        ~Tracker() {};
+
+        /**
+        Prepare to convert coordinates at TAI dates near taiAhead
+
+        This performs all computations whose cost depends on cache state,
+        and its duration is recorded as stage TrackerStage_Prepare.
+
+        @param[in] taiAhead  TAI date (MJD, sec) of upcoming conversions
+        */
+        void prepare(double taiAhead);
+
+        /**
+        Return true if prepare has been called for a TAI date within maxDTAI of tai
+        (and setSite has not been called since)
+
+        @param[in] tai  TAI date (MJD, sec)
+        */
+        bool isPrepared(double tai) const;
+
+        /**
+        Convert a coordinate using the prepared data
+
+        Equivalent to toCoordSys.convertFrom(fromCoordSys, fromCoord, site, tai),
+        to within the accuracy described in the class documentation.
+
+        @param[in] fromCoord  position in initial coordinate system
+        @param[in] tai  TAI date (MJD, sec) of conversion
+        @return position in final coordinate system
+        @throw std::runtime_error if isPrepared(tai) is false
+        */
+        Coord convert(Coord const &fromCoord, double tai);
+
+        /**
+        Return latency statistics for one stage of conversion
+
+        @param[in] stage  stage of conversion
+        @throw std::invalid_argument if stage is invalid
+        */
+        LatencyStats getStats(TrackerStageEnum stage) const;
+
+        /**
+        Discard all latency statistics
+        */
+        void resetStats();
+
+        /// return the initial coordinate system
+        CoordSys::ConstPtr getFromCoordSys() const { return _fromCoordSysPtr; };
+
+        /// return the final coordinate system
+        CoordSys::ConstPtr getToCoordSys() const { return _toCoordSysPtr; };
+
+        /// return the site
+        Site getSite() const { return _site; };
+
+        /**
+        Set the site, e.g. to update refraction coefficients or UT1-TAI
+
+        The prepared data depends on the site, so prepare must be called again.
+
+        @param[in] site  site information
+        */
+        void setSite(Site const &site);
+
+        /// return maximum |tai - taiAhead| for which prepared data may be used (sec)
+        double getMaxDTAI() const { return _maxDTAI; };
+
+        /// return taiAhead from the most recent call to prepare (MJD, sec); NaN if not prepared
+        double getPreparedTAI() const { return _prepTAI; };
+
+        /**
+        Return a string representation
+        */
+        std::string __repr__() const;
+
+    private:
+        CoordSys::Ptr _fromCoordSysPtr;     ///< initial coordinate system
+        CoordSys::ConstPtr _toCoordSysPtr;  ///< final coordinate system
+        bool _isObs;            ///< true if the final coordinate system is observed
+        Site _site;             ///< site information
+        double _maxDTAI;        ///< maximum |tai - _prepTAI| for which prepared data may be used (sec)
+        double _prepTAI;        ///< TAI date at which data was prepared (MJD, sec); NaN if not prepared
+        double _prepLAST;       ///< local apparent sidereal time at _prepTAI (deg)
+        AppGeoCoordSys _appGeoCoordSys; ///< apparent geocentric coordinate system at _prepTAI
+        LatencyHistogram _histList[TrackerStage_NumStages]; ///< latency histogram for each stage
+    };
+
+    std::ostream &operator<<(std::ostream &os, Tracker const &tracker);
+
+}
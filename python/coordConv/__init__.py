@@ -3,3 +3,4 @@ from __future__ import absolute_import, division
 from .version import *
 from .coordConvLib import *
 from .testUtils import *
+from .sphArrays import *
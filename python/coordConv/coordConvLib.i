@@ -12,6 +12,17 @@
 #include "ndarray/swig.h"
 #include "ndarray/swig/eigen.h"
 #include "coordConv/coordConv.h"
+
+/*
+Release the Python global interpreter lock for the lifetime of this object
+*/
+class ReleaseGIL {
+public:
+    ReleaseGIL() : _threadState(PyEval_SaveThread()) {}
+    ~ReleaseGIL() { PyEval_RestoreThread(_threadState); }
+private:
+    PyThreadState *_threadState;
+};
 %}
 
 %init %{
@@ -57,26 +68,111 @@
     }
 }
 
+// Exception handling for functions that do a lot of work without using Python objects:
+// the same as the default, but release the global interpreter lock while running,
+// so other Python threads may run. The free functions (convertSphArray and convertSphDirArray) may be called
+// from several Python threads at once, but a CatalogConverter or ParallelConverter has conversion buffers,
+// so each object must only be used by one Python thread at a time.
+// The lock is reacquired before a C++ exception is converted to a Python exception.
+%define %releaseGIL(FUNCNAME)
+%exception FUNCNAME {
+    try {
+        ReleaseGIL releaseGIL;
+        $action
+    } catch (std::invalid_argument & e) {
+        PyErr_SetString(PyExc_ValueError, e.what());
+        SWIG_fail;
+    } catch (std::out_of_range & e) {
+        PyErr_SetString(PyExc_LookupError, e.what());
+        SWIG_fail;
+    } catch (std::logic_error & e) {
+        PyErr_SetString(PyExc_RuntimeError, e.what());
+        SWIG_fail;
+    } catch (std::range_error & e) {
+        PyErr_SetString(PyExc_ValueError, e.what());
+        SWIG_fail;
+    } catch (std::overflow_error & e) {
+        PyErr_SetString(PyExc_OverflowError, e.what());
+        SWIG_fail;
+    } catch (std::runtime_error & e) {
+        PyErr_SetString(PyExc_RuntimeError, e.what());
+        SWIG_fail;
+    } catch (std::bad_alloc & e) {
+        PyErr_SetString(PyExc_MemoryError, e.what());
+        SWIG_fail;
+    } catch (std::exception & e) {
+        PyErr_SetString(PyExc_StandardError, e.what());
+        SWIG_fail;
+    } catch (...) {
+        SWIG_fail;
+    }
+}
+%enddef
+
+%releaseGIL(coordConv::convertSphArray);
+%releaseGIL(coordConv::convertSphDirArray);
+%releaseGIL(coordConv::CatalogConverter::convertFile);
+%releaseGIL(coordConv::ParallelConverter::convert);
+%releaseGIL(coordConv::ParallelConverter::convertFile);
+
 %declareNumPyConverters(Eigen::Vector2d);
 %declareNumPyConverters(Eigen::Vector3d);
 %declareNumPyConverters(Eigen::Matrix3d);
+%declareNumPyConverters(Eigen::MatrixX3d);
+%declareNumPyConverters(Eigen::MatrixX3f);
+%declareNumPyConverters(Eigen::MatrixXd);
+%declareNumPyConverters(Eigen::VectorXd);
+%declareNumPyConverters(Eigen::VectorXf);
 
 %copyctor coordConv::PVT;
 %copyctor coordConv::Coord;
+%copyctor coordConv::CoordArray;
+%copyctor coordConv::CompactCoordArray;
 %copyctor coordConv::Site;
 %copyctor coordConv::PVTCoord;
+%copyctor coordConv::ConversionPlan;
+%copyctor coordConv::LatencyStats;
+%copyctor coordConv::LatencyHistogram;
 
 %include "coordConv/pvt.h"
 %include "coordConv/physConst.h"
+%include "coordConv/convertStatus.h"
 
 %apply double &OUTPUT { double & };
 
+// the array version of sincosd is for C++; in Python use numpy
+%ignore coordConv::sincosd(Eigen::ArrayXd &, Eigen::ArrayXd &, Eigen::ArrayXd const &);
 %include "coordConv/mathUtils.h"
 %include "coordConv/angSideAng.h"
 %include "coordConv/rotEqPol.h"
 %include "coordConv/rotXY.h"
+%include "coordConv/aberration.h"
+%shared_ptr(coordConv::SiderealTimeData);
+%shared_ptr(coordConv::SiderealTimeCache);
+%include "coordConv/siderealTime.h"
+%shared_ptr(coordConv::RefractionTable);
+%shared_ptr(coordConv::RefractionCache);
+%include "coordConv/refractionTable.h"
+%shared_ptr(coordConv::RefCoCache);
+%include "coordConv/refCo.h"
 %include "coordConv/site.h"
 %include "coordConv/time.h"
 %include "coordConv/coord.h"
+%include "coordConv/coordArray.h"
+%include "coordConv/compactCoordArray.h"
 %include "coordConv/pvtCoord.h"
 %include "coordSys.i"
+%ignore coordConv::registerConversionShortcut;
+%include "coordConv/conversionShortcut.h"
+%include "coordConv/conversionPlan.h"
+%ignore coordConv::MappedCatalog;
+%ignore coordConv::coordArrayFromCatalog;
+%ignore coordConv::catalogFromCoordArray;
+%ignore coordConv::CatalogConverter::convert;
+%ignore coordConv::CatalogConverter::streamFile;
+%include "coordConv/catalogConverter.h"
+%ignore coordConv::ParallelConverter::convert(CatalogRecord *, CatalogRecord const *, std::size_t);
+%include "coordConv/parallelConverter.h"
+%include "coordConv/sphArray.h"
+%include "coordConv/latencyHistogram.h"
+%include "coordConv/tracker.h"
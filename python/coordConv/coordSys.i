@@ -1,3 +1,6 @@
+%shared_ptr(coordConv::AppGeoData);
+%shared_ptr(coordConv::AppGeoEphemeris);
+%shared_ptr(coordConv::AppGeoCache);
 %shared_ptr(coordConv::CoordSys);
 %shared_ptr(coordConv::MeanCoordSys);
 %shared_ptr(coordConv::ApparentCoordSys);
@@ -10,6 +13,7 @@
 %shared_ptr(coordConv::ObsCoordSys);
 %shared_ptr(coordConv::OtherCoordSys);
 %shared_ptr(coordConv::NoneCoordSys);
+%shared_ptr(coordConv::ConversionShortcut);
 
 %copyctor coordConv::ICRSCoordSys;
 %copyctor coordConv::FK5CoordSys;
@@ -21,4 +25,12 @@
 %copyctor coordConv::OtherCoordSys;
 %copyctor coordConv::NoneCoordSys;
 
+%ignore coordConv::AppGeoData::AppGeoData(double, double const *);
+// the non-throwing version is for real-time C++ code; in Python use convertFromMultiRefCo
+%ignore coordConv::ObsCoordSys::tryConvertFromMultiRefCo;
 %include "coordConv/coordSys.h"
+
+%ignore coordConv::AppGeoEphemerisHeader;
+%ignore coordConv::AppGeoEphemerisRecord;
+%ignore coordConv::AppGeoEphemeris::getAmprms;
+%include "coordConv/appGeoEphemeris.h"
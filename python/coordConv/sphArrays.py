@@ -0,0 +1,65 @@
+from __future__ import absolute_import, division
+
+import collections
+
+import numpy
+
+from .coordConvLib import convertSphArray, convertSphDirArray, OrientationMethod_Analytic
+
+__all__ = ["SphArrays", "convertSphArrays"]
+
+SphArrays = collections.namedtuple("SphArrays",
+    ["equatAng", "polarAng", "parallax", "equatPM", "polarPM", "radVel", "dir", "scaleChange"])
+SphArrays.__doc__ = """Arrays of converted spherical coordinates, as returned by convertSphArrays
+
+Fields and units are the same as the arguments of coordConv.Coord(equatAng, polarAng, parallax, equatPM, polarPM, radVel),
+plus dir (orientation, in deg) and scaleChange, which are None if no orientation was converted.
+"""
+
+def convertSphArrays(fromCoordSys, toCoordSys, site, tai, equatAng, polarAng,
+    parallax=0, equatPM=0, polarPM=0, radVel=0, fromDir=None, numThreads=1, orientMethod=OrientationMethod_Analytic):
+    """Convert arrays of spherical coordinates from one coordinate system to another
+
+    The conversion runs in C++ (see convertSphArray and convertSphDirArray)
+    without holding the Python global interpreter lock.
+    Element i of the results matches the result of:
+        toCoordSys.convertFrom(fromCoordSys, Coord(equatAng[i], polarAng[i], parallax[i], ...), site, tai)
+    or, if fromDir is specified:
+        toCoordSys.convertFrom(fromCoordSys, Coord(...), fromDir[i], site, tai, orientMethod)
+
+    @param[in] fromCoordSys  initial coordinate system
+    @param[in] toCoordSys  final coordinate system
+    @param[in] site  site information
+    @param[in] tai  TAI date of conversion (MJD, sec); used for any coordinate system that is current
+    @param[in] equatAng  equatorial angle (e.g. RA, Long, Az) (degrees)
+    @param[in] polarAng  polar angle (e.g. Dec, Latitude, Alt) (degrees)
+    @param[in] parallax  parallax (arcsec)
+    @param[in] equatPM  equatorial proper motion (arcsec/century); this is dEquatAng/dt, so it gets large near the pole
+    @param[in] polarPM  polar proper motion (arcsec/century)
+    @param[in] radVel  radial velocity (km/sec, positive receding)
+    @param[in] fromDir  initial orientation (deg; 0 along increasing equatorial angle, 90 along increasing polar angle);
+        if None then orientation is not converted
+    @param[in] numThreads  number of threads; if 0 then use the number of hardware threads;
+        ignored if fromDir is specified
+    @param[in] orientMethod  how to compute orientation (see CoordSys.convertFrom); ignored if fromDir is None
+    @return an SphArrays of 1-dimensional numpy arrays; dir and scaleChange are None if fromDir is None
+
+    The position arguments and fromDir may be scalars or array-like; they are broadcast to a common shape,
+    which must be 1-dimensional (or scalar, which is treated as a single position).
+    """
+    argList = [equatAng, polarAng, parallax, equatPM, polarPM, radVel]
+    if fromDir is not None:
+        argList.append(fromDir)
+    argList = [numpy.atleast_1d(numpy.asarray(arg, dtype=float)) for arg in argList]
+    argList = numpy.broadcast_arrays(*argList)
+    if argList[0].ndim != 1:
+        raise ValueError("Arguments must broadcast to a 1-dimensional shape, not %s" % (argList[0].shape,))
+    fromSphArr = numpy.column_stack(argList[0:6])
+
+    if fromDir is None:
+        toSphArr = convertSphArray(fromCoordSys, toCoordSys, fromSphArr, site, tai, numThreads)
+        return SphArrays(*([toSphArr[:, i] for i in range(6)] + [None, None]))
+
+    fromDirArr = numpy.array(argList[6])
+    toSphDirArr = convertSphDirArray(fromCoordSys, toCoordSys, fromSphArr, fromDirArr, site, tai, orientMethod)
+    return SphArrays(*[toSphDirArr[:, i] for i in range(8)])
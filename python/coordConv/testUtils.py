@@ -1,6 +1,47 @@
 from __future__ import absolute_import, division
 
-from .coordConvLib import wrapCtr
+from .coordConvLib import wrapCtr, Site, Coord, CoordArray, makeCoordSys, \
+    ICRSCoordSys, FK5CoordSys, FK4CoordSys, GalCoordSys
+
+TestTAI = 4889900000.205 # a TAI date (MJD, seconds) used by many unit tests
+
+def makeTestSite():
+    """Return a Site for unit tests, with pole wander, UT1-TAI and refraction coefficients set
+    """
+    site = Site(-105.822616, 32.780988, 2788)
+    site.setPoleWander(1.1e-4, -0.5e-4)
+    site.ut1_tai = -34.782
+    site.refCoA = 1.2e-2
+    site.refCoB = -1.3e-5
+    return site
+
+def makeCoordSysList(includeOtherDates=False):
+    """Return a list of coordinate systems for unit tests: one of each kind, including current systems
+
+    @param[in] includeOtherDates  if True, also include mean coordinate systems at a few more dates
+    """
+    coordSysList = [makeCoordSys(name, 0) for name in ("icrs", "gal", "appgeo", "apptopo", "obs")]
+    coordSysList += [FK5CoordSys(1980), FK4CoordSys(1950)]
+    if includeOtherDates:
+        coordSysList += [ICRSCoordSys(2010.5), FK5CoordSys(2030), GalCoordSys(1975)]
+    return coordSysList
+
+def makeCoordArr(equatAngList, polarAngList, pmArgsList=((0, 0, 0, 0), (0.012, 3.1, -4.2, 15))):
+    """Return a CoordArray for unit tests, with one coord for each combination of the arguments
+
+    @param[in] equatAngList  equatorial angles (deg)
+    @param[in] polarAngList  polar angles (deg)
+    @param[in] pmArgsList  a list of (parallax, equatPM, polarPM, radVel); see Coord for units
+    """
+    coordList = []
+    for equatAng in equatAngList:
+        for polarAng in polarAngList:
+            for pmArgs in pmArgsList:
+                coordList.append(Coord(equatAng, polarAng, *pmArgs))
+    coordArr = CoordArray(len(coordList))
+    for i, coord in enumerate(coordList):
+        coordArr.setCoord(i, coord)
+    return coordArr
 
 def assertPVTsAlmostEqual(pvt1, pvt2, doWrap=False, posPlaces=7, velPlaces=7, tPlaces=7):
     """Assert that two PVTs are almost equal
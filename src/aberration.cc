@@ -0,0 +1,74 @@
+#include <sstream>
+#include <stdexcept>
+#include "coordConv/aberration.h"
+
+/*
+References:
+  ABERAT, an APPLE (J2000) subroutine; U.S. Naval Observatory
+  P.T. Wallace, slaMAPQK (a SLALIB subroutine); Starlink, RGO
+  P.T. Wallace, "Proposals for Keck Tel. Point. Algorithms," 1986 (unpub.)
+  "The Astronomical Almanac" for 1978, U.S. Naval Observatory
+*/
+
+namespace coordConv {
+
+    Eigen::Vector3d addAnnualAberration(
+        Eigen::Vector3d const &pos,
+        Eigen::Vector3d const &bcBeta,
+        double gammaI
+    ) {
+        double posMag = pos.norm();
+        double dot = pos.dot(bcBeta) / posMag;
+        double vfac = posMag * (1.0 + dot / (1.0 + gammaI)); // the presence of posMag is due to light travel time from the target
+        return ((gammaI * pos) + (vfac * bcBeta)) / (1.0 + dot);
+    }
+
+    Eigen::Vector3d removeAnnualAberration(
+        Eigen::Vector3d const &pos,
+        Eigen::Vector3d const &bcBeta,
+        double gammaI
+    ) {
+        // addAnnualAberration with bcBeta negated
+        double posMag = pos.norm();
+        double dot = pos.dot(bcBeta) / posMag;
+        double vfac = posMag * (1.0 - dot / (1.0 + gammaI));
+        return ((gammaI * pos) - (vfac * bcBeta)) / (1.0 - dot);
+    }
+
+    Eigen::Vector3d removeAnnualAberrationIter(
+        Eigen::Vector3d const &pos,
+        Eigen::Vector3d const &bcBeta,
+        double gammaI
+    ) {
+        /// if the number of iterations exceeds "MaxIter" before converging, throw an exception
+        const int MaxIter = 20;
+        /// if all three components of (P this iter - P last iter) / |P|
+        /// are less than "Accuracy", then the iteration has converged.
+        const double Accuracy = 1.0e-10;
+
+        const double approxMagP = pos.norm();
+        const double allowedErr = Accuracy * approxMagP;
+
+        int iter = 0;
+        double maxErr = approxMagP;
+        Eigen::Vector3d pos2 = pos;
+        while (maxErr > allowedErr) {
+            iter += 1;
+            if (iter > MaxIter) {
+                std::ostringstream os;
+                os << "aberration correction failed to converge in " << MaxIter <<
+                    " iterations; error = " << maxErr << " > " << allowedErr << " allowed";
+                throw std::runtime_error(os.str());
+            }
+
+            double p2Mag = pos2.norm();
+            double dot2 = pos2.dot(bcBeta) / p2Mag;
+            double fac = p2Mag * (1.0 + (dot2 / (1.0 + gammaI)));
+            Eigen::Vector3d oldP2 = pos2;
+            pos2 = (((1.0 + dot2) * pos) - (fac * bcBeta)) / gammaI;
+            maxErr = (pos2 - oldP2).array().abs().maxCoeff();
+        }
+        return pos2;
+    }
+
+}
@@ -0,0 +1,168 @@
+#include <cmath>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include "slalib.h"
+#include "coordConv/coordSys.h"
+#include "coordConv/appGeoEphemeris.h"
+
+namespace {
+
+    /*
+    Throw std::invalid_argument if the cache mode requires a grid interval and maxAge is not a valid one
+
+    @param[in] maxAge  maximum cache age, or interval between grid points (years)
+    @param[in] mode  cache mode
+    */
+    void checkMaxAge(double maxAge, coordConv::AppGeoCacheModeEnum mode) {
+        if ((mode == coordConv::AppGeoCacheMode_Interpolate) && (!std::isfinite(maxAge) || !(maxAge > 0))) {
+            std::ostringstream os;
+            os << "maxAge = " << maxAge << " must be finite and > 0 in interpolate mode";
+            throw std::invalid_argument(os.str());
+        }
+    }
+
+}
+
+namespace coordConv {
+
+    AppGeoData::AppGeoData()
+    :
+        date(std::numeric_limits<double>::quiet_NaN()),
+        pmSpan(std::numeric_limits<double>::quiet_NaN()),
+        bcPos(Eigen::Vector3d::Constant(std::numeric_limits<double>::quiet_NaN())),
+        hcDir(Eigen::Vector3d::Constant(std::numeric_limits<double>::quiet_NaN())),
+        gravRad(std::numeric_limits<double>::quiet_NaN()),
+        bcBeta(Eigen::Vector3d::Constant(std::numeric_limits<double>::quiet_NaN())),
+        gammaI(std::numeric_limits<double>::quiet_NaN()),
+        pnMat(Eigen::Matrix3d::Constant(std::numeric_limits<double>::quiet_NaN()))
+    { }
+
+    AppGeoData::AppGeoData(double date)
+    :
+        date(date)
+    {
+        double tdbDays = slaEpj2d(date);
+        double amprms[AmprmsSize];
+        slaMappa(2000.0, tdbDays, amprms);
+        _setFromAmprms(amprms);
+    }
+
+    AppGeoData::AppGeoData(double date, double const *amprms)
+    :
+        date(date)
+    {
+        _setFromAmprms(amprms);
+    }
+
+    AppGeoData::AppGeoData(AppGeoData const &data0, AppGeoData const &data1, double date)
+    :
+        date(date)
+    {
+        double const u = (date - data0.date) / (data1.date - data0.date);
+        pmSpan = data0.pmSpan + (u * (data1.pmSpan - data0.pmSpan));
+        bcPos = data0.bcPos + (u * (data1.bcPos - data0.bcPos));
+        hcDir = data0.hcDir + (u * (data1.hcDir - data0.hcDir));
+        gravRad = data0.gravRad + (u * (data1.gravRad - data0.gravRad));
+        bcBeta = data0.bcBeta + (u * (data1.bcBeta - data0.bcBeta));
+        gammaI = data0.gammaI + (u * (data1.gammaI - data0.gammaI));
+        pnMat = data0.pnMat + (u * (data1.pnMat - data0.pnMat));
+    }
+
+    void AppGeoData::_setFromAmprms(double const *amprms) {
+        pmSpan = amprms[0];
+        gravRad = amprms[7];
+        gammaI = amprms[11];
+        for (int i = 0; i < 3; ++i) {
+            bcPos(i) = amprms[1+i];
+            hcDir(i) = amprms[4+i];
+            bcBeta(i) = amprms[8+i];
+            for (int j = 0; j < 3; ++j) {
+                pnMat(i,j) = amprms[12+(i*3)+j];
+            }
+        }
+    }
+
+    AppGeoCache::AppGeoCache(double maxAge, double maxDDate, AppGeoCacheModeEnum mode)
+    :
+        _maxAge(maxAge),
+        _maxDDate(maxDDate),
+        _mode(mode),
+        _ephemPtr(),
+        _dataPtr()
+    {
+        checkMaxAge(maxAge, mode);
+    }
+
+    AppGeoCache::AppGeoCache(boost::shared_ptr<const AppGeoEphemeris> const &ephemPtr, double maxAge, double maxDDate,
+        AppGeoCacheModeEnum mode)
+    :
+        _maxAge(maxAge),
+        _maxDDate(maxDDate),
+        _mode(mode),
+        _ephemPtr(ephemPtr),
+        _dataPtr()
+    {
+        checkMaxAge(maxAge, mode);
+    }
+
+    AppGeoData::ConstPtr AppGeoCache::get() const {
+        // boost::atomic_load and atomic_store on a shared_ptr take a short spinlock from a pool
+        return boost::atomic_load(&_dataPtr);
+    }
+
+    AppGeoData::ConstPtr AppGeoCache::get(double date) const {
+        AppGeoData::ConstPtr dataPtr = get();
+        if (dataPtr && (std::abs(date - dataPtr->date) < _maxAge)) {
+            return dataPtr;
+        }
+        return AppGeoData::ConstPtr();
+    }
+
+    void AppGeoCache::set(AppGeoData::ConstPtr const &dataPtr) {
+        if (!dataPtr) {
+            throw std::invalid_argument("dataPtr is null");
+        }
+        boost::atomic_store(&_dataPtr, dataPtr);
+    }
+
+    AppGeoData::ConstPtr AppGeoCache::compute(double date) const {
+        boost::shared_ptr<AppGeoData> dataPtr(new AppGeoData());
+        compute(*dataPtr, date);
+        return dataPtr;
+    }
+
+    void AppGeoCache::compute(AppGeoData &data, double date) const {
+        if (_ephemPtr && _ephemPtr->contains(date)) {
+            double amprms[AmprmsSize];
+            _ephemPtr->getAmprms(amprms, date);
+            data = AppGeoData(date, amprms);
+        } else {
+            data = AppGeoData(date);
+        }
+    }
+
+    AppGeoData::ConstPtr AppGeoCache::getGridData(double gridInd) {
+        double const gridDate = gridInd * _maxAge;
+        AppGeoData::ConstPtr &slotPtr = _gridDataPtrArr[(std::fmod(gridInd, 2.0) == 0) ? 0 : 1];
+        AppGeoData::ConstPtr dataPtr = boost::atomic_load(&slotPtr);
+        if (!dataPtr || (dataPtr->date != gridDate)) {
+            dataPtr = compute(gridDate);
+            boost::atomic_store(&slotPtr, dataPtr);
+        }
+        return dataPtr;
+    }
+
+    AppGeoData::ConstPtr AppGeoCache::getGridData(double gridInd, boost::shared_ptr<AppGeoData> const &bufPtr) {
+        double const gridDate = gridInd * _maxAge;
+        AppGeoData::ConstPtr &slotPtr = _gridDataPtrArr[(std::fmod(gridInd, 2.0) == 0) ? 0 : 1];
+        AppGeoData::ConstPtr dataPtr = boost::atomic_load(&slotPtr);
+        if (!dataPtr || (dataPtr->date != gridDate)) {
+            compute(*bufPtr, gridDate);
+            dataPtr = bufPtr;
+            boost::atomic_store(&slotPtr, dataPtr);
+        }
+        return dataPtr;
+    }
+
+}
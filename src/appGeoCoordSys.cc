@@ -6,17 +6,221 @@
 #include "coordConv/mathUtils.h"
 #include "coordConv/physConst.h"
 #include "coordConv/time.h"
+#include "coordConv/aberration.h"
 #include "coordConv/coordSys.h"
 
+namespace {
+
+    /*
+    Return the jacobian of the annual aberration correction used by AppGeoCoordSys
+
+    @param[in] pos2  position before correcting for annual aberration
+    @param[in] pos3  position after correcting for annual aberration
+    @param[in] bcBeta  barycentric velocity of the Earth (c)
+    @param[in] gammaI  sqrt(1 - bcBeta^2)
+    @return partial derivative of pos3 with respect to pos2
+    */
+    Eigen::Matrix3d aberrationJacobian(
+        Eigen::Vector3d const &pos2,
+        Eigen::Vector3d const &pos3,
+        Eigen::Vector3d const &bcBeta,
+        double gammaI
+    ) {
+        // pos3 = ((gammaI * pos2) + (vfac * bcBeta)) / (1 + dot2), where
+        // dot2 = pos2 . bcBeta / |pos2| and vfac = |pos2| + (pos2 . bcBeta / (1 + gammaI))
+        double pos2Mag = pos2.norm();
+        Eigen::Vector3d unitPos2 = pos2 / pos2Mag;
+        double dot2 = unitPos2.dot(bcBeta);
+        Eigen::Vector3d dVFac = unitPos2 + (bcBeta / (1.0 + gammaI));
+        Eigen::Vector3d dDot2 = (bcBeta - (dot2 * unitPos2)) / pos2Mag;
+        return ((gammaI * Eigen::Matrix3d::Identity()) + (bcBeta * dVFac.transpose()) - (pos3 * dDot2.transpose()))
+            / (1.0 + dot2);
+    }
+
+    /*
+    Return the rate of change of apparent geocentric position with date, at fixed FK5 J2000 position,
+    when the star-independent data changes linearly with date (as in AppGeoCacheMode_Interpolate mode)
+
+    @param[in] fk5J2000Coord  FK5 J2000 coordinates
+    @param[in] data  star-independent data at the date of conversion
+    @param[in] data0  star-independent data at an earlier date
+    @param[in] data1  star-independent data at a later date; data changes linearly from data0 to data1
+    @return partial derivative of apparent geocentric position with respect to TDB date (AU/year)
+    */
+    Eigen::Vector3d appGeoDateRate(
+        coordConv::Coord const &fk5J2000Coord,
+        coordConv::AppGeoData const &data,
+        coordConv::AppGeoData const &data0,
+        coordConv::AppGeoData const &data1
+    ) {
+        double const dDate = data1.date - data0.date;
+        Eigen::Vector3d const bcPosRate = (data1.bcPos - data0.bcPos) / dDate;
+        Eigen::Vector3d const bcBetaRate = (data1.bcBeta - data0.bcBeta) / dDate;
+        double const gammaIRate = (data1.gammaI - data0.gammaI) / dDate;
+        Eigen::Matrix3d const pnMatRate = (data1.pnMat - data0.pnMat) / dDate;
+
+        // pos2 = fk5J2000Pos + (fk5J2000PM * pmSpan) - bcPos
+        Eigen::Vector3d pos2 = fk5J2000Coord.getVecPos() - data.bcPos;
+        Eigen::Vector3d pos2Rate = -bcPosRate;
+        if (fk5J2000Coord.hasPM()) {
+            pos2 += fk5J2000Coord.getVecPM() * data.pmSpan;
+            pos2Rate += fk5J2000Coord.getVecPM() * ((data1.pmSpan - data0.pmSpan) / dDate);
+        }
+
+        // pos3 = ((gammaI * pos2) + (vfac * bcBeta)) / (1 + dot2); see aberrationJacobian;
+        // differentiate with respect to pos2, bcBeta and gammaI
+        double pos2Mag = pos2.norm();
+        Eigen::Vector3d unitPos2 = pos2 / pos2Mag;
+        double dot2 = unitPos2.dot(data.bcBeta);
+        double vfac = pos2Mag * (1.0 + (dot2 / (1.0 + data.gammaI)));
+        double denom = 1.0 + dot2;
+        Eigen::Vector3d pos3 = ((data.gammaI * pos2) + (vfac * data.bcBeta)) / denom;
+        Eigen::Matrix3d dPos3DBeta = ((vfac * Eigen::Matrix3d::Identity())
+            + (data.bcBeta * pos2.transpose() / (1.0 + data.gammaI)) - (pos3 * unitPos2.transpose())) / denom;
+        Eigen::Vector3d dPos3DGammaI = (pos2
+            - (data.bcBeta * pos2Mag * dot2 / ((1.0 + data.gammaI) * (1.0 + data.gammaI)))) / denom;
+        Eigen::Vector3d pos3Rate = (aberrationJacobian(pos2, pos3, data.bcBeta, data.gammaI) * pos2Rate)
+            + (dPos3DBeta * bcBetaRate) + (dPos3DGammaI * gammaIRate);
+
+        // appGeoPos = pnMat * pos3
+        return (pnMatRate * pos3) + (data.pnMat * pos3Rate);
+    }
+
+    // The array versions of fromFK5J2000 and toFK5J2000 process positions in groups of LaneCount:
+    // each cartesian component of a group is held in a fixed-size Eigen array, which Eigen evaluates
+    // using whatever SIMD instructions the compiler is allowed to use (e.g. SSE2, AVX or AVX-512).
+    // A partial group at the end is processed using dynamic-size arrays.
+    // The math is identical to the Coord versions, which have more commentary.
+    const int LaneCount = 8;
+
+    /*
+    Compute apparent geocentric position from FK5 J2000 position for a group of positions
+
+    @param[out] appGeoPos  apparent geocentric positions; rows [start, start + n) are set
+    @param[in] fk5J2000Pos  FK5 J2000 positions; may be the same matrix as appGeoPos
+    @param[in] fk5J2000PM  FK5 J2000 proper motions
+    @param[in] hasPM  if false then all of fk5J2000PM is known to be zero, so it is ignored
+    @param[in] data  star-independent data from AppGeoCoordSys
+    @param[in] start  index of first row to convert
+    @param[in] n  number of rows to convert; must equal N unless N is Eigen::Dynamic
+    */
+    template <int N>
+    void appGeoFromFK5J2000Lanes(
+        Eigen::MatrixX3d &appGeoPos,
+        Eigen::MatrixX3d const &fk5J2000Pos,
+        Eigen::MatrixX3d const &fk5J2000PM,
+        bool hasPM,
+        coordConv::AppGeoData const &data,
+        int start,
+        int n
+    ) {
+        typedef Eigen::Array<double, N, 1> Lanes;
+
+        // correct for velocity and Earth's offset from the barycenter
+        Lanes x = fk5J2000Pos.col(0).segment(start, n).array();
+        Lanes y = fk5J2000Pos.col(1).segment(start, n).array();
+        Lanes z = fk5J2000Pos.col(2).segment(start, n).array();
+        if (hasPM) {
+            x += fk5J2000PM.col(0).segment(start, n).array() * data.pmSpan;
+            y += fk5J2000PM.col(1).segment(start, n).array() * data.pmSpan;
+            z += fk5J2000PM.col(2).segment(start, n).array() * data.pmSpan;
+        }
+        x -= data.bcPos(0);
+        y -= data.bcPos(1);
+        z -= data.bcPos(2);
+
+        // correct for annual aberration
+        Lanes pos2Mag = (x.square() + y.square() + z.square()).sqrt();
+        Lanes dot2 = ((x * data.bcBeta(0)) + (y * data.bcBeta(1)) + (z * data.bcBeta(2))) / pos2Mag;
+        Lanes vfac = pos2Mag * (1.0 + (dot2 / (1.0 + data.gammaI)));
+        Lanes denom = 1.0 + dot2;
+        Lanes x3 = ((data.gammaI * x) + (vfac * data.bcBeta(0))) / denom;
+        Lanes y3 = ((data.gammaI * y) + (vfac * data.bcBeta(1))) / denom;
+        Lanes z3 = ((data.gammaI * z) + (vfac * data.bcBeta(2))) / denom;
+
+        // correct position for precession and nutation
+        for (int i = 0; i < 3; ++i) {
+            appGeoPos.col(i).segment(start, n) =
+                ((data.pnMat(i, 0) * x3) + (data.pnMat(i, 1) * y3) + (data.pnMat(i, 2) * z3)).matrix();
+        }
+    }
+
+    /*
+    Compute FK5 J2000 position from apparent geocentric position for a group of positions
+
+    @param[out] fk5J2000Pos  FK5 J2000 positions; rows [start, start + n) are set
+    @param[in] appGeoPos  apparent geocentric positions; may be the same matrix as fk5J2000Pos
+    @param[in] data  star-independent data from AppGeoCoordSys
+    @param[in] start  index of first row to convert
+    @param[in] n  number of rows to convert; must equal N unless N is Eigen::Dynamic
+    */
+    template <int N>
+    void fk5J2000FromAppGeoLanes(
+        Eigen::MatrixX3d &fk5J2000Pos,
+        Eigen::MatrixX3d const &appGeoPos,
+        coordConv::AppGeoData const &data,
+        int start,
+        int n
+    ) {
+        typedef Eigen::Array<double, N, 1> Lanes;
+
+        Lanes appGeoX = appGeoPos.col(0).segment(start, n).array();
+        Lanes appGeoY = appGeoPos.col(1).segment(start, n).array();
+        Lanes appGeoZ = appGeoPos.col(2).segment(start, n).array();
+
+        // correct position for nutation and precession
+        Eigen::Matrix3d const &pnMat = data.pnMat;
+        Lanes x3 = (pnMat(0, 0) * appGeoX) + (pnMat(1, 0) * appGeoY) + (pnMat(2, 0) * appGeoZ);
+        Lanes y3 = (pnMat(0, 1) * appGeoX) + (pnMat(1, 1) * appGeoY) + (pnMat(2, 1) * appGeoZ);
+        Lanes z3 = (pnMat(0, 2) * appGeoX) + (pnMat(1, 2) * appGeoY) + (pnMat(2, 2) * appGeoZ);
+
+        // correct for annual aberration (see coordConv::removeAnnualAberration)
+        Lanes pos3Mag = (x3.square() + y3.square() + z3.square()).sqrt();
+        Lanes dot3 = ((x3 * data.bcBeta(0)) + (y3 * data.bcBeta(1)) + (z3 * data.bcBeta(2))) / pos3Mag;
+        Lanes vfac = pos3Mag * (1.0 - (dot3 / (1.0 + data.gammaI)));
+        Lanes denom = 1.0 - dot3;
+        Lanes x2 = ((data.gammaI * x3) - (vfac * data.bcBeta(0))) / denom;
+        Lanes y2 = ((data.gammaI * y3) - (vfac * data.bcBeta(1))) / denom;
+        Lanes z2 = ((data.gammaI * z3) - (vfac * data.bcBeta(2))) / denom;
+
+        // correct for Earth's offset from the barycenter
+        fk5J2000Pos.col(0).segment(start, n) = (x2 + data.bcPos(0)).matrix();
+        fk5J2000Pos.col(1).segment(start, n) = (y2 + data.bcPos(1)).matrix();
+        fk5J2000Pos.col(2).segment(start, n) = (z2 + data.bcPos(2)).matrix();
+    }
+
+}
+
 namespace coordConv {
 
     AppGeoCoordSys::AppGeoCoordSys(double date, double maxAge, double maxDDate)
     :
         ApparentCoordSys("appgeo", date, DateType_Julian),
-        _maxAge(maxAge),
-        _maxDDate(maxDDate),
-        _cacheDate(DoubleNaN)
+        _cachePtr(new AppGeoCache(maxAge, maxDDate)),
+        _dataPtr(),
+        _nextDataPtr(),
+        _interpData()
     {
+        for (int i = 0; i < 3; ++i) {
+            _bufPtrArr[i].reset(new AppGeoData());
+        }
+        setDate(date);
+    };
+
+    AppGeoCoordSys::AppGeoCoordSys(AppGeoCache::Ptr const &cachePtr, double date)
+    :
+        ApparentCoordSys("appgeo", date, DateType_Julian),
+        _cachePtr(cachePtr),
+        _dataPtr(),
+        _nextDataPtr(),
+        _interpData()
+    {
+        for (int i = 0; i < 3; ++i) {
+            _bufPtrArr[i].reset(new AppGeoData());
+        }
+        if (!cachePtr) {
+            throw std::invalid_argument("cachePtr is null");
+        }
         setDate(date);
     };
 
@@ -25,137 +229,198 @@ namespace coordConv {
     }
 
     CoordSys::Ptr AppGeoCoordSys::clone(double date) const {
-        return CoordSys::Ptr(new AppGeoCoordSys(date, _maxAge));
+        // share the cache; it is safe to do so, and it saves recomputing the data
+        return CoordSys::Ptr(new AppGeoCoordSys(_cachePtr, date));
     };
     
-    void AppGeoCoordSys::_setDate(double date) const {
+    ConvertStatusEnum AppGeoCoordSys::getDateStatus(double date) const {
         // sanity-check the date, since very large values can cause NaNs
         // and since a common mistake is to call with TAI, MJD seconds
-        if (date > 9999) {
+        return (date > 9999) ? ConvertStatus_DateTooLarge : ConvertStatus_OK;
+    }
+
+    ConvertStatusEnum AppGeoCoordSys::getConvertStatus() const {
+        return cacheOK() ? ConvertStatus_OK : ConvertStatus_CacheNotValid;
+    }
+
+    void AppGeoCoordSys::_setDate(double date) const {
+        if (getDateStatus(date) != ConvertStatus_OK) {
             std::ostringstream os;
             os << "date = " << date << " too large; should be TDB years";
             throw std::runtime_error(os.str());
         }
-        // std::cout << std::fixed << std::setprecision(11) << "AppGeoCoordSys._setDate: date=" << date << "; _date=" << _date << "; _cacheDate=" << _cacheDate;
         double dDate = date - this->_date;
         this->_date = date;
         if (std::isfinite(date) && (date != 0)) {
-            if (cacheOK() && ((std::abs(date - _cacheDate) < _maxAge) || (std::abs(dDate) < _maxDDate))) {
-                // std::cout << "; NOT updating AppGeo cache" << std::endl;
+            if (_cachePtr->getMode() == AppGeoCacheMode_Interpolate) {
+                // find the snapshots at the grid points on either side of date (usually the same as last time),
+                // then interpolate; new grid points are computed into this coordinate system's buffers
+                double const gridInd = std::floor(date / getMaxAge());
+                if (!cacheOK() || (_dataPtr->date != gridInd * getMaxAge())) {
+                    // let go of the old snapshots first, so their buffers may be reused
+                    AppGeoData::ConstPtr dataPtr = (_nextDataPtr && (_nextDataPtr->date == gridInd * getMaxAge()))
+                        ? _nextDataPtr : AppGeoData::ConstPtr();
+                    _dataPtr.reset();
+                    _nextDataPtr.reset();
+                    if (!dataPtr) {
+                        dataPtr = _cachePtr->getGridData(gridInd, _getFreeBuffer());
+                    }
+                    _nextDataPtr = _cachePtr->getGridData(gridInd + 1, _getFreeBuffer());
+                    _dataPtr = dataPtr;
+                }
+                _interpData = AppGeoData(*_dataPtr, *_nextDataPtr, date);
                 return;
             }
-            // std::cout << "; updating AppGeo cache" << std::endl;
-            double tdbDays = slaEpj2d(date);
-            double amprms[21];
-            slaMappa(2000.0, tdbDays, amprms);
-            
-            _pmSpan = amprms[0];
-            _gravRad = amprms[7];
-            _gammaI = amprms[11];
-            for (int i = 0; i < 3; ++i) {
-                _bcPos(i) = amprms[1+i];
-                _hcDir(i) = amprms[4+i];
-                _bcBeta(i) = amprms[8+i];
-                for (int j = 0; j < 3; ++j) {
-                    _pnMat(i,j) = amprms[12+(i*3)+j];
-                }
+            if (cacheOK() && ((std::abs(date - _dataPtr->date) < getMaxAge()) || (std::abs(dDate) < getMaxDDate()))) {
+                return;
+            }
+            // use the shared snapshot if it is young enough, else compute and publish a new one
+            AppGeoData::ConstPtr dataPtr = _cachePtr->get(date);
+            if (!dataPtr) {
+                boost::shared_ptr<AppGeoData> const &bufPtr = _getFreeBuffer();
+                _cachePtr->compute(*bufPtr, date);
+                dataPtr = bufPtr;
+                _cachePtr->set(dataPtr);
             }
-            _cacheDate = date;
-        // } else {
-        //     std::cout << "; nothing to update" << std::endl;
+            _dataPtr = dataPtr;
         }
     }
 
-    Coord AppGeoCoordSys::fromFK5J2000(Coord const &coord, Site const &site) const {
+    boost::shared_ptr<AppGeoData> const &AppGeoCoordSys::_getFreeBuffer() const {
+        int const numBuf = sizeof(_bufPtrArr) / sizeof(_bufPtrArr[0]);
+        for (int i = 0; i < numBuf; ++i) {
+            // once nothing else refers to a buffer, nothing else can obtain a reference to it
+            if (_bufPtrArr[i].use_count() == 1) {
+                return _bufPtrArr[i];
+            }
+        }
+        _bufPtrArr[0].reset(new AppGeoData());
+        return _bufPtrArr[0];
+    }
+
+    AppGeoData const &AppGeoCoordSys::_getData() const {
         if (!cacheOK()) {
-            throw std::runtime_error("cache not valid");
+            throwIfFailed(ConvertStatus_CacheNotValid);
         }
+        return (_cachePtr->getMode() == AppGeoCacheMode_Interpolate) ? _interpData : *_dataPtr;
+    }
+
+    Coord AppGeoCoordSys::fromFK5J2000(Coord const &coord, Site const &site) const {
+        AppGeoData const &data = _getData();
         Eigen::Vector3d fk5J2000Pos = coord.getVecPos();
-        Eigen::Vector3d fk5J2000PM = coord.getVecPM();
 
-        // correct for velocity and Earth's offset from the barycenter
-        Eigen::Vector3d pos1 = fk5J2000Pos + (fk5J2000PM * _pmSpan) - _bcPos;
+        // correct for velocity (if any) and Earth's offset from the barycenter
+        Eigen::Vector3d pos1 = coord.hasPM()
+            ? Eigen::Vector3d(fk5J2000Pos + (coord.getVecPM() * data.pmSpan) - data.bcPos)
+            : Eigen::Vector3d(fk5J2000Pos - data.bcPos);
 
         // here is where the correction for sun's gravity belongs
         Eigen::Vector3d pos2 = pos1;
 
         // correct for annual aberration
         double pos2Mag = pos2.norm();
-        double dot2 = pos2.dot(_bcBeta) / pos2Mag;
-        double vfac = pos2Mag * (1.0 + dot2 / (1.0 + _gammaI)); // the presence of pos2Mag is due to light travel time from the target
-        Eigen::Vector3d pos3 = ((_gammaI * pos2) + (vfac * _bcBeta)) / (1.0 + dot2);
+        double dot2 = pos2.dot(data.bcBeta) / pos2Mag;
+        double vfac = pos2Mag * (1.0 + dot2 / (1.0 + data.gammaI)); // the presence of pos2Mag is due to light travel time from the target
+        Eigen::Vector3d pos3 = ((data.gammaI * pos2) + (vfac * data.bcBeta)) / (1.0 + dot2);
 
         // correct position for precession and nutation
-        Eigen::Vector3d appGeoPos = _pnMat * pos3;
+        Eigen::Vector3d appGeoPos = data.pnMat * pos3;
         return Coord(appGeoPos);
     };
 
     /**
     Perform the inverse transform of fromFK5J2000.
-    
-    Unfortunately, some of the equations (e.g. annual aberration) are not invertable,
-    so they have been solved by iteration. To make the code easier to follow, the symbols used here
-    are identical to those used in fromFK5J2000.
-
-    The convergence criterion is set by the magic numbers MaxIter and Accuracy.
-
-    References:
-      cnv_J2AppGeo*
-      ABERAT*, an APPLE (J2000) subroutine; U.S. Naval Observatory
-      P.T. Wallace, slaMAPQK (a SLALIB subroutine); Starlink, RGO
-      P.T. Wallace, "Proposals for Keck Tel. Point. Algorithms," 1986 (unpub.)
-      "The Astronomical Almanac" for 1978, U.S. Naval Observatory
-      *these use physical units instead of direction cosines
+
+    Annual aberration is removed in closed form (see removeAnnualAberration),
+    so the cost is fixed and independent of position.
     */    
     Coord AppGeoCoordSys::toFK5J2000(Coord const &coord, Site const &site) const {
-        if (!cacheOK()) {
-            throw std::runtime_error("cache not valid");
-        }
+        AppGeoData const &data = _getData();
         Eigen::Vector3d appGeoPos = coord.getVecPos();
 
-        /// if the number of iterations exceeds "MaxIter" before converging, throw an exception
-        const int MaxIter = 20;
-        /// if all three components of (P this iter - P last iter) / |P|
-        /// are less than "Accuracy", then the iteration has converged.
-        const double Accuracy = 1.0e-10;
-        
-        // compute constants needed to check iteration
-        const double approxMagP = appGeoPos.norm();
-        const double allowedErr = Accuracy * approxMagP;
-
         // correct position for nutation and precession
-        Eigen::Vector3d pos3 = _pnMat.transpose() * appGeoPos;
-
-        // iterate to correct for annual aberration
-        int iter = 0;
-        double maxErr = approxMagP;
-        Eigen::Vector3d pos2 = pos3;
-        while (maxErr > allowedErr) {
-            iter += 1;
-            if (iter > MaxIter) {
-                std::ostringstream os;
-                os << "aberration correction failed to converge in " << MaxIter <<
-                    " iterations; error = " << maxErr << " > " << allowedErr << " allowed";
-                throw std::runtime_error(os.str());
-            }
-            
-            double p2Mag = pos2.norm();
-            double dot2 = pos2.dot(_bcBeta) / p2Mag;
-            double fac = p2Mag * (1.0 + (dot2 / (1.0 + _gammaI)));
-            Eigen::Vector3d oldP2 = pos2;
-            pos2 = (((1.0 + dot2) * pos3) - (fac * _bcBeta)) / _gammaI;
-            maxErr = (pos2 - oldP2).array().abs().maxCoeff();
-        }
+        Eigen::Vector3d pos3 = data.pnMat.transpose() * appGeoPos;
+
+        // correct for annual aberration
+        Eigen::Vector3d pos2 = removeAnnualAberration(pos3, data.bcBeta, data.gammaI);
 
         // here is where the (iterative) correction for sun's gravity belongs
         Eigen::Vector3d pos1 = pos2;
 
         // correct for Earth's offset from the barycenter
-        Eigen::Vector3d fk5J2000Pos = pos1 + _bcPos;
+        Eigen::Vector3d fk5J2000Pos = pos1 + data.bcPos;
         
         return Coord(fk5J2000Pos);
     }
 
+    void AppGeoCoordSys::fromFK5J2000(CoordArray &coordArr, CoordArray const &fk5J2000Arr, Site const &site) const {
+        AppGeoData const &data = _getData();
+        int const size = fk5J2000Arr.size();
+        bool const hasPM = fk5J2000Arr.hasPM();
+        coordArr.pos.resize(size, 3); // a no-op if coordArr and fk5J2000Arr are the same object
+
+        int const nFull = (size / LaneCount) * LaneCount;
+        for (int start = 0; start < nFull; start += LaneCount) {
+            appGeoFromFK5J2000Lanes<LaneCount>(coordArr.pos, fk5J2000Arr.pos, fk5J2000Arr.pm, hasPM, data,
+                start, LaneCount);
+        }
+        if (nFull < size) {
+            appGeoFromFK5J2000Lanes<Eigen::Dynamic>(coordArr.pos, fk5J2000Arr.pos, fk5J2000Arr.pm, hasPM, data,
+                nFull, size - nFull);
+        }
+        coordArr.pm.setZero(size, 3);
+    }
+
+    void AppGeoCoordSys::toFK5J2000(CoordArray &fk5J2000Arr, CoordArray const &coordArr, Site const &site) const {
+        AppGeoData const &data = _getData();
+        int const size = coordArr.size();
+        fk5J2000Arr.pos.resize(size, 3); // a no-op if coordArr and fk5J2000Arr are the same object
+
+        int const nFull = (size / LaneCount) * LaneCount;
+        for (int start = 0; start < nFull; start += LaneCount) {
+            fk5J2000FromAppGeoLanes<LaneCount>(fk5J2000Arr.pos, coordArr.pos, data, start, LaneCount);
+        }
+        if (nFull < size) {
+            fk5J2000FromAppGeoLanes<Eigen::Dynamic>(fk5J2000Arr.pos, coordArr.pos, data, nFull, size - nFull);
+        }
+        fk5J2000Arr.pm.setZero(size, 3);
+    }
+
+    // In AppGeoCacheMode_Interpolate mode the star-independent data (including the time span for proper motion)
+    // changes linearly with date, so posRate is computed from the slope between the grid points.
+    // In the other modes the cache is only updated occasionally, so position does not change continuously
+    // with date and posRate is 0.
+
+    Coord AppGeoCoordSys::fromFK5J2000(Eigen::Matrix3d &jacobian, Eigen::Vector3d &posRate, Coord const &coord, Site const &site) const {
+        AppGeoData const &data = _getData();
+        Coord appGeoCoord = fromFK5J2000(coord, site);
+        Eigen::Vector3d pos2 = coord.getVecPos() + (coord.getVecPM() * data.pmSpan) - data.bcPos;
+        Eigen::Vector3d pos3 = data.pnMat.transpose() * appGeoCoord.getVecPos();
+        jacobian = data.pnMat * aberrationJacobian(pos2, pos3, data.bcBeta, data.gammaI);
+        if (_cachePtr->getMode() == AppGeoCacheMode_Interpolate) {
+            posRate = appGeoDateRate(coord, data, *_dataPtr, *_nextDataPtr) / (SecPerDay * DaysPerYear);
+        } else {
+            posRate.setZero();
+        }
+        return appGeoCoord;
+    }
+
+    Coord AppGeoCoordSys::toFK5J2000(Eigen::Matrix3d &jacobian, Eigen::Vector3d &posRate, Coord const &coord, Site const &site) const {
+        AppGeoData const &data = _getData();
+        Coord fk5J2000Coord = toFK5J2000(coord, site);
+        Eigen::Vector3d pos2 = fk5J2000Coord.getVecPos() - data.bcPos;
+        Eigen::Vector3d pos3 = data.pnMat.transpose() * coord.getVecPos();
+        jacobian = aberrationJacobian(pos2, pos3, data.bcBeta, data.gammaI).inverse() * data.pnMat.transpose();
+        if (_cachePtr->getMode() == AppGeoCacheMode_Interpolate) {
+            // fromFK5J2000(toFK5J2000(coord)) = coord at all dates, so the rate of change of the FK5 J2000 position
+            // is minus the jacobian times the rate of change of apparent geocentric position at fixed FK5 J2000 position
+            posRate = -jacobian * appGeoDateRate(fk5J2000Coord, data, *_dataPtr, *_nextDataPtr) / (SecPerDay * DaysPerYear);
+        } else {
+            posRate.setZero();
+        }
+        return fk5J2000Coord;
+    }
+
     std::string AppGeoCoordSys::__repr__() const {
         std::ostringstream os;
         os << "AppGeoCoordSys(" << getDate() << ")";
@@ -0,0 +1,203 @@
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+#include "boost/interprocess/file_mapping.hpp"
+#include "slalib.h"
+#include "coordConv/appGeoEphemeris.h"
+
+namespace {
+    namespace bip = boost::interprocess;
+
+    char const Magic[8] = {'C', 'C', 'A', 'G', 'E', 'P', 'H', '1'};
+
+    // maximum number of grid points (a 1-minute grid for 100 years is less than this)
+    double const MaxNumPoints = 1e8;
+
+    // half the interval over which the rate of change of the parameters is computed (Julian years);
+    // small enough that the error from the curvature of the nutation terms is negligible,
+    // large enough that round-off error is negligible
+    double const RateHalfInterval = 0.01 / coordConv::DaysPerYear;
+
+    /*
+    Compute star-independent parameters using SLALIB
+
+    @param[out] amprms  star-independent parameters (coordConv::AmprmsSize values)
+    @param[in] date  TDB date in Julian years
+    */
+    void computeAmprms(double *amprms, double date) {
+        slaMappa(2000.0, slaEpj2d(date), amprms);
+    }
+}
+
+namespace coordConv {
+
+    AppGeoEphemeris::AppGeoEphemeris(double startDate, double endDate, double interval)
+    :
+        _path(),
+        _startDate(startDate),
+        _interval(interval),
+        _numPoints(0),
+        _recordVec(),
+        _region(),
+        _records(0)
+    {
+        if (!std::isfinite(startDate) || !std::isfinite(endDate) || (endDate < startDate)) {
+            std::ostringstream os;
+            os << "startDate = " << startDate << ", endDate = " << endDate << " must be finite and startDate <= endDate";
+            throw std::invalid_argument(os.str());
+        }
+        if (!(interval > 0) || ((endDate - startDate) / interval > MaxNumPoints)) {
+            std::ostringstream os;
+            os << "interval = " << interval << " must be > 0 and give at most " << MaxNumPoints << " grid points";
+            throw std::invalid_argument(os.str());
+        }
+        _numPoints = static_cast<int>(std::ceil((endDate - startDate) / interval)) + 1;
+        _recordVec.resize(_numPoints);
+        double amprmsPlus[AmprmsSize], amprmsMinus[AmprmsSize];
+        for (int i = 0; i < _numPoints; ++i) {
+            AppGeoEphemerisRecord &rec = _recordVec[i];
+            double const date = startDate + (i * interval);
+            computeAmprms(rec.amprms, date);
+
+            // compute the rate by central difference, dividing by the actual (rounded) difference in date
+            double const datePlus = date + RateHalfInterval;
+            double const dateMinus = date - RateHalfInterval;
+            computeAmprms(amprmsPlus, datePlus);
+            computeAmprms(amprmsMinus, dateMinus);
+            for (int j = 0; j < AmprmsSize; ++j) {
+                rec.rate[j] = (amprmsPlus[j] - amprmsMinus[j]) / (datePlus - dateMinus);
+            }
+        }
+        _records = &_recordVec[0];
+    }
+
+    AppGeoEphemeris::AppGeoEphemeris(std::string const &path)
+    :
+        _path(path),
+        _startDate(0),
+        _interval(0),
+        _numPoints(0),
+        _recordVec(),
+        _region(),
+        _records(0)
+    {
+        std::ifstream inFile(path.c_str(), std::ios::in | std::ios::binary | std::ios::ate);
+        if (!inFile) {
+            std::ostringstream os;
+            os << "Cannot open ephemeris \"" << path << "\" for reading";
+            throw std::runtime_error(os.str());
+        }
+        std::size_t const numBytes = static_cast<std::size_t>(inFile.tellg());
+        inFile.close();
+        if (numBytes < sizeof(AppGeoEphemerisHeader)) {
+            std::ostringstream os;
+            os << "Ephemeris \"" << path << "\" has " << numBytes << " bytes, which is too short to hold a header";
+            throw std::runtime_error(os.str());
+        }
+        try {
+            bip::file_mapping mapping(path.c_str(), bip::read_only);
+            bip::mapped_region region(mapping, bip::read_only, 0, numBytes);
+            _region.swap(region);
+        } catch (bip::interprocess_exception const &e) {
+            std::ostringstream os;
+            os << "Cannot map ephemeris \"" << path << "\": " << e.what();
+            throw std::runtime_error(os.str());
+        }
+
+        char const *data = static_cast<char const *>(_region.get_address());
+        AppGeoEphemerisHeader const &header = *reinterpret_cast<AppGeoEphemerisHeader const *>(data);
+        if (std::memcmp(header.magic, Magic, sizeof(Magic)) != 0) {
+            std::ostringstream os;
+            os << "File \"" << path << "\" is not an ephemeris file";
+            throw std::runtime_error(os.str());
+        }
+        if ((header.numPoints < 1) || (header.numPoints > MaxNumPoints)
+            || (numBytes != sizeof(AppGeoEphemerisHeader) + (header.numPoints * sizeof(AppGeoEphemerisRecord)))
+            || !std::isfinite(header.startDate) || !(header.interval > 0)) {
+            std::ostringstream os;
+            os << "Ephemeris \"" << path << "\" has " << numBytes << " bytes, numPoints = " << header.numPoints
+                << ", startDate = " << header.startDate << " and interval = " << header.interval
+                << ", which are not consistent";
+            throw std::runtime_error(os.str());
+        }
+        _startDate = header.startDate;
+        _interval = header.interval;
+        _numPoints = static_cast<int>(header.numPoints);
+        _records = reinterpret_cast<AppGeoEphemerisRecord const *>(data + sizeof(AppGeoEphemerisHeader));
+    }
+
+    void AppGeoEphemeris::writeFile(std::string const &path) const {
+        AppGeoEphemerisHeader header;
+        std::memcpy(header.magic, Magic, sizeof(Magic));
+        header.startDate = _startDate;
+        header.interval = _interval;
+        header.numPoints = static_cast<boost::uint64_t>(_numPoints);
+
+        std::ofstream outFile(path.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+        outFile.write(reinterpret_cast<char const *>(&header), sizeof(header));
+        outFile.write(reinterpret_cast<char const *>(_records), _numPoints * sizeof(AppGeoEphemerisRecord));
+        outFile.close();
+        if (!outFile) {
+            std::ostringstream os;
+            os << "Cannot write ephemeris \"" << path << "\"";
+            throw std::runtime_error(os.str());
+        }
+    }
+
+    void AppGeoEphemeris::getAmprms(double *amprms, double date) const {
+        if (!contains(date)) {
+            std::ostringstream os;
+            os << std::setprecision(12) << "date = " << date << " not in range [" << getStartDate()
+                << ", " << getEndDate() << "] of ephemeris";
+            throw std::runtime_error(os.str());
+        }
+        if (_numPoints == 1) {
+            std::memcpy(amprms, _records[0].amprms, sizeof(_records[0].amprms));
+            return;
+        }
+
+        // cubic Hermite interpolation between grid points ind and ind + 1
+        double const x = (date - _startDate) / _interval;
+        int const ind = std::min(static_cast<int>(x), _numPoints - 2);
+        double const u = x - ind;
+        double const u2 = u * u;
+        double const u3 = u2 * u;
+        double const h00 = (2 * u3) - (3 * u2) + 1;
+        double const h10 = (u3 - (2 * u2) + u) * _interval;
+        double const h01 = (3 * u2) - (2 * u3);
+        double const h11 = (u3 - u2) * _interval;
+        AppGeoEphemerisRecord const &rec0 = _records[ind];
+        AppGeoEphemerisRecord const &rec1 = _records[ind + 1];
+        for (int j = 0; j < AmprmsSize; ++j) {
+            amprms[j] = (h00 * rec0.amprms[j]) + (h10 * rec0.rate[j]) + (h01 * rec1.amprms[j]) + (h11 * rec1.rate[j]);
+        }
+    }
+
+    AppGeoData::ConstPtr AppGeoEphemeris::getData(double date) const {
+        double amprms[AmprmsSize];
+        getAmprms(amprms, date);
+        return AppGeoData::ConstPtr(new AppGeoData(date, amprms));
+    }
+
+    std::string AppGeoEphemeris::__repr__() const {
+        std::ostringstream os;
+        os << *this;
+        return os.str();
+    }
+
+    std::ostream &operator<<(std::ostream &os, AppGeoEphemeris const &ephem) {
+        std::ios_base::fmtflags oldFlags = os.flags();
+        std::streamsize const oldPrecision = os.precision();
+        os << "AppGeoEphemeris(startDate=" << std::fixed << std::setprecision(6) << ephem.getStartDate()
+            << ", endDate=" << ephem.getEndDate()
+            << ", interval=" << std::setprecision(9) << ephem.getInterval()
+            << ", size=" << ephem.size() << ")" << std::setprecision(oldPrecision);
+        os.flags(oldFlags);
+        return os;
+    }
+
+}
@@ -1,15 +1,34 @@
+#include "coordConv/physConst.h"
 #include "coordConv/time.h"
 #include "coordConv/haDecFromAzAlt.h"
 #include "coordConv/mathUtils.h"
 #include "coordConv/appGeoFromAppTopo.h"
 
+namespace {
+    /*
+    Return the matrix that rotates az/alt to -HA/Dec (the matrix form of haDecFromAzAlt)
+
+    @param[in] lat  latitude of observer (deg)
+    */
+    Eigen::Matrix3d haDecMatFromLat(double lat) {
+        double sinLat, cosLat;
+        coordConv::sincosd(sinLat, cosLat, lat);
+        Eigen::Matrix3d haDecMat;
+        haDecMat <<
+             sinLat, 0.0, cosLat,
+                0.0, 1.0,    0.0,
+            -cosLat, 0.0, sinLat;
+        return haDecMat;
+    }
+}
+
 namespace coordConv {
 
     Coord appGeoFromAppTopo(Coord const &coord, Site const &site, double tai) {
 
         double const last = lastFromTAI(tai, site);
-        double const sinLAST = sind(last);
-        double const cosLAST = cosd(last);
+        double sinLAST, cosLAST;
+        sincosd(sinLAST, cosLAST, last);
         
         Eigen::Vector3d appTopoPos = coord.getVecPos();
 
@@ -38,4 +57,76 @@ namespace coordConv {
         return Coord(appGeoPos);
     }
 
+    void appGeoFromAppTopo(CoordArray &appGeoArr, CoordArray const &appTopoArr, Site const &site, double tai) {
+        // rows of the arrays are vectors, so (mat * vec) becomes (rowArr * mat.transpose());
+        // the math is otherwise identical to the Coord version
+        double const last = lastFromTAI(tai, site);
+        double sinLAST, cosLAST;
+        sincosd(sinLAST, cosLAST, last);
+
+        // rotate position from alt/az to -HA/Dec
+        Eigen::Matrix3d const haDecMat = haDecMatFromLat(site.corrLat);
+        Eigen::MatrixX3d pos = appTopoArr.pos * haDecMat.transpose();
+
+        // remove correction for diurnal aberration
+        Eigen::ArrayXd bMag = pos.rowwise().norm().array();
+        Eigen::ArrayXd diurAbScaleCorr = 1.0 + (site.diurAbMag * (pos.col(1).array() / bMag));
+        pos.col(1).array() -= site.diurAbMag * bMag;
+        pos.array().colwise() *= diurAbScaleCorr;
+
+        // correct position for diurnal parallax
+        pos.rowwise() += site.pos.transpose();
+
+        // rotate position from -HA/Dec to RA/Dec
+        Eigen::Matrix3d raDecMat;
+        raDecMat <<
+            + cosLAST, - sinLAST, 0.0,
+            + sinLAST, + cosLAST, 0.0,
+                  0.0,       0.0, 1.0;
+        appGeoArr.pos = pos * raDecMat.transpose();
+        appGeoArr.pm.setZero(appGeoArr.pos.rows(), 3);
+    }
+
+    Coord appGeoFromAppTopo(Eigen::Matrix3d &jacobian, Eigen::Vector3d &posRate, Coord const &coord, Site const &site, double tai) {
+        // the math is the same as the Coord version, but in matrix form
+        double const last = lastFromTAI(tai, site);
+        double sinLAST, cosLAST;
+        sincosd(sinLAST, cosLAST, last);
+
+        // rotation from alt/az to -HA/Dec
+        Eigen::Matrix3d const haDecMat = haDecMatFromLat(site.corrLat);
+
+        // jacobian of removing diurnal aberration:
+        // posB = diurAbScaleCorr * (posC - (diurAbMag * |posC| * yHat)), where diurAbScaleCorr = 1 + (diurAbMag * posC(1) / |posC|)
+        Eigen::Vector3d posC = haDecMat * coord.getVecPos();
+        double cMag = posC.norm();
+        Eigen::Vector3d unitC = posC / cMag;
+        Eigen::Vector3d const yHat = Eigen::Vector3d::UnitY();
+        double diurAbScaleCorr = 1.0 + (site.diurAbMag * unitC(1));
+        Eigen::Vector3d dScaleCorr = site.diurAbMag * (yHat - (unitC(1) * unitC)) / cMag;
+        Eigen::Matrix3d diurAbJacobian = ((posC - (site.diurAbMag * cMag * yHat)) * dScaleCorr.transpose())
+            + (diurAbScaleCorr * (Eigen::Matrix3d::Identity() - (site.diurAbMag * yHat * unitC.transpose())));
+
+        // rotation from -HA/Dec to RA/Dec and its derivative with respect to LAST (per radian)
+        Eigen::Matrix3d raDecMat, dRADecMat;
+        raDecMat <<
+            + cosLAST, - sinLAST, 0.0,
+            + sinLAST, + cosLAST, 0.0,
+                  0.0,       0.0, 1.0;
+        dRADecMat <<
+            - sinLAST, - cosLAST, 0.0,
+            + cosLAST, - sinLAST, 0.0,
+                  0.0,       0.0, 0.0;
+
+        Eigen::Vector3d posA = (diurAbScaleCorr * (posC - (site.diurAbMag * cMag * yHat))) + site.pos;
+        Eigen::Vector3d appGeoPos = raDecMat * posA;
+
+        jacobian = raDecMat * diurAbJacobian * haDecMat;
+
+        // LAST increases by SiderealPerSolar * 360 degrees per day of UT1 (or TAI)
+        double const lastRate = RadPerDeg * SiderealPerSolar * 360.0 / SecPerDay;
+        posRate = dRADecMat * posA * lastRate;
+        return Coord(appGeoPos);
+    }
+
 }
@@ -15,6 +15,23 @@ namespace coordConv {
         setDate(date);
     };
     
+    AppTopoCoordSys::AppTopoCoordSys(AppGeoCache::Ptr const &appGeoCachePtr, double date)
+    :
+        ApparentCoordSys("apptopo", date),
+        _appGeoCoordSys(appGeoCachePtr)
+    {
+        setDate(date);
+    };
+    
+    ConvertStatusEnum AppTopoCoordSys::getDateStatus(double date) const {
+        // matches _setDate, which only sets the date of the apparent geocentric coordinate system if date > 0
+        return (date > 0) ? _appGeoCoordSys.getDateStatus(_appGeoCoordSys.dateFromTAI(date)) : ConvertStatus_OK;
+    }
+
+    ConvertStatusEnum AppTopoCoordSys::getConvertStatus() const {
+        return _appGeoCoordSys.getConvertStatus();
+    }
+
     void AppTopoCoordSys::_setDate(double date) const {
         if (date > 0) {
             _appGeoCoordSys.setCurrDate(_appGeoCoordSys.dateFromTAI(date));
@@ -27,7 +44,7 @@ namespace coordConv {
     }
 
     CoordSys::Ptr AppTopoCoordSys::clone(double date) const {
-        return CoordSys::Ptr(new AppTopoCoordSys(date));
+        return CoordSys::Ptr(new AppTopoCoordSys(getAppGeoCache(), date));
     };
 
     Coord AppTopoCoordSys::fromFK5J2000(Coord const &coord, Site const &site) const {
@@ -40,6 +57,44 @@ namespace coordConv {
         return _appGeoCoordSys.toFK5J2000(appGeoCoord, site);
     };
 
+    void AppTopoCoordSys::fromFK5J2000(CoordArray &coordArr, CoordArray const &fk5J2000Arr, Site const &site) const {
+        _appGeoCoordSys.fromFK5J2000(coordArr, fk5J2000Arr, site);
+        appTopoFromAppGeo(coordArr, coordArr, site, _date);
+    };
+
+    void AppTopoCoordSys::toFK5J2000(CoordArray &fk5J2000Arr, CoordArray const &coordArr, Site const &site) const {
+        appGeoFromAppTopo(fk5J2000Arr, coordArr, site, _date);
+        _appGeoCoordSys.toFK5J2000(fk5J2000Arr, fk5J2000Arr, site);
+    };
+
+    Coord AppTopoCoordSys::fromFK5J2000(Eigen::Matrix3d &jacobian, Eigen::Vector3d &posRate, Coord const &coord, Site const &site) const {
+        Eigen::Matrix3d appGeoJacobian, appTopoJacobian;
+        Eigen::Vector3d appGeoPosRate, appTopoPosRate;
+        Coord appGeoCoord = _appGeoCoordSys.fromFK5J2000(appGeoJacobian, appGeoPosRate, coord, site);
+        Coord appTopoCoord = appTopoFromAppGeo(appTopoJacobian, appTopoPosRate, appGeoCoord, site, _date);
+        jacobian = appTopoJacobian * appGeoJacobian;
+        if (isCurrent()) {
+            posRate = (appTopoJacobian * appGeoPosRate) + appTopoPosRate;
+        } else {
+            posRate.setZero();
+        }
+        return appTopoCoord;
+    }
+
+    Coord AppTopoCoordSys::toFK5J2000(Eigen::Matrix3d &jacobian, Eigen::Vector3d &posRate, Coord const &coord, Site const &site) const {
+        Eigen::Matrix3d appGeoJacobian, fk5J2000Jacobian;
+        Eigen::Vector3d appGeoPosRate, fk5J2000PosRate;
+        Coord appGeoCoord = appGeoFromAppTopo(appGeoJacobian, appGeoPosRate, coord, site, _date);
+        Coord fk5J2000Coord = _appGeoCoordSys.toFK5J2000(fk5J2000Jacobian, fk5J2000PosRate, appGeoCoord, site);
+        jacobian = fk5J2000Jacobian * appGeoJacobian;
+        if (isCurrent()) {
+            posRate = (fk5J2000Jacobian * appGeoPosRate) + fk5J2000PosRate;
+        } else {
+            posRate.setZero();
+        }
+        return fk5J2000Coord;
+    }
+
     std::string AppTopoCoordSys::__repr__() const {
         std::ostringstream os;
         os << "AppTopoCoordSys(" << getDate() << ")";
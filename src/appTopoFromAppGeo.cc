@@ -1,16 +1,38 @@
+#include "coordConv/physConst.h"
 #include "coordConv/time.h"
 #include "coordConv/azAltFromHADec.h"
 #include "coordConv/mathUtils.h"
 #include "coordConv/appTopoFromAppGeo.h"
 
+namespace {
+    /*
+    Return the matrix that rotates -HA/Dec to az/alt (the matrix form of azAltFromHADec)
+
+    @param[in] lat  latitude of observer (deg)
+    */
+    Eigen::Matrix3d azAltMatFromLat(double lat) {
+        double sinLat, cosLat;
+        coordConv::sincosd(sinLat, cosLat, lat);
+        Eigen::Matrix3d azAltMat;
+        azAltMat <<
+            sinLat, 0.0, -cosLat,
+               0.0, 1.0,     0.0,
+            cosLat, 0.0,  sinLat;
+        return azAltMat;
+    }
+}
+
 namespace coordConv {
 
     Coord appTopoFromAppGeo(Coord const &coord, Site const &site, double tai) {
+        return appTopoFromAppGeoAtLAST(coord, site, lastFromTAI(tai, site));
+    }
+
+    Coord appTopoFromAppGeoAtLAST(Coord const &coord, Site const &site, double last) {
         Eigen::Vector3d appGeoPos = coord.getVecPos();
 
-        double const last = lastFromTAI(tai, site);
-        double const sinLAST = sind(last);
-        double const cosLAST = cosd(last);
+        double sinLAST, cosLAST;
+        sincosd(sinLAST, cosLAST, last);
 
         // rotate position and offset from RA/Dec to (-HA)/Dec
         Eigen::Vector3d posA;
@@ -37,4 +59,78 @@ namespace coordConv {
         return Coord(appTopoPos);
     }
 
+    void appTopoFromAppGeo(CoordArray &appTopoArr, CoordArray const &appGeoArr, Site const &site, double tai) {
+        // rows of the arrays are vectors, so (mat * vec) becomes (rowArr * mat.transpose());
+        // the math is otherwise identical to the Coord version
+        double const last = lastFromTAI(tai, site);
+        double sinLAST, cosLAST;
+        sincosd(sinLAST, cosLAST, last);
+
+        // rotate position from RA/Dec to (-HA)/Dec
+        Eigen::Matrix3d haDecMat;
+        haDecMat <<
+            + cosLAST, sinLAST, 0.0,
+            - sinLAST, cosLAST, 0.0,
+                  0.0,     0.0, 1.0;
+
+        // correct position for diurnal parallax
+        Eigen::MatrixX3d pos = (appGeoArr.pos * haDecMat.transpose()).rowwise() - site.pos.transpose();
+
+        // correct position for diurnal aberration
+        Eigen::ArrayXd bMag = pos.rowwise().norm().array();
+        Eigen::ArrayXd diurAbScaleCorr = 1.0 - (site.diurAbMag * (pos.col(1).array() / bMag));
+        pos.col(1).array() += site.diurAbMag * bMag;
+        pos.array().colwise() *= diurAbScaleCorr;
+
+        // rotate position from -HA/Dec to alt/az
+        Eigen::Matrix3d const azAltMat = azAltMatFromLat(site.corrLat);
+        appTopoArr.pos = pos * azAltMat.transpose();
+        appTopoArr.pm.setZero(appTopoArr.pos.rows(), 3);
+    }
+
+    Coord appTopoFromAppGeo(Eigen::Matrix3d &jacobian, Eigen::Vector3d &posRate, Coord const &coord, Site const &site, double tai) {
+        // the math is the same as the Coord version, but in matrix form
+        Eigen::Vector3d appGeoPos = coord.getVecPos();
+
+        double const last = lastFromTAI(tai, site);
+        double sinLAST, cosLAST;
+        sincosd(sinLAST, cosLAST, last);
+
+        // rotation from RA/Dec to (-HA)/Dec and its derivative with respect to LAST (per radian)
+        Eigen::Matrix3d haDecMat, dHADecMat;
+        haDecMat <<
+            + cosLAST, sinLAST, 0.0,
+            - sinLAST, cosLAST, 0.0,
+                  0.0,     0.0, 1.0;
+        dHADecMat <<
+            - sinLAST, + cosLAST, 0.0,
+            - cosLAST, - sinLAST, 0.0,
+                  0.0,       0.0, 0.0;
+
+        // jacobian of diurnal aberration:
+        // posC = diurAbScaleCorr * (posB + (diurAbMag * |posB| * yHat)), where diurAbScaleCorr = 1 - (diurAbMag * posB(1) / |posB|)
+        Eigen::Vector3d posB = (haDecMat * appGeoPos) - site.pos;
+        double bMag = posB.norm();
+        Eigen::Vector3d unitB = posB / bMag;
+        Eigen::Vector3d const yHat = Eigen::Vector3d::UnitY();
+        double diurAbScaleCorr = 1.0 - (site.diurAbMag * unitB(1));
+        Eigen::Vector3d dScaleCorr = - site.diurAbMag * (yHat - (unitB(1) * unitB)) / bMag;
+        Eigen::Matrix3d diurAbJacobian = ((posB + (site.diurAbMag * bMag * yHat)) * dScaleCorr.transpose())
+            + (diurAbScaleCorr * (Eigen::Matrix3d::Identity() + (site.diurAbMag * yHat * unitB.transpose())));
+
+        // rotation from -HA/Dec to alt/az
+        Eigen::Matrix3d const azAltMat = azAltMatFromLat(site.corrLat);
+
+        Eigen::Vector3d posC = diurAbScaleCorr * (posB + (site.diurAbMag * bMag * yHat));
+        Eigen::Vector3d appTopoPos = azAltMat * posC;
+
+        Eigen::Matrix3d posBJacobian = azAltMat * diurAbJacobian;
+        jacobian = posBJacobian * haDecMat;
+
+        // LAST increases by SiderealPerSolar * 360 degrees per day of UT1 (or TAI)
+        double const lastRate = RadPerDeg * SiderealPerSolar * 360.0 / SecPerDay;
+        posRate = posBJacobian * dHADecMat * appGeoPos * lastRate;
+        return Coord(appTopoPos);
+    }
+
 }
@@ -4,78 +4,157 @@
 
 namespace coordConv {
 
-    Coord appTopoFromObs(Coord const &obsCoord, Site const &site) {
+    namespace {
 
-        // For zdu > ZDu_Max the correction is computed at ZDu_Max.
-        // This is unphysical, but allows working with arbitrary positions.
-        // The model used (at this writing) is not much good beyond 83 degrees
-        // and going beyond ~87 requires more iterations to give reversibility
-        const double ZDu_Max = 85.0;
-        
-        Eigen::Vector3d obsPos = obsCoord.getVecPos();
+        /**
+        Compute apparent topocentric position from observed position; see appTopoFromObs for details
+
+        @param[in] obsPos  observed position
+        @param[in] site  site information
+        @param[in] tablePtr  refraction table; if null then refraction is computed directly
+        */
+        Eigen::Vector3d appTopoPosFromObsPos(Eigen::Vector3d const &obsPos, Site const &site,
+            RefractionTable const *tablePtr) {
+            // convert inputs to easy-to-read variables
+            double const xr = obsPos(0);
+            double const yr = obsPos(1);
+            double const zr = obsPos(2);
+
+            // useful quantities
+            double const rxymag = hypot(xr, yr);
+            double const rxysq = rxymag * rxymag;
+
+            // test input vector
+            if (rxysq * std::numeric_limits<double>::epsilon() <= std::numeric_limits<double>::min()) {
+               if ((rxysq + (zr * zr)) * std::numeric_limits<double>::epsilon() <= std::numeric_limits<double>::min()) {
+                    // |R| is too small to use -- probably a bug in the calling software
+                    throw std::runtime_error("obsPos too short");
+                } else {
+                    // at zenith; return obsPos
+                    return obsPos;
+                }
+            }
 
-        // convert inputs to easy-to-read variables
-        double const xr = obsPos(0);
-        double const yr = obsPos(1);
-        double const zr = obsPos(2);
+            double zdr = atan2d(rxymag, zr); // refracted zenith distance
+            if (tablePtr) {
+                Eigen::Vector3d appTopoPos;
+                appTopoPos << xr, yr, zFromZDChange(rxymag, zr, tablePtr->zduMinusZDr(zdr));
+                return appTopoPos;
+            }
 
-        // useful quantities
-        double const rxymag = hypot(xr, yr);
-        double const rxysq = rxymag * rxymag;
+            double zdu; // unrefracted zenith distance
 
-        // test input vector
-        if (rxysq * std::numeric_limits<double>::epsilon() <= std::numeric_limits<double>::min()) {
-           if ((rxysq + (zr * zr)) * std::numeric_limits<double>::epsilon() <= std::numeric_limits<double>::min()) {
-                // |R| is too small to use -- probably a bug in the calling software
-                throw std::runtime_error("obsPos too short");
+            // Compute the refraction correction. Compute it at the refracted zenith distance,
+            // unless that ZD is too large, in which case compute the correction at the
+            // maximum UNrefracted ZD (this provides reversibility with refract).
+            bool tooLow = false;
+            if (zdr > ZDu_Max) {
+               // zdr < zdu, so we're certainly past the limit
+               // don't even bother to try computing the standard correction
+               tooLow = true;
             } else {
-                // at zenith; return obsPos
-                return Coord(obsPos);
+                double tanZD = tand(zdr);
+                zdu = zdr + (site.refCoA * tanZD) + (site.refCoB * tanZD * tanZD * tanZD);
+                if (zdu > ZDu_Max) {
+                    tooLow = true;
+                }
             }
-        }
 
-        double zdr = atan2d(rxymag, zr); // refracted zenith distance
-        double zdu; // unrefracted zenith distance
-
-        // Compute the refraction correction. Compute it at the refracted zenith distance,
-        // unless that ZD is too large, in which case compute the correction at the
-        // maximum UNrefracted ZD (this provides reversibility with refract).
-        bool tooLow = false;
-        if (zdr > ZDu_Max) {
-           // zdr < zdu, so we're certainly past the limit
-           // don't even bother to try computing the standard correction
-           tooLow = true;
-        } else {
-            double tanZD = tand(zdr);
-            zdu = zdr + (site.refCoA * tanZD) + (site.refCoB * tanZD * tanZD * tanZD);
-            if (zdu > ZDu_Max) {
-                tooLow = true;
+            if (tooLow) {
+                // compute correction at zdu = ZDu_Max and use that instead
+                // (iteration is required because we want the correction at a known zdu, not at a known zdr)
+                double ZDr_u = 0.0;
+                double ZDu_iter = ZDu_Max;
+                for (int iter = 0; iter < 2; ++iter) {
+                    double ZDr_iter = ZDu_iter + ZDr_u;
+                    double cosZD = cosd(ZDr_iter);
+                    double tanZD = tand(ZDr_iter);
+                    ZDr_u = ZDr_u - ((ZDr_u + (site.refCoA * tanZD) + (site.refCoB * tanZD * tanZD * tanZD)) /
+                        (1.0 + (RadPerDeg * (site.refCoA + (3.0 * site.refCoB * tanZD * tanZD)) / (cosZD * cosZD))));
+                }
+                zdu = zdr - ZDr_u;
             }
+
+            // compute unrefracted position as a cartesian vector
+            Eigen::Vector3d appTopoPos;
+            appTopoPos <<
+                xr,
+                yr,
+                rxymag * tand(90.0 - zdu);
+            return appTopoPos;
         }
 
-        if (tooLow) {
-            // compute correction at zdu = ZDu_Max and use that instead
-            // (iteration is required because we want the correction at a known zdu, not at a known zdr)
-            double ZDr_u = 0.0;
-            double ZDu_iter = ZDu_Max;
-            for (int iter = 0; iter < 2; ++iter) {
-                double ZDr_iter = ZDu_iter + ZDr_u;
-                double cosZD = cosd(ZDr_iter);
-                double tanZD = tand(ZDr_iter);
-                ZDr_u = ZDr_u - ((ZDr_u + (site.refCoA * tanZD) + (site.refCoB * tanZD * tanZD * tanZD)) /
-                    (1.0 + (RadPerDeg * (site.refCoA + (3.0 * site.refCoB * tanZD * tanZD)) / (cosZD * cosZD))));
+        /**
+        Compute the jacobian of appTopoPosFromObsPos
+
+        @param[in] obsPos  observed position
+        @param[in] appTopoPos  apparent topocentric position, as computed by appTopoPosFromObsPos
+        @param[in] site  site information
+        */
+        Eigen::Matrix3d appTopoJacobianFromObsPos(Eigen::Vector3d const &obsPos, Eigen::Vector3d const &appTopoPos, Site const &site) {
+            // x and y are unchanged, so only the last row of the jacobian differs from the identity matrix
+            Eigen::Matrix3d jacobian = Eigen::Matrix3d::Identity();
+            double const x = obsPos(0);
+            double const y = obsPos(1);
+            double const z = obsPos(2);
+            double const rxymag = hypot(x, y);
+            if (rxymag * rxymag * std::numeric_limits<double>::epsilon() <= std::numeric_limits<double>::min()) {
+                // at zenith; output = input
+                return jacobian;
+            }
+            double const zdr = atan2d(rxymag, z);
+            // compute other functions of zdr and zdu directly from the positions, to avoid trig functions
+            double const rsq = (rxymag * rxymag) + (z * z);
+            double const zOut = appTopoPos(2);
+            double const rsqOut = (rxymag * rxymag) + (zOut * zOut);
+
+            // zdu = zdr + (refCoA * tan(zdr)) + (refCoB * tan^3(zdr)),
+            // unless that is too low, in which case zdu - zdr is constant
+            double dZDOut_dZDIn = 1.0;
+            if (zdr <= ZDu_Max) {
+                double tanZD = rxymag / z;
+                double cosSqZD = z * z / rsq;
+                double zduStd = zdr + (site.refCoA * tanZD) + (site.refCoB * tanZD * tanZD * tanZD);
+                if (zduStd <= ZDu_Max) {
+                    dZDOut_dZDIn = 1.0 + (RadPerDeg * (site.refCoA + (3.0 * site.refCoB * tanZD * tanZD)) / cosSqZD);
+                }
             }
-            zdu = zdr - ZDr_u;
+
+            // output z = rxymag * cot(zdu); compute its partial derivatives
+            // with respect to rxymag and zdr (radians), and those with respect to input x, y, z
+            double const sinSqZDOut = rxymag * rxymag / rsqOut;
+            double const dZOut_dRxy = zOut / rxymag;
+            double const dZOut_dZDIn = - rxymag * dZDOut_dZDIn / sinSqZDOut;
+            Eigen::Vector3d dRxy(x / rxymag, y / rxymag, 0.0);
+            Eigen::Vector3d dZDIn(z * x / (rxymag * rsq), z * y / (rxymag * rsq), - rxymag / rsq);
+            jacobian.row(2) = ((dZOut_dRxy * dRxy) + (dZOut_dZDIn * dZDIn)).transpose();
+            return jacobian;
+        }
+
+    }
+
+    Coord appTopoFromObs(Coord const &obsCoord, Site const &site) {
+        RefractionTable::ConstPtr tablePtr = getRefractionTable(site);
+        return Coord(appTopoPosFromObsPos(obsCoord.getVecPos(), site, tablePtr.get()));
+    }
+
+    void appTopoFromObs(CoordArray &appTopoArr, CoordArray const &obsArr, Site const &site) {
+        if (appTopoArr.size() != obsArr.size()) {
+            appTopoArr.resize(obsArr.size());
+        }
+        RefractionTable::ConstPtr tablePtr = getRefractionTable(site);
+        for (int i = 0; i < obsArr.size(); ++i) {
+            appTopoArr.pos.row(i) = appTopoPosFromObsPos(obsArr.pos.row(i).transpose(), site, tablePtr.get()).transpose();
         }
+        appTopoArr.pm.setZero();
+    }
 
-        // compute unrefracted position as a cartesian vector
-        Eigen::Vector3d appTopoPos;
-        appTopoPos <<
-            xr,
-            yr,
-            rxymag * tand(90.0 - zdu);
+    Coord appTopoFromObs(Eigen::Matrix3d &jacobian, Coord const &obsCoord, Site const &site) {
+        Eigen::Vector3d obsPos = obsCoord.getVecPos();
+        RefractionTable::ConstPtr tablePtr = getRefractionTable(site);
+        Eigen::Vector3d appTopoPos = appTopoPosFromObsPos(obsPos, site, tablePtr.get());
+        jacobian = appTopoJacobianFromObsPos(obsPos, appTopoPos, site);
         return Coord(appTopoPos);
     }
 
 }
-
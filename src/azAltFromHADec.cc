@@ -8,8 +8,8 @@ namespace coordConv {
         Eigen::Vector3d const &haDec,
         double lat
     ) {
-        const double sinLat = sind(lat);
-        const double cosLat = cosd(lat);
+        double sinLat, cosLat;
+        sincosd(sinLat, cosLat, lat);
 
         azAlt(0) = + sinLat * haDec(0) - cosLat * haDec(2);
         azAlt(1) = + haDec(1);
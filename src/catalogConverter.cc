@@ -0,0 +1,196 @@
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+#include "boost/interprocess/file_mapping.hpp"
+#include "boost/interprocess/mapped_region.hpp"
+#include "coordConv/coord.h"
+#include "coordConv/catalogConverter.h"
+
+namespace {
+    namespace bip = boost::interprocess;
+}
+
+namespace coordConv {
+
+    void coordArrayFromCatalog(CoordArray &coordArr, CatalogRecord const *records, std::size_t numRecords) {
+        int const numPos = static_cast<int>(numRecords);
+        if (coordArr.size() != numPos) {
+            coordArr.pos.resize(numPos, 3);
+            coordArr.pm.resize(numPos, 3);
+        }
+        // use the same math as Coord(equatAng, polarAng, parallax, equatPM, polarPM, radVel)
+        for (int i = 0; i < numPos; ++i) {
+            CatalogRecord const &rec = records[i];
+            Eigen::Vector3d const pos = Coord::vecPosFromSph(rec.equatAng, rec.polarAng, rec.parallax);
+            coordArr.pos.row(i) = pos.transpose();
+            coordArr.pm.row(i) = Coord::vecPMFromSph(rec.equatAng, rec.polarAng, pos.norm(),
+                rec.equatPM, rec.polarPM, rec.radVel).transpose();
+        }
+    }
+
+    void catalogFromCoordArray(CatalogRecord *records, CoordArray const &coordArr) {
+        // use the same math as Coord.getSphPos, getParallax, getPM and getRadVel
+        int const numPos = coordArr.size();
+        for (int i = 0; i < numPos; ++i) {
+            CatalogRecord &rec = records[i];
+            Eigen::Vector3d const pos = coordArr.pos.row(i).transpose();
+            Eigen::Vector3d const pm = coordArr.pm.row(i).transpose();
+            double const dist = pos.norm();
+            bool const atPole = Coord::isAtPole(pos, dist);
+
+            Coord::sphPosFromVec(rec.equatAng, rec.polarAng, pos, atPole);
+            rec.parallax = Coord::parallaxFromDist(dist);
+            Coord::sphPMFromVec(rec.equatPM, rec.polarPM, pos, pm, dist, atPole);
+            rec.radVel = Coord::radVelFromVec(pos, pm, dist);
+        }
+    }
+
+    MappedCatalog::MappedCatalog(std::string const &path)
+    :
+        _path(path),
+        _isWritable(false),
+        _numRecords(0),
+        _region()
+    {
+        std::ifstream inFile(path.c_str(), std::ios::in | std::ios::binary | std::ios::ate);
+        if (!inFile) {
+            std::ostringstream os;
+            os << "Cannot open catalog \"" << path << "\" for reading";
+            throw std::runtime_error(os.str());
+        }
+        std::size_t const numBytes = static_cast<std::size_t>(inFile.tellg());
+        if (numBytes % sizeof(CatalogRecord) != 0) {
+            std::ostringstream os;
+            os << "Catalog \"" << path << "\" has " << numBytes << " bytes, which is not a multiple of "
+                << sizeof(CatalogRecord) << " bytes per record";
+            throw std::runtime_error(os.str());
+        }
+        _numRecords = numBytes / sizeof(CatalogRecord);
+        if (_numRecords == 0) {
+            // an empty file cannot be mapped
+            return;
+        }
+        try {
+            bip::file_mapping mapping(path.c_str(), bip::read_only);
+            bip::mapped_region region(mapping, bip::read_only, 0, numBytes);
+            region.advise(bip::mapped_region::advice_sequential);
+            _region.swap(region);
+        } catch (bip::interprocess_exception const &e) {
+            std::ostringstream os;
+            os << "Cannot map catalog \"" << path << "\": " << e.what();
+            throw std::runtime_error(os.str());
+        }
+    }
+
+    MappedCatalog::MappedCatalog(std::string const &path, std::size_t numRecords)
+    :
+        _path(path),
+        _isWritable(true),
+        _numRecords(numRecords),
+        _region()
+    {
+        std::size_t const numBytes = numRecords * sizeof(CatalogRecord);
+        std::ofstream outFile(path.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+        if (outFile && (numBytes > 0)) {
+            outFile.seekp(numBytes - 1);
+            outFile.put('\0');
+        }
+        outFile.close();
+        if (!outFile) {
+            std::ostringstream os;
+            os << "Cannot create catalog \"" << path << "\" with " << numRecords << " records";
+            throw std::runtime_error(os.str());
+        }
+        if (numRecords == 0) {
+            // an empty file cannot be mapped
+            return;
+        }
+        try {
+            bip::file_mapping mapping(path.c_str(), bip::read_write);
+            bip::mapped_region region(mapping, bip::read_write, 0, numBytes);
+            _region.swap(region);
+        } catch (bip::interprocess_exception const &e) {
+            std::ostringstream os;
+            os << "Cannot map catalog \"" << path << "\": " << e.what();
+            throw std::runtime_error(os.str());
+        }
+    }
+
+    CatalogRecord *MappedCatalog::getWritableRecords() {
+        if (!_isWritable) {
+            std::ostringstream os;
+            os << "Catalog \"" << _path << "\" is mapped for reading only";
+            throw std::runtime_error(os.str());
+        }
+        return static_cast<CatalogRecord *>(_region.get_address());
+    }
+
+    void MappedCatalog::flush() {
+        if (_isWritable && (_numRecords > 0)) {
+            _region.flush();
+        }
+    }
+
+    CatalogConverter::CatalogConverter(CoordSys const &fromCoordSys, CoordSys const &toCoordSys, Site const &site,
+        double tai, int chunkSize)
+    :
+        _plan(fromCoordSys, toCoordSys, site, tai),
+        _chunkSize(chunkSize),
+        _fromArr(),
+        _toArr()
+    {
+        if (chunkSize < 1) {
+            std::ostringstream os;
+            os << "chunkSize = " << chunkSize << " must be >= 1";
+            throw std::invalid_argument(os.str());
+        }
+    }
+
+    void CatalogConverter::convert(CatalogRecord *toRecords, CatalogRecord const *fromRecords, std::size_t numRecords) {
+        for (std::size_t startInd = 0; startInd < numRecords; startInd += _chunkSize) {
+            std::size_t const numInChunk = std::min(static_cast<std::size_t>(_chunkSize), numRecords - startInd);
+            coordArrayFromCatalog(_fromArr, fromRecords + startInd, numInChunk);
+            _plan.convert(_toArr, _fromArr);
+            catalogFromCoordArray(toRecords + startInd, _toArr);
+        }
+    }
+
+    std::size_t CatalogConverter::convertFile(std::string const &toPath, std::string const &fromPath) {
+        MappedCatalog fromCatalog(fromPath);
+        MappedCatalog toCatalog(toPath, fromCatalog.size());
+        convert(toCatalog.getWritableRecords(), fromCatalog.getRecords(), fromCatalog.size());
+        toCatalog.flush();
+        return fromCatalog.size();
+    }
+
+    std::size_t CatalogConverter::streamFile(CatalogCallback const &callback, std::string const &fromPath) {
+        MappedCatalog fromCatalog(fromPath);
+        std::size_t const numRecords = fromCatalog.size();
+        if (numRecords == 0) {
+            return 0;
+        }
+        std::vector<CatalogRecord> toRecords(std::min(static_cast<std::size_t>(_chunkSize), numRecords));
+        for (std::size_t startInd = 0; startInd < numRecords; startInd += _chunkSize) {
+            std::size_t const numInChunk = std::min(static_cast<std::size_t>(_chunkSize), numRecords - startInd);
+            convert(&toRecords[0], fromCatalog.getRecords() + startInd, numInChunk);
+            callback(startInd, &toRecords[0], numInChunk);
+        }
+        return numRecords;
+    }
+
+    std::string CatalogConverter::__repr__() const {
+        std::ostringstream os;
+        os << *this;
+        return os.str();
+    }
+
+    std::ostream &operator<<(std::ostream &os, CatalogConverter const &catalogConverter) {
+        os << "CatalogConverter(" << catalogConverter.getPlan()
+            << ", chunkSize=" << catalogConverter.getChunkSize() << ")";
+        return os;
+    }
+
+}
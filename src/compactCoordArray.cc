@@ -0,0 +1,100 @@
+#include <sstream>
+#include <stdexcept>
+#include "coordConv/mathUtils.h"
+#include "coordConv/physConst.h"
+#include "coordConv/compactCoordArray.h"
+
+namespace coordConv {
+
+    CompactCoordArray::CompactCoordArray(int size)
+    :
+        dir(Eigen::MatrixX3f::Constant(size, 3, std::numeric_limits<float>::quiet_NaN())),
+        parallax(Eigen::VectorXf::Zero(size)),
+        pmRate(Eigen::MatrixX3f::Zero(size, 3))
+    { }
+
+    CompactCoordArray::CompactCoordArray(CoordArray const &coordArr)
+    :
+        dir(coordArr.size(), 3),
+        parallax(coordArr.size()),
+        pmRate(coordArr.size(), 3)
+    {
+        setCoordArray(0, coordArr);
+    }
+
+    void CompactCoordArray::resize(int size) {
+        dir.setConstant(size, 3, std::numeric_limits<float>::quiet_NaN());
+        parallax.setZero(size);
+        pmRate.setZero(size, 3);
+    }
+
+    Coord CompactCoordArray::getCoord(int ind) const {
+        _checkIndex(ind);
+        CoordArray coordArr;
+        getCoordArray(coordArr, ind, 1);
+        return coordArr.getCoord(0);
+    }
+
+    void CompactCoordArray::setCoord(int ind, Coord const &coord) {
+        _checkIndex(ind);
+        CoordArray coordArr(1);
+        coordArr.setCoord(0, coord);
+        setCoordArray(ind, coordArr);
+    }
+
+    void CompactCoordArray::getCoordArray(CoordArray &coordArr, int start, int num) const {
+        _checkRange(start, num);
+
+        // compute distance as Coord does (see distanceFromParallax)
+        Eigen::ArrayXd dist = AUPerParsec / parallax.segment(start, num).cast<double>().array().max(MinParallax);
+
+        // dir is rounded to float, so renormalize it to keep the distance accurate
+        Eigen::MatrixX3d unitPos = dir.middleRows(start, num).cast<double>();
+        Eigen::ArrayXd posScale = dist / unitPos.rowwise().norm().array();
+        coordArr.pos = (unitPos.array().colwise() * posScale).matrix();
+        coordArr.pm = (pmRate.middleRows(start, num).cast<double>().array().colwise() * dist).matrix();
+    }
+
+    void CompactCoordArray::setCoordArray(int start, CoordArray const &coordArr) {
+        int const num = coordArr.size();
+        _checkRange(start, num);
+
+        Eigen::ArrayXd dist = coordArr.pos.rowwise().norm().array();
+        dir.middleRows(start, num) = (coordArr.pos.array().colwise() / dist).cast<float>().matrix();
+        pmRate.middleRows(start, num) = (coordArr.pm.array().colwise() / dist).cast<float>().matrix();
+
+        // compute parallax as Coord does, including reporting 0 if at infinity (see Coord::atInfinity)
+        double const minInfDist = 0.9 * AUPerParsec / MinParallax;
+        for (int i = 0; i < num; ++i) {
+            parallax(start + i) = (dist(i) > minInfDist) ? 0.0f : static_cast<float>(AUPerParsec / dist(i));
+        }
+    }
+
+    std::string CompactCoordArray::__repr__() const {
+        std::ostringstream os;
+        os << *this;
+        return os.str();
+    }
+
+    void CompactCoordArray::_checkIndex(int ind) const {
+        if ((ind < 0) || (ind >= size())) {
+            std::ostringstream os;
+            os << "ind = " << ind << " not in range [0, " << size() << ")";
+            throw std::out_of_range(os.str());
+        }
+    }
+
+    void CompactCoordArray::_checkRange(int start, int num) const {
+        if ((start < 0) || (num < 0) || (start + num > size())) {
+            std::ostringstream os;
+            os << "range [" << start << ", " << start + num << ") not a subset of [0, " << size() << ")";
+            throw std::out_of_range(os.str());
+        }
+    }
+
+    std::ostream &operator<<(std::ostream &os, CompactCoordArray const &compactArr) {
+        os << "CompactCoordArray(size=" << compactArr.size() << ")";
+        return os;
+    }
+
+}
@@ -0,0 +1,124 @@
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+#include "coordConv/conversionPlan.h"
+
+namespace {
+
+    /*
+    Return a copy of a coordinate system; if the coordinate system is current, set the copy's date
+    */
+    coordConv::CoordSys::ConstPtr copyAtTAI(coordConv::CoordSys const &coordSys, double tai) {
+        coordConv::CoordSys::Ptr coordSysPtr = coordSys.clone();
+        if (coordSysPtr->isCurrent()) {
+            coordSysPtr->setCurrDate(coordSysPtr->dateFromTAI(tai));
+        }
+        return coordSysPtr;
+    }
+
+}
+
+namespace coordConv {
+
+    ConversionPlan::ConversionPlan(CoordSys const &fromCoordSys, CoordSys const &toCoordSys, Site const &site, double tai)
+    :
+        _fromCoordSysPtr(copyAtTAI(fromCoordSys, tai)),
+        _toCoordSysPtr(copyAtTAI(toCoordSys, tai)),
+        _site(site),
+        _tai(tai),
+        _isRotation(false),
+        _rotMat(Eigen::Matrix3d::Identity()),
+        _pmSpan(0),
+        _shortcutPtr()
+    {
+        Eigen::Matrix3d fromRotMat, toRotMat;
+        double fromPMSpan, toPMSpan;
+        if (_fromCoordSysPtr->getRotationToFK5J2000(fromRotMat, fromPMSpan)
+            && _toCoordSysPtr->getRotationToFK5J2000(toRotMat, toPMSpan)) {
+            // fk5J2000Pos = fromRotMat * (fromPos + (fromPMSpan * fromPM)) and
+            // toPos = toRotMat^T * (fk5J2000Pos - (toPMSpan * fk5J2000PM)), where fk5J2000PM = fromRotMat * fromPM,
+            // so toPos = (toRotMat^T * fromRotMat) * (fromPos + ((fromPMSpan - toPMSpan) * fromPM))
+            _isRotation = true;
+            _rotMat = toRotMat.transpose() * fromRotMat;
+            _pmSpan = fromPMSpan - toPMSpan;
+        } else {
+            _shortcutPtr = findConversionShortcut(*_fromCoordSysPtr, *_toCoordSysPtr);
+        }
+    }
+
+    Coord ConversionPlan::convert(Coord const &fromCoord) const {
+        if (_isRotation) {
+            if (!fromCoord.hasPM()) {
+                return Coord(_rotMat * fromCoord.getVecPos());
+            }
+            Eigen::Vector3d fromPM = fromCoord.getVecPM();
+            return Coord(_rotMat * (fromCoord.getVecPos() + (fromPM * _pmSpan)), _rotMat * fromPM);
+        }
+        if (_shortcutPtr) {
+            return _shortcutPtr->convert(*_fromCoordSysPtr, *_toCoordSysPtr, fromCoord, _site);
+        }
+        Coord fk5J2000Coord = _fromCoordSysPtr->toFK5J2000(fromCoord, _site);
+        return _toCoordSysPtr->fromFK5J2000(fk5J2000Coord, _site);
+    }
+
+    void ConversionPlan::convert(CoordArray &toCoordArr, CoordArray const &fromCoordArr) const {
+        if (_isRotation) {
+            // rows of the arrays are vectors, so (mat * vec) becomes (rowArr * mat.transpose())
+            if (!fromCoordArr.hasPM()) {
+                toCoordArr.pos = fromCoordArr.pos * _rotMat.transpose();
+                toCoordArr.pm.setZero(toCoordArr.pos.rows(), 3);
+                return;
+            }
+            // assign pos first, in case the arrays are the same
+            toCoordArr.pos = (fromCoordArr.pos + (fromCoordArr.pm * _pmSpan)) * _rotMat.transpose();
+            toCoordArr.pm = fromCoordArr.pm * _rotMat.transpose();
+            return;
+        }
+        if (_shortcutPtr) {
+            _shortcutPtr->convert(toCoordArr, *_fromCoordSysPtr, *_toCoordSysPtr, fromCoordArr, _site);
+            return;
+        }
+        CoordArray fk5J2000Arr;
+        _fromCoordSysPtr->toFK5J2000(fk5J2000Arr, fromCoordArr, _site);
+        _toCoordSysPtr->fromFK5J2000(toCoordArr, fk5J2000Arr, _site);
+    }
+
+    void ConversionPlan::convert(CompactCoordArray &toCompactArr, CompactCoordArray const &fromCompactArr,
+        int chunkSize
+    ) const {
+        if (chunkSize < 1) {
+            std::ostringstream os;
+            os << "chunkSize = " << chunkSize << " must be >= 1";
+            throw std::invalid_argument(os.str());
+        }
+        int const size = fromCompactArr.size();
+        if (&toCompactArr != &fromCompactArr) {
+            toCompactArr.resize(size);
+        }
+        CoordArray chunkArr;
+        for (int start = 0; start < size; start += chunkSize) {
+            int const num = std::min(chunkSize, size - start);
+            fromCompactArr.getCoordArray(chunkArr, start, num);
+            convert(chunkArr, chunkArr);
+            toCompactArr.setCoordArray(start, chunkArr);
+        }
+    }
+
+    std::string ConversionPlan::__repr__() const {
+        std::ostringstream os;
+        os << *this;
+        return os.str();
+    }
+
+    std::ostream &operator<<(std::ostream &os, ConversionPlan const &conversionPlan) {
+        std::ios_base::fmtflags oldFlags = os.flags();
+        std::streamsize const oldPrecision = os.precision();
+        os << "ConversionPlan(" << *conversionPlan.getFromCoordSys() << ", " << *conversionPlan.getToCoordSys()
+            << ", tai=" << std::fixed << std::setprecision(7) << conversionPlan.getTAI() << ")"
+            << std::setprecision(oldPrecision);
+        os.flags(oldFlags);
+        return os;
+    }
+
+}
@@ -0,0 +1,372 @@
+#include <map>
+#include <utility>
+#include "coordConv/appGeoFromAppTopo.h"
+#include "coordConv/appTopoFromAppGeo.h"
+#include "coordConv/appTopoFromObs.h"
+#include "coordConv/obsFromAppTopo.h"
+#include "coordConv/time.h"
+#include "coordConv/conversionShortcut.h"
+
+namespace {
+
+    // offset used to compute a jacobian by finite differences, as a fraction of distance (as in coordSys.cc)
+    const double JacobianRelDelta = 1e-7;
+
+    typedef std::pair<std::type_info const *, std::type_info const *> TypePair;
+
+    /*
+    Order TypePairs by the types they point to (std::type_info::before), since type_info objects are not unique
+    */
+    struct TypePairLess {
+        bool operator()(TypePair const &lhs, TypePair const &rhs) const {
+            if (*lhs.first != *rhs.first) {
+                return lhs.first->before(*rhs.first);
+            }
+            return lhs.second->before(*rhs.second);
+        }
+    };
+
+    typedef std::map<TypePair, coordConv::ConversionShortcut::ConstPtr, TypePairLess> ShortcutMap;
+
+    /*
+    Observed to apparent topocentric and back: only refraction, which does not depend on date
+    */
+    class ObsAppTopoShortcut : public coordConv::ConversionShortcut {
+    public:
+        /*
+        @param[in] fromObs  true to convert observed to apparent topocentric, false for the reverse
+        */
+        explicit ObsAppTopoShortcut(bool fromObs) : _fromObs(fromObs) {};
+
+        virtual bool canConvert(coordConv::CoordSys const &fromCoordSys, coordConv::CoordSys const &toCoordSys) const {
+            return fromCoordSys.getDate(false) == toCoordSys.getDate(false);
+        }
+
+        virtual coordConv::Coord convert(coordConv::CoordSys const &fromCoordSys, coordConv::CoordSys const &toCoordSys,
+            coordConv::Coord const &fromCoord, coordConv::Site const &site) const {
+            return _fromObs ? coordConv::appTopoFromObs(fromCoord, site) : coordConv::obsFromAppTopo(fromCoord, site);
+        }
+
+        virtual void convert(coordConv::CoordArray &toCoordArr,
+            coordConv::CoordSys const &fromCoordSys, coordConv::CoordSys const &toCoordSys,
+            coordConv::CoordArray const &fromCoordArr, coordConv::Site const &site) const {
+            if (_fromObs) {
+                coordConv::appTopoFromObs(toCoordArr, fromCoordArr, site);
+            } else {
+                coordConv::obsFromAppTopo(toCoordArr, fromCoordArr, site);
+            }
+        }
+
+        virtual coordConv::Coord convert(Eigen::Matrix3d &jacobian, Eigen::Vector3d &posRate,
+            coordConv::CoordSys const &fromCoordSys, coordConv::CoordSys const &toCoordSys,
+            coordConv::Coord const &fromCoord, coordConv::Site const &site) const {
+            posRate.setZero();
+            return _fromObs
+                ? coordConv::appTopoFromObs(jacobian, fromCoord, site)
+                : coordConv::obsFromAppTopo(jacobian, fromCoord, site);
+        }
+
+    private:
+        bool _fromObs;
+    };
+
+    /*
+    Apparent topocentric or observed to apparent geocentric
+
+    The conversion depends on date due to the rotation of the Earth,
+    so posRate is only nonzero if the initial coordinate system is current
+    (the same is true of converting via FK5 J2000).
+    */
+    class ToAppGeoShortcut : public coordConv::ConversionShortcut {
+    public:
+        /*
+        @param[in] fromObs  true to convert from observed, false to convert from apparent topocentric
+        */
+        explicit ToAppGeoShortcut(bool fromObs) : _fromObs(fromObs) {};
+
+        virtual bool canConvert(coordConv::CoordSys const &fromCoordSys, coordConv::CoordSys const &toCoordSys) const {
+            double const tai = fromCoordSys.getDate(false);
+            return (tai > 0) && (toCoordSys.getDate(false) == coordConv::julianEpochFromTAI(tai));
+        }
+
+        virtual coordConv::Coord convert(coordConv::CoordSys const &fromCoordSys, coordConv::CoordSys const &toCoordSys,
+            coordConv::Coord const &fromCoord, coordConv::Site const &site) const {
+            double const tai = fromCoordSys.getDate(false);
+            if (_fromObs) {
+                return coordConv::appGeoFromAppTopo(coordConv::appTopoFromObs(fromCoord, site), site, tai);
+            }
+            return coordConv::appGeoFromAppTopo(fromCoord, site, tai);
+        }
+
+        virtual void convert(coordConv::CoordArray &toCoordArr,
+            coordConv::CoordSys const &fromCoordSys, coordConv::CoordSys const &toCoordSys,
+            coordConv::CoordArray const &fromCoordArr, coordConv::Site const &site) const {
+            double const tai = fromCoordSys.getDate(false);
+            if (_fromObs) {
+                coordConv::appTopoFromObs(toCoordArr, fromCoordArr, site);
+                coordConv::appGeoFromAppTopo(toCoordArr, toCoordArr, site, tai);
+            } else {
+                coordConv::appGeoFromAppTopo(toCoordArr, fromCoordArr, site, tai);
+            }
+        }
+
+        virtual coordConv::Coord convert(Eigen::Matrix3d &jacobian, Eigen::Vector3d &posRate,
+            coordConv::CoordSys const &fromCoordSys, coordConv::CoordSys const &toCoordSys,
+            coordConv::Coord const &fromCoord, coordConv::Site const &site) const {
+            double const tai = fromCoordSys.getDate(false);
+            Eigen::Matrix3d appTopoJacobian = Eigen::Matrix3d::Identity();
+            coordConv::Coord const appTopoCoord = _fromObs
+                ? coordConv::appTopoFromObs(appTopoJacobian, fromCoord, site)
+                : fromCoord;
+            Eigen::Matrix3d appGeoJacobian;
+            coordConv::Coord const appGeoCoord = coordConv::appGeoFromAppTopo(appGeoJacobian, posRate,
+                appTopoCoord, site, tai);
+            jacobian = appGeoJacobian * appTopoJacobian;
+            if (!fromCoordSys.isCurrent()) {
+                posRate.setZero();
+            }
+            return appGeoCoord;
+        }
+
+    private:
+        bool _fromObs;
+    };
+
+    /*
+    Apparent geocentric to apparent topocentric or observed
+
+    The conversion depends on date due to the rotation of the Earth,
+    so posRate is only nonzero if the final coordinate system is current
+    (the same is true of converting via FK5 J2000).
+    */
+    class FromAppGeoShortcut : public coordConv::ConversionShortcut {
+    public:
+        /*
+        @param[in] toObs  true to convert to observed, false to convert to apparent topocentric
+        */
+        explicit FromAppGeoShortcut(bool toObs) : _toObs(toObs) {};
+
+        virtual bool canConvert(coordConv::CoordSys const &fromCoordSys, coordConv::CoordSys const &toCoordSys) const {
+            double const tai = toCoordSys.getDate(false);
+            return (tai > 0) && (fromCoordSys.getDate(false) == coordConv::julianEpochFromTAI(tai));
+        }
+
+        virtual coordConv::Coord convert(coordConv::CoordSys const &fromCoordSys, coordConv::CoordSys const &toCoordSys,
+            coordConv::Coord const &fromCoord, coordConv::Site const &site) const {
+            coordConv::Coord const appTopoCoord = coordConv::appTopoFromAppGeo(fromCoord, site, toCoordSys.getDate(false));
+            return _toObs ? coordConv::obsFromAppTopo(appTopoCoord, site) : appTopoCoord;
+        }
+
+        virtual void convert(coordConv::CoordArray &toCoordArr,
+            coordConv::CoordSys const &fromCoordSys, coordConv::CoordSys const &toCoordSys,
+            coordConv::CoordArray const &fromCoordArr, coordConv::Site const &site) const {
+            coordConv::appTopoFromAppGeo(toCoordArr, fromCoordArr, site, toCoordSys.getDate(false));
+            if (_toObs) {
+                coordConv::obsFromAppTopo(toCoordArr, toCoordArr, site);
+            }
+        }
+
+        virtual coordConv::Coord convert(Eigen::Matrix3d &jacobian, Eigen::Vector3d &posRate,
+            coordConv::CoordSys const &fromCoordSys, coordConv::CoordSys const &toCoordSys,
+            coordConv::Coord const &fromCoord, coordConv::Site const &site) const {
+            Eigen::Matrix3d appTopoJacobian;
+            Eigen::Vector3d appTopoPosRate;
+            coordConv::Coord const appTopoCoord = coordConv::appTopoFromAppGeo(appTopoJacobian, appTopoPosRate,
+                fromCoord, site, toCoordSys.getDate(false));
+            coordConv::Coord toCoord = appTopoCoord;
+            jacobian = appTopoJacobian;
+            posRate = appTopoPosRate;
+            if (_toObs) {
+                Eigen::Matrix3d obsJacobian;
+                toCoord = coordConv::obsFromAppTopo(obsJacobian, appTopoCoord, site);
+                jacobian = obsJacobian * appTopoJacobian;
+                posRate = obsJacobian * appTopoPosRate;
+            }
+            if (!toCoordSys.isCurrent()) {
+                posRate.setZero();
+            }
+            return toCoord;
+        }
+
+    private:
+        bool _toObs;
+    };
+
+    /*
+    Between two coordinate systems whose conversion to FK5 J2000 is a rotation and proper motion correction
+    (see CoordSys::getRotationToFK5J2000), fused into one rotation and proper motion correction
+    */
+    class RotationShortcut : public coordConv::ConversionShortcut {
+    public:
+        virtual bool canConvert(coordConv::CoordSys const &fromCoordSys, coordConv::CoordSys const &toCoordSys) const {
+            Eigen::Matrix3d rotMat;
+            double pmSpan;
+            return fromCoordSys.getRotationToFK5J2000(rotMat, pmSpan) && toCoordSys.getRotationToFK5J2000(rotMat, pmSpan);
+        }
+
+        virtual coordConv::Coord convert(coordConv::CoordSys const &fromCoordSys, coordConv::CoordSys const &toCoordSys,
+            coordConv::Coord const &fromCoord, coordConv::Site const &site) const {
+            Eigen::Matrix3d rotMat;
+            double pmSpan;
+            getRotation(rotMat, pmSpan, fromCoordSys, toCoordSys);
+            return rotate(rotMat, pmSpan, fromCoord);
+        }
+
+        virtual void convert(coordConv::CoordArray &toCoordArr,
+            coordConv::CoordSys const &fromCoordSys, coordConv::CoordSys const &toCoordSys,
+            coordConv::CoordArray const &fromCoordArr, coordConv::Site const &site) const {
+            Eigen::Matrix3d rotMat;
+            double pmSpan;
+            getRotation(rotMat, pmSpan, fromCoordSys, toCoordSys);
+            // rows of the arrays are vectors, so (mat * vec) becomes (rowArr * mat.transpose())
+            if (!fromCoordArr.hasPM()) {
+                toCoordArr.pos = fromCoordArr.pos * rotMat.transpose();
+                toCoordArr.pm.setZero(toCoordArr.pos.rows(), 3);
+                return;
+            }
+            // assign pos first, in case the arrays are the same
+            toCoordArr.pos = (fromCoordArr.pos + (fromCoordArr.pm * pmSpan)) * rotMat.transpose();
+            toCoordArr.pm = fromCoordArr.pm * rotMat.transpose();
+        }
+
+        virtual coordConv::Coord convert(Eigen::Matrix3d &jacobian, Eigen::Vector3d &posRate,
+            coordConv::CoordSys const &fromCoordSys, coordConv::CoordSys const &toCoordSys,
+            coordConv::Coord const &fromCoord, coordConv::Site const &site) const {
+            double pmSpan;
+            getRotation(jacobian, pmSpan, fromCoordSys, toCoordSys);
+            posRate.setZero();
+            return rotate(jacobian, pmSpan, fromCoord);
+        }
+
+    private:
+        /*
+        Compute the fused rotation and proper motion span (see ConversionPlan)
+
+        @param[out] rotMat  rotation matrix
+        @param[out] pmSpan  time over which to correct for proper motion (Julian years)
+        @param[in] fromCoordSys  initial coordinate system
+        @param[in] toCoordSys  final coordinate system
+        */
+        static void getRotation(Eigen::Matrix3d &rotMat, double &pmSpan,
+            coordConv::CoordSys const &fromCoordSys, coordConv::CoordSys const &toCoordSys) {
+            Eigen::Matrix3d fromRotMat, toRotMat;
+            double fromPMSpan, toPMSpan;
+            fromCoordSys.getRotationToFK5J2000(fromRotMat, fromPMSpan);
+            toCoordSys.getRotationToFK5J2000(toRotMat, toPMSpan);
+            rotMat = toRotMat.transpose() * fromRotMat;
+            pmSpan = fromPMSpan - toPMSpan;
+        }
+
+        /*
+        Apply a fused rotation and proper motion correction to a coordinate
+        */
+        static coordConv::Coord rotate(Eigen::Matrix3d const &rotMat, double pmSpan, coordConv::Coord const &fromCoord) {
+            if (!fromCoord.hasPM()) {
+                return coordConv::Coord(rotMat * fromCoord.getVecPos());
+            }
+            Eigen::Vector3d const fromPM = fromCoord.getVecPM();
+            return coordConv::Coord(rotMat * (fromCoord.getVecPos() + (fromPM * pmSpan)), rotMat * fromPM);
+        }
+    };
+
+    /*
+    Return a map containing the built-in shortcuts
+    */
+    boost::shared_ptr<const ShortcutMap> makeBuiltInShortcutMap() {
+        using namespace coordConv;
+        boost::shared_ptr<ShortcutMap> mapPtr(new ShortcutMap());
+        ShortcutMap &shortcutMap = *mapPtr;
+        shortcutMap[TypePair(&typeid(ObsCoordSys), &typeid(AppTopoCoordSys))].reset(new ObsAppTopoShortcut(true));
+        shortcutMap[TypePair(&typeid(AppTopoCoordSys), &typeid(ObsCoordSys))].reset(new ObsAppTopoShortcut(false));
+        shortcutMap[TypePair(&typeid(ObsCoordSys), &typeid(AppGeoCoordSys))].reset(new ToAppGeoShortcut(true));
+        shortcutMap[TypePair(&typeid(AppTopoCoordSys), &typeid(AppGeoCoordSys))].reset(new ToAppGeoShortcut(false));
+        shortcutMap[TypePair(&typeid(AppGeoCoordSys), &typeid(ObsCoordSys))].reset(new FromAppGeoShortcut(true));
+        shortcutMap[TypePair(&typeid(AppGeoCoordSys), &typeid(AppTopoCoordSys))].reset(new FromAppGeoShortcut(false));
+        ConversionShortcut::ConstPtr rotationShortcutPtr(new RotationShortcut());
+        shortcutMap[TypePair(&typeid(ICRSCoordSys), &typeid(ICRSCoordSys))] = rotationShortcutPtr;
+        shortcutMap[TypePair(&typeid(FK5CoordSys), &typeid(FK5CoordSys))] = rotationShortcutPtr;
+        shortcutMap[TypePair(&typeid(GalCoordSys), &typeid(GalCoordSys))] = rotationShortcutPtr;
+        return mapPtr;
+    }
+
+    // registered shortcuts; only access using atomic operations; replaced (never modified) when a shortcut is registered.
+    // Lookups see a consistent map, but are not lock-free: boost's atomic shared_ptr operations take a short spinlock
+    boost::shared_ptr<const ShortcutMap> shortcutMapPtr = makeBuiltInShortcutMap();
+
+    /*
+    Return the shortcut registered for the types of two coordinate systems; null if none
+    */
+    coordConv::ConversionShortcut::ConstPtr getRegisteredShortcut(
+        coordConv::CoordSys const &fromCoordSys, coordConv::CoordSys const &toCoordSys
+    ) {
+        boost::shared_ptr<const ShortcutMap> mapPtr = boost::atomic_load(&shortcutMapPtr);
+        if (!mapPtr) {
+            // not yet initialized (only possible during static initialization)
+            return coordConv::ConversionShortcut::ConstPtr();
+        }
+        ShortcutMap::const_iterator const iter = mapPtr->find(TypePair(&typeid(fromCoordSys), &typeid(toCoordSys)));
+        if (iter == mapPtr->end()) {
+            return coordConv::ConversionShortcut::ConstPtr();
+        }
+        return iter->second;
+    }
+
+}
+
+namespace coordConv {
+
+    void ConversionShortcut::convert(CoordArray &toCoordArr, CoordSys const &fromCoordSys, CoordSys const &toCoordSys,
+        CoordArray const &fromCoordArr, Site const &site) const {
+        if (toCoordArr.size() != fromCoordArr.size()) {
+            toCoordArr.resize(fromCoordArr.size());
+        }
+        for (int i = 0; i < fromCoordArr.size(); ++i) {
+            toCoordArr.setCoord(i, convert(fromCoordSys, toCoordSys, fromCoordArr.getCoord(i), site));
+        }
+    }
+
+    Coord ConversionShortcut::convert(Eigen::Matrix3d &jacobian, Eigen::Vector3d &posRate,
+        CoordSys const &fromCoordSys, CoordSys const &toCoordSys, Coord const &fromCoord, Site const &site) const {
+        Coord toCoord = convert(fromCoordSys, toCoordSys, fromCoord, site);
+        double const delta = fromCoord.getDistance() * JacobianRelDelta;
+        for (int j = 0; j < 3; ++j) {
+            Eigen::Vector3d offPos = fromCoord.getVecPos();
+            offPos(j) += delta;
+            Coord offCoord = convert(fromCoordSys, toCoordSys, Coord(offPos, fromCoord.getVecPM()), site);
+            jacobian.col(j) = (offCoord.getVecPos() - toCoord.getVecPos()) / delta;
+        }
+        posRate.setZero();
+        return toCoord;
+    }
+
+    void registerConversionShortcut(std::type_info const &fromType, std::type_info const &toType,
+        ConversionShortcut::ConstPtr const &shortcutPtr) {
+        // copy the map, modify the copy and publish it; loop in case another thread registers at the same time
+        while (true) {
+            boost::shared_ptr<const ShortcutMap> oldMapPtr = boost::atomic_load(&shortcutMapPtr);
+            boost::shared_ptr<ShortcutMap> newMapPtr(oldMapPtr ? new ShortcutMap(*oldMapPtr) : new ShortcutMap());
+            if (shortcutPtr) {
+                (*newMapPtr)[TypePair(&fromType, &toType)] = shortcutPtr;
+            } else {
+                newMapPtr->erase(TypePair(&fromType, &toType));
+            }
+            boost::shared_ptr<const ShortcutMap> newConstMapPtr(newMapPtr);
+            if (boost::atomic_compare_exchange(&shortcutMapPtr, &oldMapPtr, newConstMapPtr)) {
+                return;
+            }
+        }
+    }
+
+    ConversionShortcut::ConstPtr findConversionShortcut(CoordSys const &fromCoordSys, CoordSys const &toCoordSys) {
+        ConversionShortcut::ConstPtr shortcutPtr = getRegisteredShortcut(fromCoordSys, toCoordSys);
+        if (shortcutPtr && shortcutPtr->canConvert(fromCoordSys, toCoordSys)) {
+            return shortcutPtr;
+        }
+        return ConversionShortcut::ConstPtr();
+    }
+
+    bool hasConversionShortcut(CoordSys const &fromCoordSys, CoordSys const &toCoordSys) {
+        return bool(getRegisteredShortcut(fromCoordSys, toCoordSys));
+    }
+
+}
@@ -0,0 +1,37 @@
+#include <stdexcept>
+#include "coordConv/convertStatus.h"
+
+namespace coordConv {
+
+    char const *convertStatusMessage(ConvertStatusEnum status) {
+        switch (status) {
+            case ConvertStatus_OK:
+                return "OK";
+            case ConvertStatus_NotCurrent:
+                return "Cannot set current date; coordSys is not current";
+            case ConvertStatus_BadDate:
+                return "date must be finite and > 0";
+            case ConvertStatus_DateTooLarge:
+                return "date too large; should be TDB years";
+            case ConvertStatus_CacheNotValid:
+                return "cache not valid";
+            case ConvertStatus_AtPole:
+                return "cannot compute orientation or offset; at pole";
+            case ConvertStatus_UnknownMethod:
+                return "Unknown velocity or orientation method";
+        }
+        return "Unknown conversion status";
+    }
+
+    void throwIfFailed(ConvertStatusEnum status) {
+        switch (status) {
+            case ConvertStatus_OK:
+                return;
+            case ConvertStatus_UnknownMethod:
+                throw std::invalid_argument(convertStatusMessage(status));
+            default:
+                throw std::runtime_error(convertStatusMessage(status));
+        }
+    }
+
+}
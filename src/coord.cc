@@ -18,43 +18,30 @@ namespace coordConv {
     }
 
     Coord::Coord(double equatAng, double polarAng, double parallax) {
-        _setPosFromSph(equatAng, polarAng, parallax);
+        _pos = vecPosFromSph(equatAng, polarAng, parallax);
         _setCache();
         _pm.setZero();
+        _hasPM = false;
     }
 
     Coord::Coord(double equatAng, double polarAng, double parallax, double equatPM, double polarPM, double radVel) {
-        _setPosFromSph(equatAng, polarAng, parallax);
+        _pos = vecPosFromSph(equatAng, polarAng, parallax);
         _setCache();
 
-        const double RadPerYear_per_ArcsecPerCentury = RadPerDeg / (ArcsecPerDeg * 100.0);
-        const double AUPerYear_per_KmPerSec = SecPerDay * DaysPerYear / KmPerAU;
-
-        const double sinEquat = sind(equatAng);
-        const double cosEquat = cosd(equatAng);
-        const double sinPolar = sind(polarAng);
-        const double cosPolar = cosd(polarAng);;
-
-        // change units of proper motion from arcsec/century to au/year
-        // (multiply by distance and fix the units)
-        const double pmAUPerYear1 = equatPM * _dist * RadPerYear_per_ArcsecPerCentury;
-        const double pmAUPerYear2 = polarPM * _dist * RadPerYear_per_ArcsecPerCentury;
-
-        // change units of radial velocity from km/sec to au/year
-        const double radVelAUPerYear = radVel * AUPerYear_per_KmPerSec;
-//        const double radVelAUPerYear = _atInfinity ? 0 : radVel * AUPerYear_per_KmPerSec;
-
-        // compute velocity vector in au/year
-        _pm <<
-            - (pmAUPerYear2 * sinPolar * cosEquat) - (pmAUPerYear1 * cosPolar * sinEquat) + (radVelAUPerYear * cosPolar * cosEquat),
-            - (pmAUPerYear2 * sinPolar * sinEquat) + (pmAUPerYear1 * cosPolar * cosEquat) + (radVelAUPerYear * cosPolar * sinEquat),
-            + (pmAUPerYear2 * cosPolar)                                                   + (radVelAUPerYear * sinPolar);
+        // short-circuit fixed targets
+        _hasPM = (equatPM != 0) || (polarPM != 0) || (radVel != 0);
+        if (!_hasPM) {
+            _pm.setZero();
+            return;
+        }
+        _pm = vecPMFromSph(equatAng, polarAng, _dist, equatPM, polarPM, radVel);
     }
 
     Coord::Coord(Eigen::Vector3d const &pos)
     :
         _pos(pos),
-        _pm(Eigen::Vector3d::Constant(0.0))
+        _pm(Eigen::Vector3d::Constant(0.0)),
+        _hasPM(false)
     {
         _setCache();
     }
@@ -62,7 +49,8 @@ namespace coordConv {
     Coord::Coord(Eigen::Vector3d const &pos, Eigen::Vector3d const &pm)
     :
         _pos(pos),
-        _pm(pm)
+        _pm(pm),
+        _hasPM(!pm.isZero(0))
     {
         _setCache();
     }
@@ -70,72 +58,28 @@ namespace coordConv {
     Coord::Coord()
     :
         _pos(Eigen::Vector3d::Constant(DoubleNaN)),
-        _pm(Eigen::Vector3d::Constant(DoubleNaN))
+        _pm(Eigen::Vector3d::Constant(DoubleNaN)),
+        _hasPM(true)
     {
         _setCache();
     }
 
     double Coord::getParallax() const {
-        return _atInfinity ? 0 : AUPerParsec / _dist;
+        return parallaxFromDist(_dist);
     }
 
     bool Coord::getSphPos(double &equatAng, double &polarAng) const {
-        double x = _pos(0);
-        double y = _pos(1);
-        double z = _pos(2);
-
-        if (_atPole) {
-            equatAng = 0.0;
-            polarAng = (z > 0.0) ? 90.0 : -90.0;
-        } else {
-            double posXYMag = hypot(x, y);
-            equatAng = wrapPos(atan2d(y, x));
-            polarAng = atan2d(z, posXYMag);
-        }
+        sphPosFromVec(equatAng, polarAng, _pos, _atPole);
         return _atPole;
     }
     
     bool Coord::getPM(double &equatPM, double &polarPM) const {
-        double const ArcsecPerCentury_per_RadPerYear = 100.0 * ArcsecPerDeg / RadPerDeg;
-
-        double x  = _pos(0);
-        double y  = _pos(1);
-        double z  = _pos(2);
-        double vX = _pm(0);
-        double vY = _pm(1);
-        double vZ = _pm(2);
-    
-        // now that radial velocity has been computed
-        // handle the "at pole" case
-        if (_atPole) {
-           equatPM = 0.0;
-           polarPM = 0.0;
-           return _atPole;
-        }
-
-        // useful quantities
-        double magPxy = hypot(x, y);
-        double magPxySq  = magPxy * magPxy;
-        double magPSq = _dist * _dist;
-
-        // compute proper motion in rad per year,
-        // then convert to arcsec per century;
-        // the divisions are safe because:
-        // - magPxySq must have some reasonable minimum value,
-        //   else scFromCC would have set atPole true,
-        //   and that case has already been handled above
-        // - magPSq must have some reasonable minimum value,
-        //   else scFromCC would have set isOK false
-        equatPM = (((x * vY) - (y * vX)) / magPxySq) * ArcsecPerCentury_per_RadPerYear;
-        polarPM = (((vZ * magPxy) - ((z / magPxy) * ((x * vX) + (y * vY)))) / magPSq) * ArcsecPerCentury_per_RadPerYear;
+        sphPMFromVec(equatPM, polarPM, _pos, _pm, _dist, _atPole);
         return _atPole;
     }
     
     double Coord::getRadVel() const {
-        // compute radial velocity in (au/year) and convert to (km/s)
-        double const KMPerSec_per_AUPerYear = KmPerAU / (DaysPerYear * SecPerDay);
-        return (_pos / _dist).dot(_pm) * KMPerSec_per_AUPerYear;
-//        return _atInfinity ? 0 : _pos.dot(_pm) * KMPerSec_per_AUPerYear / _dist;
+        return radVelFromVec(_pos, _pm, _dist);
     }
     
     bool Coord::isfinite() const {
@@ -170,13 +114,22 @@ namespace coordConv {
     }
     
     Coord Coord::offset(double &toOrient, double fromOrient, double dist) const {
+        Coord toCoord;
+        throwIfFailed(tryOffset(toCoord, toOrient, fromOrient, dist));
+        return toCoord;
+    }
+
+    ConvertStatusEnum Coord::tryOffset(Coord &toCoord, double &toOrient, double fromOrient, double dist) const {
         if (atPole()) {
-            throw std::runtime_error("cannot offset; at pole");
+            toCoord = Coord();
+            toOrient = DoubleNaN;
+            return ConvertStatus_AtPole;
         }
         // short-circuit zero offset
         if (dist == 0) {
             toOrient = wrapCtr(fromOrient);
-            return *this;
+            toCoord = *this;
+            return ConvertStatus_OK;
         }
 
         // code is a minor adaptation of LSST afw Coord::offset
@@ -206,7 +159,9 @@ namespace coordConv {
         // - compute v
         Eigen::Vector3d u = Eigen::Vector3d(-_pos(1), _pos(0), 0) / hypot(_pos(0), _pos(1));
         Eigen::Vector3d w = (_pos / _dist).cross(u);
-        Eigen::Vector3d v = (cosd(fromOrient) * u) + (sind(fromOrient) * w);
+        double sinOrient, cosOrient;
+        sincosd(sinOrient, cosOrient, fromOrient);
+        Eigen::Vector3d v = (cosOrient * u) + (sinOrient * w);
 
         // take r x v to get the axis
         Eigen::Vector3d axisVector = (_pos / _dist).cross(v);
@@ -214,14 +169,15 @@ namespace coordConv {
         computeRotationMatrix(rotMat, axisVector, dist);
         Eigen::Vector3d toPos = rotMat * _pos;
         Eigen::Vector3d toVel = rotMat * _pm;
-        Coord toCoord(toPos, toVel);
-        double unwrappedToOrient = toCoord.orientationTo(*this) + 180.0;
+        Coord offCoord(toPos, toVel);
+        double unwrappedToOrient = offCoord.orientationTo(*this) + 180.0;
         if (!std::isfinite(unwrappedToOrient)) {
             // distance too small
             unwrappedToOrient = fromOrient;
         }
         toOrient = wrapCtr(unwrappedToOrient);
-        return toCoord;
+        toCoord = offCoord; // last, in case toCoord is this coord
+        return ConvertStatus_OK;
     }
 
     std::string Coord::__repr__() const {
@@ -230,7 +186,7 @@ namespace coordConv {
         return os.str();
     }
 
-    void Coord::_setPosFromSph(double equatAng, double polarAng, double parallax) {
+    Eigen::Vector3d Coord::vecPosFromSph(double equatAng, double polarAng, double parallax) {
         if ((polarAng < -90.0) || (polarAng > 90.0)) {
             std::ostringstream os;
             os << "polarAng = " << polarAng << " not in range [-90, 90]";
@@ -238,11 +194,111 @@ namespace coordConv {
         }
         
         double const dist = distanceFromParallax(parallax);
+        double sinEquat, cosEquat, sinPolar, cosPolar;
+        sincosd(sinEquat, cosEquat, equatAng);
+        sincosd(sinPolar, cosPolar, polarAng);
 
-        _pos <<
-            dist * cosd(polarAng) * cosd(equatAng),
-            dist * cosd(polarAng) * sind(equatAng),
-            dist * sind(polarAng);
+        return Eigen::Vector3d(
+            dist * cosPolar * cosEquat,
+            dist * cosPolar * sinEquat,
+            dist * sinPolar);
+    }
+
+    Eigen::Vector3d Coord::vecPMFromSph(double equatAng, double polarAng, double dist,
+        double equatPM, double polarPM, double radVel
+    ) {
+        const double RadPerYear_per_ArcsecPerCentury = RadPerDeg / (ArcsecPerDeg * 100.0);
+        const double AUPerYear_per_KmPerSec = SecPerDay * DaysPerYear / KmPerAU;
+
+        double sinEquat, cosEquat;
+        sincosd(sinEquat, cosEquat, equatAng);
+        double sinPolar, cosPolar;
+        sincosd(sinPolar, cosPolar, polarAng);
+
+        // change units of proper motion from arcsec/century to au/year
+        // (multiply by distance and fix the units)
+        const double pmAUPerYear1 = equatPM * dist * RadPerYear_per_ArcsecPerCentury;
+        const double pmAUPerYear2 = polarPM * dist * RadPerYear_per_ArcsecPerCentury;
+
+        // change units of radial velocity from km/sec to au/year
+        const double radVelAUPerYear = radVel * AUPerYear_per_KmPerSec;
+
+        // compute velocity vector in au/year
+        return Eigen::Vector3d(
+            - (pmAUPerYear2 * sinPolar * cosEquat) - (pmAUPerYear1 * cosPolar * sinEquat) + (radVelAUPerYear * cosPolar * cosEquat),
+            - (pmAUPerYear2 * sinPolar * sinEquat) + (pmAUPerYear1 * cosPolar * cosEquat) + (radVelAUPerYear * cosPolar * sinEquat),
+            + (pmAUPerYear2 * cosPolar)                                                   + (radVelAUPerYear * sinPolar));
+    }
+
+    bool Coord::isAtInfinity(double dist) {
+        return dist > 0.9 * AUPerParsec / MinParallax;
+    }
+
+    bool Coord::isAtPole(Eigen::Vector3d const &pos, double dist) {
+        // this test for atPole is based on reliably round-tripping equatPM to 6 digits
+        double xyFracMag = hypot(pos(0), pos(1)) / dist;
+        return xyFracMag * xyFracMag < std::numeric_limits<double>::epsilon();
+    }
+
+    double Coord::parallaxFromDist(double dist) {
+        return isAtInfinity(dist) ? 0 : AUPerParsec / dist;
+    }
+
+    void Coord::sphPosFromVec(double &equatAng, double &polarAng, Eigen::Vector3d const &pos, bool atPole) {
+        double x = pos(0);
+        double y = pos(1);
+        double z = pos(2);
+
+        if (atPole) {
+            equatAng = 0.0;
+            polarAng = (z > 0.0) ? 90.0 : -90.0;
+        } else {
+            double posXYMag = hypot(x, y);
+            equatAng = wrapPos(atan2d(y, x));
+            polarAng = atan2d(z, posXYMag);
+        }
+    }
+
+    void Coord::sphPMFromVec(double &equatPM, double &polarPM, Eigen::Vector3d const &pos,
+        Eigen::Vector3d const &pm, double dist, bool atPole
+    ) {
+        double const ArcsecPerCentury_per_RadPerYear = 100.0 * ArcsecPerDeg / RadPerDeg;
+
+        // handle the "at pole" case
+        if (atPole) {
+           equatPM = 0.0;
+           polarPM = 0.0;
+           return;
+        }
+
+        double x  = pos(0);
+        double y  = pos(1);
+        double z  = pos(2);
+        double vX = pm(0);
+        double vY = pm(1);
+        double vZ = pm(2);
+
+        // useful quantities
+        double magPxy = hypot(x, y);
+        double magPxySq  = magPxy * magPxy;
+        double magPSq = dist * dist;
+
+        // compute proper motion in rad per year,
+        // then convert to arcsec per century;
+        // the divisions are safe because:
+        // - magPxySq must have some reasonable minimum value,
+        //   else atPole would be true,
+        //   and that case has already been handled above
+        // - magPSq must have some reasonable minimum value,
+        //   else Coord::_setCache would have thrown
+        equatPM = (((x * vY) - (y * vX)) / magPxySq) * ArcsecPerCentury_per_RadPerYear;
+        polarPM = (((vZ * magPxy) - ((z / magPxy) * ((x * vX) + (y * vY)))) / magPSq) * ArcsecPerCentury_per_RadPerYear;
+    }
+
+    double Coord::radVelFromVec(Eigen::Vector3d const &pos, Eigen::Vector3d const &pm, double dist) {
+        // compute radial velocity in (au/year) and convert to (km/s)
+        double const KMPerSec_per_AUPerYear = KmPerAU / (DaysPerYear * SecPerDay);
+        return (pos / dist).dot(pm) * KMPerSec_per_AUPerYear;
     }
     
     void Coord::_setCache() {
@@ -254,10 +310,8 @@ namespace coordConv {
             os << "Magnitude of _pos = (" << _pos(0) << ", " << _pos(1) << ", " << _pos(2) << ") too small";
             throw std::runtime_error(os.str());
         }
-        _atInfinity = _dist > 0.9 * AUPerParsec / MinParallax;
-        // this test for atPole is based on reliably round-tripping equatPM to 6 digits
-        double xyFracMag = hypot(_pos(0), _pos(1)) / _dist;
-        _atPole = (xyFracMag * xyFracMag < std::numeric_limits<double>::epsilon());
+        _atInfinity = isAtInfinity(_dist);
+        _atPole = isAtPole(_pos, _dist);
     }
 
     std::ostream &operator<<(std::ostream &os, Coord const &coord) {
@@ -0,0 +1,67 @@
+#include <sstream>
+#include <stdexcept>
+#include "coordConv/mathUtils.h"
+#include "coordConv/coordArray.h"
+
+namespace coordConv {
+
+    CoordArray::CoordArray(int size)
+    :
+        pos(Eigen::MatrixX3d::Constant(size, 3, DoubleNaN)),
+        pm(Eigen::MatrixX3d::Zero(size, 3))
+    { }
+
+    CoordArray::CoordArray(Eigen::MatrixX3d const &pos)
+    :
+        pos(pos),
+        pm(Eigen::MatrixX3d::Zero(pos.rows(), 3))
+    { }
+
+    CoordArray::CoordArray(Eigen::MatrixX3d const &pos, Eigen::MatrixX3d const &pm)
+    :
+        pos(pos),
+        pm(pm)
+    {
+        if (pos.rows() != pm.rows()) {
+            std::ostringstream os;
+            os << "pos has " << pos.rows() << " rows != " << pm.rows() << " rows in pm";
+            throw std::invalid_argument(os.str());
+        }
+    }
+
+    void CoordArray::resize(int size) {
+        pos.setConstant(size, 3, DoubleNaN);
+        pm.setZero(size, 3);
+    }
+
+    Coord CoordArray::getCoord(int ind) const {
+        _checkIndex(ind);
+        return Coord(Eigen::Vector3d(pos.row(ind).transpose()), Eigen::Vector3d(pm.row(ind).transpose()));
+    }
+
+    void CoordArray::setCoord(int ind, Coord const &coord) {
+        _checkIndex(ind);
+        pos.row(ind) = coord.getVecPos().transpose();
+        pm.row(ind) = coord.getVecPM().transpose();
+    }
+
+    std::string CoordArray::__repr__() const {
+        std::ostringstream os;
+        os << *this;
+        return os.str();
+    }
+
+    void CoordArray::_checkIndex(int ind) const {
+        if ((ind < 0) || (ind >= size())) {
+            std::ostringstream os;
+            os << "ind = " << ind << " not in range [0, " << size() << ")";
+            throw std::out_of_range(os.str());
+        }
+    }
+
+    std::ostream &operator<<(std::ostream &os, CoordArray const &coordArr) {
+        os << "CoordArray(size=" << coordArr.size() << ")";
+        return os;
+    }
+
+}
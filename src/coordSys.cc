@@ -1,74 +1,366 @@
+#include <cmath>
 #include <sstream>
 #include <stdexcept>
-#include <vector>
 #include "boost/make_shared.hpp"
+#include "coordConv/mathUtils.h"
 #include "coordConv/coordSys.h"
+#include "coordConv/conversionShortcut.h"
+
+// offset used to compute a jacobian by finite differences, as a fraction of distance
+static const double JacobianRelDelta = 1e-7;
+
+/*
+Return the date of a coordinate system as a Julian epoch, for the purpose of correcting for proper motion;
+0 if the coordinate system has no date
+*/
+static double julianEpochFromCoordSys(coordConv::CoordSys const &coordSys) {
+    switch (coordSys.getDateType()) {
+        case coordConv::DateType_Julian:
+            return coordSys.getDate(false);
+        case coordConv::DateType_Besselian:
+            return coordConv::julianEpochFromTAI(coordConv::taiFromBesselianEpoch(coordSys.getDate(false)));
+        case coordConv::DateType_TAI:
+            return coordConv::julianEpochFromTAI(coordSys.getDate(false));
+        default:
+            return 0;
+    }
+}
+
+/*
+Compute unit vectors along increasing equatorial and polar angle at a position (which must not be at a pole)
+
+@param[out] equatDir  unit vector along increasing equatorial angle
+@param[out] polarDir  unit vector along increasing polar angle
+@param[in] pos  cartesian position
+@param[in] dist  |pos|
+*/
+static void computeTangentBasis(Eigen::Vector3d &equatDir, Eigen::Vector3d &polarDir, Eigen::Vector3d const &pos, double dist) {
+    double const rxy = coordConv::hypot(pos(0), pos(1));
+    equatDir << -pos(1) / rxy, pos(0) / rxy, 0;
+    // polarDir = unit pos x equatDir
+    double const zOverRDist = pos(2) / (rxy * dist);
+    polarDir << -pos(0) * zOverRDist, -pos(1) * zOverRDist, rxy / dist;
+}
 
 namespace coordConv {
 
     void CoordSys::setCurrDate(double date) const {
+        ConvertStatusEnum const status = trySetCurrDate(date);
+        if ((status == ConvertStatus_BadDate) || (status == ConvertStatus_DateTooLarge)) {
+            std::ostringstream os;
+            os << "date = " << date << ": " << convertStatusMessage(status);
+            throw std::runtime_error(os.str());
+        }
+        throwIfFailed(status);
+    }
+
+    ConvertStatusEnum CoordSys::trySetCurrDate(double date) const {
         if (!isCurrent()) {
-            throw std::runtime_error("Cannot set current date; coordSys is not current");
-        } else if (date <= 0) {
-            throw std::runtime_error("date must be > 0");
+            return ConvertStatus_NotCurrent;
+        } else if (!(date > 0) || !std::isfinite(date)) {
+            return ConvertStatus_BadDate;
+        }
+        ConvertStatusEnum const status = getDateStatus(date);
+        if (status != ConvertStatus_OK) {
+            return status;
         }
         _setDate(date);
+        return ConvertStatus_OK;
     }
-    
-    Coord CoordSys::convertFrom(CoordSys const &fromCoordSys, Coord const &fromCoord, Site const &site, double tai) const {
-        if (isCurrent()) {
-            setCurrDate(dateFromTAI(tai));
-        };
+
+    ConvertStatusEnum CoordSys::_prepareConversion(CoordSys const &toCoordSys, CoordSys const &fromCoordSys, double tai) {
+        ConvertStatusEnum status = ConvertStatus_OK;
+        if (toCoordSys.isCurrent()) {
+            status = toCoordSys.trySetCurrDate(toCoordSys.dateFromTAI(tai));
+            if (status != ConvertStatus_OK) {
+                return status;
+            }
+        }
         if (fromCoordSys.isCurrent()) {
-            fromCoordSys.setCurrDate(fromCoordSys.dateFromTAI(tai));
-        };
+            status = fromCoordSys.trySetCurrDate(fromCoordSys.dateFromTAI(tai));
+            if (status != ConvertStatus_OK) {
+                return status;
+            }
+        }
+        status = toCoordSys.getConvertStatus();
+        if (status != ConvertStatus_OK) {
+            return status;
+        }
+        return fromCoordSys.getConvertStatus();
+    }
+
+    CoordSys::ConstPtr CoordSys::snapshot(double tai) const {
+        if (!isCurrent()) {
+            return clone();
+        }
+        double date = dateFromTAI(tai);
+        if (date <= 0) {
+            std::ostringstream os;
+            os << "tai = " << tai << " gives date = " << date << "; date must be > 0";
+            throw std::runtime_error(os.str());
+        }
+        return clone(date);
+    }
+
+    Coord CoordSys::convertFrom(CoordSys const &fromCoordSys, Coord const &fromCoord, Site const &site, double tai) const {
+        Coord toCoord;
+        throwIfFailed(tryConvertFrom(toCoord, fromCoordSys, fromCoord, site, tai));
+        return toCoord;
+    }
+
+    ConvertStatusEnum CoordSys::tryConvertFrom(Coord &toCoord, CoordSys const &fromCoordSys, Coord const &fromCoord, Site const &site, double tai) const {
+        ConvertStatusEnum const status = _prepareConversion(*this, fromCoordSys, tai);
+        if (status != ConvertStatus_OK) {
+            toCoord = Coord();
+            return status;
+        }
+        ConversionShortcut::ConstPtr const shortcutPtr = findConversionShortcut(fromCoordSys, *this);
+        if (shortcutPtr) {
+            toCoord = shortcutPtr->convert(fromCoordSys, *this, fromCoord, site);
+            return ConvertStatus_OK;
+        }
         Coord icrsCoord = fromCoordSys.toFK5J2000(fromCoord, site);
-        return fromFK5J2000(icrsCoord, site);
+        toCoord = fromFK5J2000(icrsCoord, site);
+        return ConvertStatus_OK;
+    }
+
+    void CoordSys::toFK5J2000(CoordArray &fk5J2000Arr, CoordArray const &coordArr, Site const &site) const {
+        if (fk5J2000Arr.size() != coordArr.size()) {
+            fk5J2000Arr.resize(coordArr.size());
+        }
+        for (int i = 0; i < coordArr.size(); ++i) {
+            fk5J2000Arr.setCoord(i, toFK5J2000(coordArr.getCoord(i), site));
+        }
+    }
+
+    void CoordSys::fromFK5J2000(CoordArray &coordArr, CoordArray const &fk5J2000Arr, Site const &site) const {
+        if (coordArr.size() != fk5J2000Arr.size()) {
+            coordArr.resize(fk5J2000Arr.size());
+        }
+        for (int i = 0; i < fk5J2000Arr.size(); ++i) {
+            coordArr.setCoord(i, fromFK5J2000(fk5J2000Arr.getCoord(i), site));
+        }
+    }
+
+    Coord CoordSys::toFK5J2000(Eigen::Matrix3d &jacobian, Eigen::Vector3d &posRate, Coord const &coord, Site const &site) const {
+        Coord fk5J2000Coord = toFK5J2000(coord, site);
+        double const delta = coord.getDistance() * JacobianRelDelta;
+        for (int j = 0; j < 3; ++j) {
+            Eigen::Vector3d offPos = coord.getVecPos();
+            offPos(j) += delta;
+            Coord offCoord = toFK5J2000(Coord(offPos, coord.getVecPM()), site);
+            jacobian.col(j) = (offCoord.getVecPos() - fk5J2000Coord.getVecPos()) / delta;
+        }
+        posRate.setZero();
+        return fk5J2000Coord;
+    }
+
+    Coord CoordSys::fromFK5J2000(Eigen::Matrix3d &jacobian, Eigen::Vector3d &posRate, Coord const &coord, Site const &site) const {
+        Coord toCoord = fromFK5J2000(coord, site);
+        double const delta = coord.getDistance() * JacobianRelDelta;
+        for (int j = 0; j < 3; ++j) {
+            Eigen::Vector3d offPos = coord.getVecPos();
+            offPos(j) += delta;
+            Coord offCoord = fromFK5J2000(Coord(offPos, coord.getVecPM()), site);
+            jacobian.col(j) = (offCoord.getVecPos() - toCoord.getVecPos()) / delta;
+        }
+        posRate.setZero();
+        return toCoord;
+    }
+
+    void CoordSys::convertFrom(CoordArray &toCoordArr, CoordSys const &fromCoordSys, CoordArray const &fromCoordArr, Site const &site, double tai) const {
+        throwIfFailed(tryConvertFrom(toCoordArr, fromCoordSys, fromCoordArr, site, tai));
     }
 
-    PVTCoord CoordSys::convertFrom(CoordSys const &fromCoordSys, PVTCoord const &fromPVTCoord, Site const &site) const {
-        std::vector<Coord> coordArr;
+    ConvertStatusEnum CoordSys::tryConvertFrom(CoordArray &toCoordArr, CoordSys const &fromCoordSys, CoordArray const &fromCoordArr, Site const &site, double tai) const {
+        ConvertStatusEnum const status = _prepareConversion(*this, fromCoordSys, tai);
+        if (status != ConvertStatus_OK) {
+            return status;
+        }
+        ConversionShortcut::ConstPtr const shortcutPtr = findConversionShortcut(fromCoordSys, *this);
+        if (shortcutPtr) {
+            shortcutPtr->convert(toCoordArr, fromCoordSys, *this, fromCoordArr, site);
+            return ConvertStatus_OK;
+        }
+        CoordArray icrsArr;
+        fromCoordSys.toFK5J2000(icrsArr, fromCoordArr, site);
+        fromFK5J2000(toCoordArr, icrsArr, site);
+        return ConvertStatus_OK;
+    }
+
+    PVTCoord CoordSys::convertFrom(CoordSys const &fromCoordSys, PVTCoord const &fromPVTCoord, Site const &site, VelocityMethodEnum velMethod) const {
+        PVTCoord toPVTCoord;
+        throwIfFailed(tryConvertFrom(toPVTCoord, fromCoordSys, fromPVTCoord, site, velMethod));
+        return toPVTCoord;
+    }
+
+    ConvertStatusEnum CoordSys::tryConvertFrom(PVTCoord &toPVTCoord, CoordSys const &fromCoordSys, PVTCoord const &fromPVTCoord, Site const &site, VelocityMethodEnum velMethod) const {
         double const tai = fromPVTCoord.getTAI();
-        for (int i = 0; i < 2; ++i) {
-            double evalTAI = tai + (i * DeltaTForPos);
-            coordArr.push_back(convertFrom(fromCoordSys, fromPVTCoord.getCoord(evalTAI), site, evalTAI));
+        if (velMethod == VelocityMethod_TwoPoint) {
+            Coord coordPair[2];
+            for (int i = 0; i < 2; ++i) {
+                double evalTAI = tai + (i * DeltaTForPos);
+                ConvertStatusEnum const status = tryConvertFrom(coordPair[i], fromCoordSys, fromPVTCoord.getCoord(evalTAI), site, evalTAI);
+                if (status != ConvertStatus_OK) {
+                    toPVTCoord = PVTCoord();
+                    return status;
+                }
+            }
+            toPVTCoord = PVTCoord(coordPair[0], coordPair[1], tai, DeltaTForPos);
+            return ConvertStatus_OK;
+        } else if (velMethod != VelocityMethod_Analytic) {
+            toPVTCoord = PVTCoord();
+            return ConvertStatus_UnknownMethod;
+        }
+
+        ConvertStatusEnum const status = _prepareConversion(*this, fromCoordSys, tai);
+        if (status != ConvertStatus_OK) {
+            toPVTCoord = PVTCoord();
+            return status;
+        }
+        ConversionShortcut::ConstPtr const shortcutPtr = findConversionShortcut(fromCoordSys, *this);
+        if (shortcutPtr) {
+            Eigen::Matrix3d jacobian;
+            Eigen::Vector3d posRate;
+            Coord toCoord = shortcutPtr->convert(jacobian, posRate, fromCoordSys, *this, fromPVTCoord.getCoord(), site);
+            toPVTCoord = PVTCoord(toCoord, (jacobian * fromPVTCoord.getVel()) + posRate, tai);
+            return ConvertStatus_OK;
         }
-        return PVTCoord(coordArr[0], coordArr[1], tai, DeltaTForPos);
+        Eigen::Matrix3d fromJacobian, toJacobian;
+        Eigen::Vector3d fromPosRate, toPosRate;
+        Coord icrsCoord = fromCoordSys.toFK5J2000(fromJacobian, fromPosRate, fromPVTCoord.getCoord(), site);
+        Coord toCoord = fromFK5J2000(toJacobian, toPosRate, icrsCoord, site);
+        Eigen::Vector3d icrsVel = (fromJacobian * fromPVTCoord.getVel()) + fromPosRate;
+        toPVTCoord = PVTCoord(toCoord, (toJacobian * icrsVel) + toPosRate, tai);
+        return ConvertStatus_OK;
     }
 
-    Coord CoordSys::convertFrom(double &toDir, double &scaleChange, CoordSys const &fromCoordSys, Coord const &fromCoord, double fromDir, Site const &site, double tai) const {
-        double const OffsetLength = 1e-3;
-        Coord toCoord = convertFrom(fromCoordSys, fromCoord, site, tai);
-        double dumDir;
-        Coord offFromCoord = fromCoord.offset(dumDir, fromDir, OffsetLength);
-        Coord offToCoord = convertFrom(fromCoordSys, offFromCoord, site, tai);
-        scaleChange = toCoord.angularSeparation(offToCoord) / OffsetLength;
-        toDir = toCoord.orientationTo(offToCoord);
+    Coord CoordSys::convertFrom(double &toDir, double &scaleChange, CoordSys const &fromCoordSys, Coord const &fromCoord, double fromDir, Site const &site, double tai, OrientationMethodEnum orientMethod) const {
+        Coord toCoord;
+        throwIfFailed(tryConvertFrom(toCoord, toDir, scaleChange, fromCoordSys, fromCoord, fromDir, site, tai, orientMethod));
         return toCoord;
     }
 
-    PVTCoord CoordSys::convertFrom(PVT &toDir, double &scaleChange, CoordSys const &fromCoordSys, PVTCoord const &fromPVTCoord, PVT const &fromDir, Site const &site) const {
-        std::vector<Coord> coordArr;
+    ConvertStatusEnum CoordSys::tryConvertFrom(Coord &toCoord, double &toDir, double &scaleChange, CoordSys const &fromCoordSys, Coord const &fromCoord, double fromDir, Site const &site, double tai, OrientationMethodEnum orientMethod) const {
+        ConvertStatusEnum status = ConvertStatus_OK;
+        if ((orientMethod != OrientationMethod_Analytic) && (orientMethod != OrientationMethod_Offset)) {
+            status = ConvertStatus_UnknownMethod;
+        } else if (fromCoord.atPole()) {
+            status = ConvertStatus_AtPole;
+        } else {
+            status = _prepareConversion(*this, fromCoordSys, tai);
+        }
+        if (status != ConvertStatus_OK) {
+            toCoord = Coord();
+            toDir = DoubleNaN;
+            scaleChange = DoubleNaN;
+            return status;
+        }
+
+        // converting FK4 proper motion to FK5 depends on position, which the position jacobian does not capture,
+        // so use the offset method for FK4 with proper motion (FK4 is rarely used, so keep it simple)
+        bool const isFK4 = (getDateType() == DateType_Besselian) || (fromCoordSys.getDateType() == DateType_Besselian);
+        if (isFK4 && !(fromCoord.getVecPM().array() == 0.0).all()) {
+            orientMethod = OrientationMethod_Offset;
+        }
+
+        if (orientMethod == OrientationMethod_Offset) {
+            // the dates are already set and fromCoord is not at a pole, so these cannot fail
+            double const OffsetLength = 1e-3;
+            double dumDir;
+            Coord offFromCoord, convCoord, offToCoord;
+            fromCoord.tryOffset(offFromCoord, dumDir, fromDir, OffsetLength);
+            tryConvertFrom(convCoord, fromCoordSys, fromCoord, site, tai);
+            tryConvertFrom(offToCoord, fromCoordSys, offFromCoord, site, tai);
+            scaleChange = convCoord.angularSeparation(offToCoord) / OffsetLength;
+            toDir = convCoord.orientationTo(offToCoord);
+            toCoord = convCoord;
+            return ConvertStatus_OK;
+        }
+
+        // jacobian of the whole conversion; posRate is not needed
+        Eigen::Matrix3d jacobian;
+        Eigen::Vector3d posRate;
+        Coord convCoord;
+        ConversionShortcut::ConstPtr const shortcutPtr = findConversionShortcut(fromCoordSys, *this);
+        if (shortcutPtr) {
+            convCoord = shortcutPtr->convert(jacobian, posRate, fromCoordSys, *this, fromCoord, site);
+        } else {
+            Eigen::Matrix3d fromJacobian, toJacobian;
+            Coord icrsCoord = fromCoordSys.toFK5J2000(fromJacobian, posRate, fromCoord, site);
+            convCoord = fromFK5J2000(toJacobian, posRate, icrsCoord, site);
+            jacobian = toJacobian * fromJacobian;
+        }
+
+        // propagate an offset along fromDir (per radian of arc) through the conversion,
+        // then measure it in the tangent plane at toCoord.
+        // The offset is an infinitesimal rotation about axis rotAxis, applied to position and proper motion
+        // (as in OrientationMethod_Offset); the jacobian is with respect to position, and proper motion
+        // affects position as (pmSpan * proper motion), so add the equivalent change in position.
+        Eigen::Vector3d fromEquatDir, fromPolarDir;
+        computeTangentBasis(fromEquatDir, fromPolarDir, fromCoord.getVecPos(), fromCoord.getDistance());
+        double sinFromDir, cosFromDir;
+        sincosd(sinFromDir, cosFromDir, fromDir);
+        Eigen::Vector3d const offsetDir = (cosFromDir * fromEquatDir) + (sinFromDir * fromPolarDir);
+        Eigen::Vector3d fromOffset = fromCoord.getDistance() * offsetDir;
+        if (fromCoordSys.isMean()) {
+            double const pmSpan = julianEpochFromCoordSys(*this) - julianEpochFromCoordSys(fromCoordSys);
+            Eigen::Vector3d const rotAxis = (fromCoord.getVecPos() / fromCoord.getDistance()).cross(offsetDir);
+            fromOffset += pmSpan * rotAxis.cross(fromCoord.getVecPM());
+        }
+        Eigen::Vector3d const toOffset = jacobian * fromOffset;
+        if (convCoord.atPole()) {
+            Eigen::Vector3d const toU = convCoord.getVecPos() / convCoord.getDistance();
+            scaleChange = (toOffset - (toU.dot(toOffset) * toU)).norm() / convCoord.getDistance();
+            toDir = DoubleNaN;
+            toCoord = convCoord;
+            return ConvertStatus_OK;
+        }
+        Eigen::Vector3d toEquatDir, toPolarDir;
+        computeTangentBasis(toEquatDir, toPolarDir, convCoord.getVecPos(), convCoord.getDistance());
+        double const equatOffset = toEquatDir.dot(toOffset) / convCoord.getDistance();
+        double const polarOffset = toPolarDir.dot(toOffset) / convCoord.getDistance();
+        scaleChange = hypot(equatOffset, polarOffset);
+        toDir = atan2d(polarOffset, equatOffset);
+        toCoord = convCoord;
+        return ConvertStatus_OK;
+    }
+
+    PVTCoord CoordSys::convertFrom(PVT &toDir, double &scaleChange, CoordSys const &fromCoordSys, PVTCoord const &fromPVTCoord, PVT const &fromDir, Site const &site, OrientationMethodEnum orientMethod) const {
+        PVTCoord toPVTCoord;
+        throwIfFailed(tryConvertFrom(toPVTCoord, toDir, scaleChange, fromCoordSys, fromPVTCoord, fromDir, site, orientMethod));
+        return toPVTCoord;
+    }
+
+    ConvertStatusEnum CoordSys::tryConvertFrom(PVTCoord &toPVTCoord, PVT &toDir, double &scaleChange, CoordSys const &fromCoordSys, PVTCoord const &fromPVTCoord, PVT const &fromDir, Site const &site, OrientationMethodEnum orientMethod) const {
+        Coord coordPair[2];
         double toDirPair[2], scaleChangePair[2];
         double const tai = fromPVTCoord.getTAI();
         for (int i = 0; i < 2; ++i) {
             double evalTAI = tai + (i * DeltaTForPos);
-            coordArr.push_back(convertFrom(toDirPair[i], scaleChangePair[i],
-                fromCoordSys, fromPVTCoord.getCoord(evalTAI), fromDir.getPos(evalTAI), site, evalTAI));
+            ConvertStatusEnum const status = tryConvertFrom(coordPair[i], toDirPair[i], scaleChangePair[i],
+                fromCoordSys, fromPVTCoord.getCoord(evalTAI), fromDir.getPos(evalTAI), site, evalTAI, orientMethod);
+            if (status != ConvertStatus_OK) {
+                toPVTCoord = PVTCoord();
+                toDir.invalidate(tai);
+                scaleChange = DoubleNaN;
+                return status;
+            }
         }
         scaleChange = scaleChangePair[0];
         toDir.setFromPair(toDirPair, tai, DeltaTForPos, true);
-        return PVTCoord(coordArr[0], coordArr[1], tai, DeltaTForPos);
+        toPVTCoord = PVTCoord(coordPair[0], coordPair[1], tai, DeltaTForPos);
+        return ConvertStatus_OK;
     }
 
     PVTCoord CoordSys::removePM(PVTCoord const &pvtCoord) {
-        std::vector<Coord> coordArr;
+        Coord coordPair[2];
         double const tai = pvtCoord.getTAI();
         for (int i = 0; i < 2; ++i) {
             double evalTAI = tai + (i * DeltaTForPos);
-            coordArr.push_back(removePM(pvtCoord.getCoord(evalTAI), evalTAI));
+            coordPair[i] = removePM(pvtCoord.getCoord(evalTAI), evalTAI);
         }
-        return PVTCoord(coordArr[0], coordArr[1], tai, DeltaTForPos);
+        return PVTCoord(coordPair[0], coordPair[1], tai, DeltaTForPos);
     }
 
     CoordSys::Ptr makeCoordSys(std::string const &name, double date) {
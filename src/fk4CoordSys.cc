@@ -67,50 +67,43 @@ namespace {
     static const Eigen::Map<const Eigen::Matrix3d> toFK5J2000PV(_toFK5J2000PVCArr);
     static const Eigen::Map<const Eigen::Matrix3d> toFK5J2000VP(_toFK5J2000VPCArr);
     static const Eigen::Map<const Eigen::Matrix3d> toFK5J2000VV(_toFK5J2000VVCArr);
-}
-
-namespace coordConv {
 
-    FK4CoordSys::FK4CoordSys(double date)
-    :
-        MeanCoordSys("fk4", date, DateType_Besselian),
-        _eTerms(),
-        _From1950PrecMat(),
-        _To1950PrecMat()
-    {
-        setDate(date);
-    };
+    /*
+    Compute the date-dependent data for FK4 at a given date
 
-    CoordSys::Ptr FK4CoordSys::clone() const {
-        return clone(getDate());
-    }
-
-    CoordSys::Ptr FK4CoordSys::clone(double date) const {
-        return CoordSys::Ptr(new FK4CoordSys(date));
-    };
-    
-    void FK4CoordSys::_setDate(double date) const {
-        if (date == 0) {
-            throw std::runtime_error("date must not be 0 for FK5CoordSys");
-        }
-        this->_date = date;
-        if (std::isfinite(date)) {
-            // note: slaEtrms and slaPrebn both want Besselian date
-            double eTermsCArr[3], from1950PrecCArr[3][3], to1950PrecCArr[3][3];
-            slaEtrms(date, eTermsCArr);
-            slaPrebn(1950.0, date, from1950PrecCArr);
-            slaPrebn(date, 1950.0, to1950PrecCArr);
-            for (int i = 0; i < 3; ++i) {
-                for (int j = 0; j < 3; ++j) {
-                    _From1950PrecMat(i,j) = from1950PrecCArr[i][j];
-                      _To1950PrecMat(i,j) =   to1950PrecCArr[i][j];
-                }
-                _eTerms(i) = eTermsCArr[i];
+    @param[out] eTerms  e-terms of aberration
+    @param[out] from1950PrecMat  precession matrix from B1950 to date
+    @param[out] to1950PrecMat  precession matrix from date to B1950
+    @param[in] date  date of equinox and date of observation (Besselian years)
+    */
+    void computeDateData(Eigen::Vector3d &eTerms, Eigen::Matrix3d &from1950PrecMat, Eigen::Matrix3d &to1950PrecMat,
+        double date
+    ) {
+        // note: slaEtrms and slaPrebn both want Besselian date
+        double eTermsCArr[3], from1950PrecCArr[3][3], to1950PrecCArr[3][3];
+        slaEtrms(date, eTermsCArr);
+        slaPrebn(1950.0, date, from1950PrecCArr);
+        slaPrebn(date, 1950.0, to1950PrecCArr);
+        for (int i = 0; i < 3; ++i) {
+            for (int j = 0; j < 3; ++j) {
+                from1950PrecMat(i,j) = from1950PrecCArr[i][j];
+                  to1950PrecMat(i,j) =   to1950PrecCArr[i][j];
             }
+            eTerms(i) = eTermsCArr[i];
         }
     }
 
-    Coord FK4CoordSys::fromFK5J2000(Coord const &coord, Site const &site) const {
+    /*
+    Convert from FK5 J2000 to FK4 at a given date; the math for FK4CoordSys::fromFK5J2000
+
+    @param[in] coord  FK5 J2000 coordinate
+    @param[in] date  FK4 date (Besselian years)
+    @param[in] eTerms  e-terms of aberration at date
+    @param[in] from1950PrecMat  precession matrix from B1950 to date
+    */
+    coordConv::Coord fk4FromFK5J2000(coordConv::Coord const &coord, double date,
+        Eigen::Vector3d const &eTerms, Eigen::Matrix3d const &from1950PrecMat
+    ) {
         Eigen::Vector3d fk5J2000Pos = coord.getVecPos();
         Eigen::Vector3d fk5J2000PM = coord.getVecPM();
 
@@ -119,11 +112,11 @@ namespace coordConv {
         Eigen::Vector3d b1950Vel = (fromFK5J2000VP * fk5J2000Pos) + (fromFK5J2000VV * fk5J2000PM);
 
         // correct position for velocity (PM and rad. vel.) from 1950 to date
-        Eigen::Vector3d tempPos = b1950Pos + ((this->_date - 1950.0) * b1950Vel);
+        Eigen::Vector3d tempPos = b1950Pos + ((date - 1950.0) * b1950Vel);
 
         // precess position and velocity from 1950 to date
-        Eigen::Vector3d meanToPos = _From1950PrecMat * tempPos;
-        Eigen::Vector3d fk4PM     = _From1950PrecMat * b1950Vel;
+        Eigen::Vector3d meanToPos = from1950PrecMat * tempPos;
+        Eigen::Vector3d fk4PM     = from1950PrecMat * b1950Vel;
 
         // add e-terms to mean position, iterating thrice (should be plenty!)
         // to get mean catalog place. As a minor approximation,
@@ -131,54 +124,168 @@ namespace coordConv {
         Eigen::Vector3d fk4Pos = meanToPos;
         for (int iter = 0; iter < 3; ++iter) {
             double magPos = fk4Pos.norm();
-            fk4Pos = meanToPos + (magPos * _eTerms);
+            fk4Pos = meanToPos + (magPos * eTerms);
         }
         
-        return Coord(fk4Pos, fk4PM);
-    };
-     
-    Coord FK4CoordSys::toFK5J2000(Coord const &coord, Site const &site) const {
+        return coordConv::Coord(fk4Pos, fk4PM);
+    }
+
+    /*
+    Convert from FK4 at a given date to FK5 J2000; the math for FK4CoordSys::toFK5J2000
+
+    @param[in] coord  FK4 coordinate
+    @param[in] date  FK4 date (Besselian years)
+    @param[in] eTerms  e-terms of aberration at date
+    @param[in] to1950PrecMat  precession matrix from date to B1950
+    */
+    coordConv::Coord fk5J2000FromFK4(coordConv::Coord const &coord, double date,
+        Eigen::Vector3d const &eTerms, Eigen::Matrix3d const &to1950PrecMat
+    ) {
         // use the excellent approximation that ICRS = FK4 J2000
         Eigen::Vector3d fk4Pos = coord.getVecPos();
         Eigen::Vector3d fk4PM = coord.getVecPM();
 
         // subtract e-terms from position
         double magPos = fk4Pos.norm();
-        Eigen::Vector3d meanFK4Pos = fk4Pos - (magPos * _eTerms);
+        Eigen::Vector3d meanFK4Pos = fk4Pos - (magPos * eTerms);
         
-        if ((fk4PM.array() == 0.0).all()) {
+        if (!coord.hasPM()) {
             // object is fixed on the sky; handle FK4 fictitious proper motion
             
             // precess position and velocity to B1950
-            Eigen::Vector3d fk41950Pos = _To1950PrecMat * meanFK4Pos;
+            Eigen::Vector3d fk41950Pos = to1950PrecMat * meanFK4Pos;
 
             // convert position to J2000.0 and compute fictitious velocity
             Eigen::Vector3d tempPos = toFK5J2000PP * fk41950Pos;
             Eigen::Vector3d ficVel  = toFK5J2000VP * fk41950Pos;
         
-            // subtract fictitious velocity over the period this->_date to J2000
-            double period = 2000.0 - slaEpj(slaEpb2d(this->_date));
+            // subtract fictitious velocity over the period date to J2000
+            double period = 2000.0 - slaEpj(slaEpb2d(date));
             Eigen::Vector3d fk5J2000Pos = tempPos - (ficVel * period);
             
-            return Coord(fk5J2000Pos);
+            return coordConv::Coord(fk5J2000Pos);
         
         } else {
             // proper motion specified
 
             // correct position for velocity (proper motion and radial velocity) to B1950
-            Eigen::Vector3d corrPos = meanFK4Pos + (1950.0 - this->_date) * fk4PM;
+            Eigen::Vector3d corrPos = meanFK4Pos + (1950.0 - date) * fk4PM;
 
             // precess position and velocity to B1950
-            Eigen::Vector3d fk41950Pos = _To1950PrecMat * corrPos;
-            Eigen::Vector3d fk41950Vel = _To1950PrecMat * fk4PM;
+            Eigen::Vector3d fk41950Pos = to1950PrecMat * corrPos;
+            Eigen::Vector3d fk41950Vel = to1950PrecMat * fk4PM;
 
             // convert position and velocity to J2000.0
             Eigen::Vector3d fk5J2000Pos = (toFK5J2000PP * fk41950Pos) + (toFK5J2000PV * fk41950Vel);
             Eigen::Vector3d fk5J2000PM = (toFK5J2000VP * fk41950Pos) + (toFK5J2000VV * fk41950Vel);
 
-            return Coord(fk5J2000Pos, fk5J2000PM);
+            return coordConv::Coord(fk5J2000Pos, fk5J2000PM);
         }
+    }
+}
+
+namespace coordConv {
+
+    FK4CoordSys::FK4CoordSys(double date)
+    :
+        MeanCoordSys("fk4", date, DateType_Besselian),
+        _eTerms(),
+        _From1950PrecMat(),
+        _To1950PrecMat()
+    {
+        setDate(date);
+    };
+
+    CoordSys::Ptr FK4CoordSys::clone() const {
+        return clone(getDate());
+    }
+
+    CoordSys::Ptr FK4CoordSys::clone(double date) const {
+        return CoordSys::Ptr(new FK4CoordSys(date));
     };
+    
+    void FK4CoordSys::_setDate(double date) const {
+        if (date == 0) {
+            throw std::runtime_error("date must not be 0 for FK5CoordSys");
+        }
+        this->_date = date;
+        if (std::isfinite(date)) {
+            computeDateData(_eTerms, _From1950PrecMat, _To1950PrecMat, date);
+        }
+    }
+
+    Coord FK4CoordSys::fromFK5J2000(Coord const &coord, Site const &site) const {
+        return fk4FromFK5J2000(coord, this->_date, _eTerms, _From1950PrecMat);
+    };
+     
+    Coord FK4CoordSys::toFK5J2000(Coord const &coord, Site const &site) const {
+        return fk5J2000FromFK4(coord, this->_date, _eTerms, _To1950PrecMat);
+    };
+
+    Coord FK4CoordSys::removePM(Coord const &coord, double tai) const {
+        // this is MeanCoordSys::removePM (convert to FK4 at the TAI date, zero velocity and convert back),
+        // but uses local data for FK4 at the TAI date instead of cloning this coordinate system,
+        // so it does not allocate heap memory
+        if (!coord.hasPM()) {
+            // no proper motion to correct; return the coord unchanged
+            return coord;
+        }
+        double const dateAtTAI = dateFromTAI(tai);
+        Eigen::Vector3d eTermsAtTAI;
+        Eigen::Matrix3d from1950PrecMatAtTAI, to1950PrecMatAtTAI;
+        computeDateData(eTermsAtTAI, from1950PrecMatAtTAI, to1950PrecMatAtTAI, dateAtTAI);
+
+        Coord fk5J2000Coord = fk5J2000FromFK4(coord, this->_date, _eTerms, _To1950PrecMat);
+        Coord coordAtTAI = fk4FromFK5J2000(fk5J2000Coord, dateAtTAI, eTermsAtTAI, from1950PrecMatAtTAI);
+        Coord zpmCoordAtTAI(coordAtTAI.getVecPos());
+        Coord zpmFK5J2000Coord = fk5J2000FromFK4(zpmCoordAtTAI, dateAtTAI, eTermsAtTAI, to1950PrecMatAtTAI);
+        return fk4FromFK5J2000(zpmFK5J2000Coord, this->_date, _eTerms, _From1950PrecMat);
+    }
+
+    void FK4CoordSys::fromFK5J2000(CoordArray &coordArr, CoordArray const &fk5J2000Arr, Site const &site) const {
+        // FK4 is rarely used for large catalogs, so keep it simple
+        CoordSys::fromFK5J2000(coordArr, fk5J2000Arr, site);
+    }
+
+    void FK4CoordSys::toFK5J2000(CoordArray &fk5J2000Arr, CoordArray const &coordArr, Site const &site) const {
+        // FK4 is rarely used for large catalogs, so keep it simple
+        CoordSys::toFK5J2000(fk5J2000Arr, coordArr, site);
+    }
+
+    // FK4CoordSys cannot be current, so posRate is always 0
+
+    Coord FK4CoordSys::fromFK5J2000(Eigen::Matrix3d &jacobian, Eigen::Vector3d &posRate, Coord const &coord, Site const &site) const {
+        Coord fk4Coord = fromFK5J2000(coord, site);
+
+        // jacobian of mean position with respect to FK5 J2000 position
+        Eigen::Matrix3d meanJacobian = _From1950PrecMat * (fromFK5J2000PP + ((this->_date - 1950.0) * fromFK5J2000VP));
+
+        // jacobian of adding e-terms: fk4Pos = meanToPos + (|fk4Pos| * eTerms),
+        // so d(fk4Pos) = d(meanToPos) + (eTerms * unitPos^T * d(fk4Pos)), where unitPos = fk4Pos / |fk4Pos|
+        Eigen::Vector3d unitPos = fk4Coord.getVecPos() / fk4Coord.getVecPos().norm();
+        Eigen::Matrix3d eTermsJacobian = Eigen::Matrix3d::Identity()
+            + ((_eTerms * unitPos.transpose()) / (1.0 - unitPos.dot(_eTerms)));
+
+        jacobian = eTermsJacobian * meanJacobian;
+        posRate.setZero();
+        return fk4Coord;
+    }
+
+    Coord FK4CoordSys::toFK5J2000(Eigen::Matrix3d &jacobian, Eigen::Vector3d &posRate, Coord const &coord, Site const &site) const {
+        // jacobian of subtracting e-terms: meanFK4Pos = fk4Pos - (|fk4Pos| * eTerms)
+        Eigen::Vector3d unitPos = coord.getVecPos() / coord.getVecPos().norm();
+        Eigen::Matrix3d eTermsJacobian = Eigen::Matrix3d::Identity() - (_eTerms * unitPos.transpose());
+
+        if (!coord.hasPM()) {
+            // object is fixed on the sky; include fictitious velocity
+            double period = 2000.0 - slaEpj(slaEpb2d(this->_date));
+            jacobian = (toFK5J2000PP - (toFK5J2000VP * period)) * _To1950PrecMat * eTermsJacobian;
+        } else {
+            jacobian = toFK5J2000PP * _To1950PrecMat * eTermsJacobian;
+        }
+        posRate.setZero();
+        return toFK5J2000(coord, site);
+    }
 
     std::string FK4CoordSys::__repr__() const {
         std::ostringstream os;
@@ -47,6 +47,10 @@ namespace coordConv {
         double const toDate = this->_date;
         
         Eigen::Vector3d fk5J2000Pos = coord.getVecPos();
+        if (!coord.hasPM()) {
+            // fixed target: just precess position
+            return Coord(_to2000PrecMat.transpose() * fk5J2000Pos);
+        }
         Eigen::Vector3d fk5J2000PM = coord.getVecPM();
         
         // correct for velocity (proper motion and radial velocity)
@@ -66,6 +70,10 @@ namespace coordConv {
         double const toDate = 2000.0;
         
         Eigen::Vector3d fk5Pos = coord.getVecPos();
+        if (!coord.hasPM()) {
+            // fixed target: just precess position
+            return Coord(_to2000PrecMat * fk5Pos);
+        }
         Eigen::Vector3d fk5Vel = coord.getVecPM();
         
         // correct for velocity (proper motion and radial velocity)
@@ -79,6 +87,62 @@ namespace coordConv {
         return Coord(fk5J2000Pos, fk5J2000PM);
     };
 
+    // note: rows of the arrays are vectors, so (mat * vec) becomes (rowArr * mat.transpose())
+
+    void FK5CoordSys::fromFK5J2000(CoordArray &coordArr, CoordArray const &fk5J2000Arr, Site const &site) const {
+        double const fromDate = 2000.0;
+        double const toDate = this->_date;
+
+        if (!fk5J2000Arr.hasPM()) {
+            // fixed targets: just precess position
+            coordArr.pos = fk5J2000Arr.pos * _to2000PrecMat;
+            coordArr.pm.setZero(coordArr.pos.rows(), 3);
+            return;
+        }
+
+        // correct for velocity and precess position and velocity;
+        // assign pos first, in case the arrays are the same
+        coordArr.pos = (fk5J2000Arr.pos + (fk5J2000Arr.pm * (toDate - fromDate))) * _to2000PrecMat;
+        coordArr.pm = fk5J2000Arr.pm * _to2000PrecMat;
+    }
+
+    void FK5CoordSys::toFK5J2000(CoordArray &fk5J2000Arr, CoordArray const &coordArr, Site const &site) const {
+        double const fromDate = this->_date;
+        double const toDate = 2000.0;
+
+        if (!coordArr.hasPM()) {
+            // fixed targets: just precess position
+            fk5J2000Arr.pos = coordArr.pos * _to2000PrecMat.transpose();
+            fk5J2000Arr.pm.setZero(fk5J2000Arr.pos.rows(), 3);
+            return;
+        }
+
+        // correct for velocity and precess position and velocity;
+        // assign pos first, in case the arrays are the same
+        fk5J2000Arr.pos = (coordArr.pos + (coordArr.pm * (toDate - fromDate))) * _to2000PrecMat.transpose();
+        fk5J2000Arr.pm = coordArr.pm * _to2000PrecMat.transpose();
+    }
+
+    // FK5CoordSys cannot be current, so posRate is always 0
+
+    Coord FK5CoordSys::fromFK5J2000(Eigen::Matrix3d &jacobian, Eigen::Vector3d &posRate, Coord const &coord, Site const &site) const {
+        jacobian = _to2000PrecMat.transpose();
+        posRate.setZero();
+        return fromFK5J2000(coord, site);
+    }
+
+    Coord FK5CoordSys::toFK5J2000(Eigen::Matrix3d &jacobian, Eigen::Vector3d &posRate, Coord const &coord, Site const &site) const {
+        jacobian = _to2000PrecMat;
+        posRate.setZero();
+        return toFK5J2000(coord, site);
+    }
+
+    bool FK5CoordSys::getRotationToFK5J2000(Eigen::Matrix3d &rotMat, double &pmSpan) const {
+        rotMat = _to2000PrecMat;
+        pmSpan = 2000.0 - this->_date;
+        return true;
+    }
+
     std::string FK5CoordSys::__repr__() const {
         std::ostringstream os;
         os << "FK5CoordSys(" << getDate() << ")";
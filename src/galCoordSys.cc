@@ -33,6 +33,10 @@ namespace coordConv {
         
         // adjust space velocity
         Eigen::Vector3d fk5J2000Pos = coord.getVecPos();
+        if (!coord.hasPM()) {
+            // fixed target: just rotate position
+            return Coord(_fromFK5J2000RotMat * fk5J2000Pos);
+        }
         Eigen::Vector3d fk5J2000PM = coord.getVecPM();
         Eigen::Vector3d adjIcrsPos = fk5J2000Pos + (fk5J2000PM * (toDate - fromDate));
     
@@ -50,6 +54,10 @@ namespace coordConv {
 
         // correct for velocity (proper motion and radial velocity)
         Eigen::Vector3d galPos = coord.getVecPos();
+        if (!coord.hasPM()) {
+            // fixed target: just rotate position
+            return Coord(_fromFK5J2000RotMat.transpose() * galPos);
+        }
         Eigen::Vector3d galPM = coord.getVecPM();
         Eigen::Vector3d adjGalPos = galPos + (galPM * (toDate - fromDate));
 
@@ -61,6 +69,68 @@ namespace coordConv {
         return Coord(fk5J2000Pos, fk5J2000PM);
     }
 
+    // note: rows of the arrays are vectors, so (mat * vec) becomes (rowArr * mat.transpose())
+
+    void GalCoordSys::fromFK5J2000(CoordArray &coordArr, CoordArray const &fk5J2000Arr, Site const &site) const {
+        double const fromDate = 2000.0;
+        double const toDate = this->_date;
+
+        if (!fk5J2000Arr.hasPM()) {
+            // fixed targets: just rotate position
+            coordArr.pos = fk5J2000Arr.pos * _fromFK5J2000RotMat.transpose();
+            coordArr.pm.setZero(coordArr.pos.rows(), 3);
+            return;
+        }
+
+        // adjust space velocity and rotate; assign pos first, in case the arrays are the same
+        coordArr.pos = (fk5J2000Arr.pos + (fk5J2000Arr.pm * (toDate - fromDate))) * _fromFK5J2000RotMat.transpose();
+        coordArr.pm = fk5J2000Arr.pm * _fromFK5J2000RotMat.transpose();
+    }
+
+    void GalCoordSys::toFK5J2000(CoordArray &fk5J2000Arr, CoordArray const &coordArr, Site const &site) const {
+        double const fromDate = this->_date;
+        double const toDate = 2000.0;
+
+        if (!coordArr.hasPM()) {
+            // fixed targets: just rotate position
+            fk5J2000Arr.pos = coordArr.pos * _fromFK5J2000RotMat;
+            fk5J2000Arr.pm.setZero(fk5J2000Arr.pos.rows(), 3);
+            return;
+        }
+
+        // adjust space velocity and rotate (by INVERSE rotation); assign pos first, in case the arrays are the same
+        fk5J2000Arr.pos = (coordArr.pos + (coordArr.pm * (toDate - fromDate))) * _fromFK5J2000RotMat;
+        fk5J2000Arr.pm = coordArr.pm * _fromFK5J2000RotMat;
+    }
+
+    Coord GalCoordSys::fromFK5J2000(Eigen::Matrix3d &jacobian, Eigen::Vector3d &posRate, Coord const &coord, Site const &site) const {
+        jacobian = _fromFK5J2000RotMat;
+        if (isCurrent()) {
+            // date changes by 1 Julian year per year of TAI
+            posRate = _fromFK5J2000RotMat * coord.getVecPM() / (SecPerDay * DaysPerYear);
+        } else {
+            posRate.setZero();
+        }
+        return fromFK5J2000(coord, site);
+    }
+
+    Coord GalCoordSys::toFK5J2000(Eigen::Matrix3d &jacobian, Eigen::Vector3d &posRate, Coord const &coord, Site const &site) const {
+        jacobian = _fromFK5J2000RotMat.transpose();
+        if (isCurrent()) {
+            // date changes by 1 Julian year per year of TAI
+            posRate = - _fromFK5J2000RotMat.transpose() * coord.getVecPM() / (SecPerDay * DaysPerYear);
+        } else {
+            posRate.setZero();
+        }
+        return toFK5J2000(coord, site);
+    }
+
+    bool GalCoordSys::getRotationToFK5J2000(Eigen::Matrix3d &rotMat, double &pmSpan) const {
+        rotMat = _fromFK5J2000RotMat.transpose();
+        pmSpan = 2000.0 - this->_date;
+        return true;
+    }
+
     std::string GalCoordSys::__repr__() const {
         std::ostringstream os;
         os << "GalCoordSys(" << getDate() << ")";
@@ -16,8 +16,8 @@ namespace coordConv {
         Eigen::Vector3d const &azAlt,
         double lat
     ) {
-        double const sinLat = sind(lat);
-        double const cosLat = cosd(lat);
+        double sinLat, cosLat;
+        sincosd(sinLat, cosLat, lat);
 
         haDec <<
             + (sinLat * azAlt(0)) + (cosLat * azAlt(2)),
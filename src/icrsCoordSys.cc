@@ -22,6 +22,10 @@ namespace coordConv {
 
     Coord ICRSCoordSys::fromFK5J2000(Coord const &coord, Site const &site) const {
         // use the excellent approximation that ICRS = ICRS J2000
+        if (!coord.hasPM()) {
+            // fixed target: nothing to do
+            return coord;
+        }
         double const fromDate = 2000.0;
         double const toDate = this->_date;
         
@@ -36,6 +40,10 @@ namespace coordConv {
     
     Coord ICRSCoordSys::toFK5J2000(Coord const &coord, Site const &site) const {
         // use the excellent approximation that ICRS = ICRS J2000
+        if (!coord.hasPM()) {
+            // fixed target: nothing to do
+            return coord;
+        }
         double const fromDate = this->_date;
         double const toDate = 2000.0;
         
@@ -48,6 +56,60 @@ namespace coordConv {
         return Coord(toPos, fromPM);
     };
 
+    void ICRSCoordSys::fromFK5J2000(CoordArray &coordArr, CoordArray const &fk5J2000Arr, Site const &site) const {
+        double const fromDate = 2000.0;
+        double const toDate = this->_date;
+
+        // correct for velocity (proper motion and radial velocity); assign pos first, in case the arrays are the same
+        if (!fk5J2000Arr.hasPM()) {
+            coordArr = fk5J2000Arr;
+            return;
+        }
+        coordArr.pos = fk5J2000Arr.pos + (fk5J2000Arr.pm * (toDate - fromDate));
+        coordArr.pm = fk5J2000Arr.pm;
+    }
+
+    void ICRSCoordSys::toFK5J2000(CoordArray &fk5J2000Arr, CoordArray const &coordArr, Site const &site) const {
+        double const fromDate = this->_date;
+        double const toDate = 2000.0;
+
+        // correct for velocity (proper motion and radial velocity); assign pos first, in case the arrays are the same
+        if (!coordArr.hasPM()) {
+            fk5J2000Arr = coordArr;
+            return;
+        }
+        fk5J2000Arr.pos = coordArr.pos + (coordArr.pm * (toDate - fromDate));
+        fk5J2000Arr.pm = coordArr.pm;
+    }
+
+    Coord ICRSCoordSys::fromFK5J2000(Eigen::Matrix3d &jacobian, Eigen::Vector3d &posRate, Coord const &coord, Site const &site) const {
+        jacobian.setIdentity();
+        if (isCurrent()) {
+            // toPos = fromPos + (fromPM * (date - 2000)), where date changes by 1 Julian year per year of TAI
+            posRate = coord.getVecPM() / (SecPerDay * DaysPerYear);
+        } else {
+            posRate.setZero();
+        }
+        return fromFK5J2000(coord, site);
+    }
+
+    Coord ICRSCoordSys::toFK5J2000(Eigen::Matrix3d &jacobian, Eigen::Vector3d &posRate, Coord const &coord, Site const &site) const {
+        jacobian.setIdentity();
+        if (isCurrent()) {
+            // toPos = fromPos + (fromPM * (2000 - date)), where date changes by 1 Julian year per year of TAI
+            posRate = - coord.getVecPM() / (SecPerDay * DaysPerYear);
+        } else {
+            posRate.setZero();
+        }
+        return toFK5J2000(coord, site);
+    }
+
+    bool ICRSCoordSys::getRotationToFK5J2000(Eigen::Matrix3d &rotMat, double &pmSpan) const {
+        rotMat.setIdentity();
+        pmSpan = 2000.0 - this->_date;
+        return true;
+    }
+
     std::string ICRSCoordSys::__repr__() const {
         std::ostringstream os;
         os << "ICRSCoordSys(" << getDate() << ")";
@@ -0,0 +1,141 @@
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+#ifdef __APPLE__
+#include <mach/mach_time.h>
+#else
+#include <time.h>
+#endif
+#include "coordConv/mathUtils.h"
+#include "coordConv/latencyHistogram.h"
+
+namespace {
+    const double MinBinEdge = 1.0e-8;   // lower edge of the first bin (sec)
+    const int BinsPerDecade = 20;
+    const int NumDecades = 9;           // so the upper edge of the last bin is 10 sec
+    const int NumBins = BinsPerDecade * NumDecades;
+
+    /*
+    Return the upper edge of the specified bin (sec)
+    */
+    inline double binUpperEdge(int binInd) {
+        return MinBinEdge * std::pow(10.0, (binInd + 1) / double(BinsPerDecade));
+    }
+}
+
+namespace coordConv {
+
+    double monotonicSec() {
+#ifdef __APPLE__
+        static mach_timebase_info_data_t timebaseInfo;
+        if (timebaseInfo.denom == 0) {
+            mach_timebase_info(&timebaseInfo);
+        }
+        return (mach_absolute_time() * 1.0e-9 * timebaseInfo.numer) / timebaseInfo.denom;
+#else
+        struct timespec ts;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return ts.tv_sec + (ts.tv_nsec * 1.0e-9);
+#endif
+    }
+
+    LatencyStats::LatencyStats()
+    :
+        count(0),
+        min(DoubleNaN),
+        p50(DoubleNaN),
+        p99(DoubleNaN),
+        max(DoubleNaN),
+        mean(DoubleNaN)
+    { }
+
+    std::string LatencyStats::__repr__() const {
+        std::ostringstream os;
+        os << *this;
+        return os.str();
+    }
+
+    LatencyHistogram::LatencyHistogram()
+    :
+        _binCounts(NumBins, 0)
+    {
+        reset();
+    }
+
+    void LatencyHistogram::record(double latency) {
+        int binInd = 0;
+        if (latency > MinBinEdge) {
+            binInd = std::min(NumBins - 1, static_cast<int>(std::log10(latency / MinBinEdge) * BinsPerDecade));
+        }
+        ++_binCounts[binInd];
+        ++_count;
+        _sum += latency;
+        if (_count == 1) {
+            _min = latency;
+            _max = latency;
+        } else {
+            _min = std::min(_min, latency);
+            _max = std::max(_max, latency);
+        }
+    }
+
+    void LatencyHistogram::reset() {
+        std::fill(_binCounts.begin(), _binCounts.end(), 0);
+        _count = 0;
+        _min = DoubleNaN;
+        _max = DoubleNaN;
+        _sum = 0;
+    }
+
+    LatencyStats LatencyHistogram::getStats() const {
+        LatencyStats stats;
+        stats.count = _count;
+        if (_count > 0) {
+            stats.min = _min;
+            stats.max = _max;
+            stats.mean = _sum / _count;
+            stats.p50 = _getPercentile(0.50);
+            stats.p99 = _getPercentile(0.99);
+        }
+        return stats;
+    }
+
+    std::string LatencyHistogram::__repr__() const {
+        std::ostringstream os;
+        os << *this;
+        return os.str();
+    }
+
+    double LatencyHistogram::_getPercentile(double fraction) const {
+        long const numNeeded = std::max(1L, static_cast<long>(std::ceil(fraction * _count)));
+        long numSoFar = 0;
+        for (int binInd = 0; binInd < NumBins; ++binInd) {
+            numSoFar += _binCounts[binInd];
+            if (numSoFar >= numNeeded) {
+                return std::max(_min, std::min(_max, binUpperEdge(binInd)));
+            }
+        }
+        return _max;
+    }
+
+    std::ostream &operator<<(std::ostream &os, LatencyStats const &stats) {
+        std::streamsize const oldPrecision = os.precision();
+        os << "LatencyStats(count=" << stats.count
+            << std::setprecision(3)
+            << ", min=" << stats.min
+            << ", p50=" << stats.p50
+            << ", p99=" << stats.p99
+            << ", max=" << stats.max
+            << ", mean=" << stats.mean
+            << ")"
+            << std::setprecision(oldPrecision);
+        return os;
+    }
+
+    std::ostream &operator<<(std::ostream &os, LatencyHistogram const &hist) {
+        os << "LatencyHistogram(" << hist.getStats() << ")";
+        return os;
+    }
+
+}
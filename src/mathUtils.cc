@@ -5,10 +5,12 @@
 
 namespace coordConv {
 
-    double hypot(double x, double y) {
-        // assume that Eigen does it as well as anybody
-        Eigen::Vector2d vec(x, y);
-        return vec.norm();
+    void sincosd(Eigen::ArrayXd &sinArr, Eigen::ArrayXd &cosArr, Eigen::ArrayXd const &angArr) {
+        sinArr.resize(angArr.size());
+        cosArr.resize(angArr.size());
+        for (int i = 0; i < angArr.size(); ++i) {
+            sincosd(sinArr(i), cosArr(i), angArr(i));
+        }
     }
 
     bool polarFromXY(double &r, double &theta, double x, double y) {
@@ -26,15 +28,17 @@ namespace coordConv {
     }
 
     void xyFromPolar(double &x, double &y, double r, double theta) {
-        x = r * cosd(theta);
-        y = r * sind(theta);
+        double sinTheta, cosTheta;
+        sincosd(sinTheta, cosTheta, theta);
+        x = r * cosTheta;
+        y = r * sinTheta;
     }
 
     void computeRotationMatrix(Eigen::Matrix3d &rotMat, Eigen::Vector3d const &axis, double rotAngle) {
         // this code is a minor adaptation of LSST afw Coord::rotate
-        double const c = cosd(rotAngle);
+        double s, c;
+        sincosd(s, c, rotAngle);
         double const mc = 1.0 - c;
-        double const s = sind(rotAngle);
     
         double axisMag = axis.norm();
         double const ux = axis(0) / axisMag;
@@ -14,12 +14,21 @@ namespace coordConv {
     Coord MeanCoordSys::removePM(Coord const &coord, double tai) const {
         // convert to this coord at tai date, zero velocity and convert back;
         // this is fancier than just adding vecPM to vecPos, but handles fictitious proper motion (e.g. FK4).
-        if ((coord.getVecPM().array() == 0.0).all()) {
+        if (!coord.hasPM()) {
             // no proper motion to correct; return the coord unchanged
             return coord;
         }
 
         double dateAtTAI = dateFromTAI(tai);
+        Eigen::Matrix3d rotMat;
+        double pmSpan;
+        if (getRotationToFK5J2000(rotMat, pmSpan)) {
+            // converting is a rotation plus a proper motion correction, so the round trip reduces
+            // to correcting position for proper motion; this also avoids cloning (and allocating) a coordinate system.
+            // If this coordinate system is current then its date is the TAI date, so there is nothing to correct.
+            double const fromDate = isCurrent() ? dateAtTAI : this->_date;
+            return Coord(coord.getVecPos() + (coord.getVecPM() * (dateAtTAI - fromDate)));
+        }
         CoordSys::Ptr coordSysAtTAIPtr = this->clone(dateAtTAI);
         Site site(10, 10, 10); // values are irrelevant for mean to mean coordinate conversions
         Coord coordAtTAI = coordSysAtTAIPtr->convertFrom(*this, coord, site);
@@ -1,9 +1,11 @@
 #include <stdexcept>
 #include <sstream>
+#include <typeinfo>
 #include "coordConv/mathUtils.h"
 #include "coordConv/appTopoFromObs.h"
 #include "coordConv/obsFromAppTopo.h"
 #include "coordConv/coordSys.h"
+#include "coordConv/conversionShortcut.h"
 
 namespace coordConv {
 
@@ -15,6 +17,23 @@ namespace coordConv {
         setDate(date);
     };
     
+    ObsCoordSys::ObsCoordSys(AppGeoCache::Ptr const &appGeoCachePtr, double date)
+    :
+        ApparentCoordSys("obs", date),
+        _appTopoCoordSys(appGeoCachePtr)
+    {
+        setDate(date);
+    };
+    
+    ConvertStatusEnum ObsCoordSys::getDateStatus(double date) const {
+        // matches _setDate, which only sets the date of the apparent topocentric coordinate system if date > 0
+        return (date > 0) ? _appTopoCoordSys.getDateStatus(date) : ConvertStatus_OK;
+    }
+
+    ConvertStatusEnum ObsCoordSys::getConvertStatus() const {
+        return _appTopoCoordSys.getConvertStatus();
+    }
+
     void ObsCoordSys::_setDate(double date) const {
         if (date > 0) {
             _appTopoCoordSys.setCurrDate(date);
@@ -27,7 +46,7 @@ namespace coordConv {
     }
 
     CoordSys::Ptr ObsCoordSys::clone(double date) const {
-        return CoordSys::Ptr(new ObsCoordSys(date));
+        return CoordSys::Ptr(new ObsCoordSys(getAppGeoCache(), date));
     };
 
     Coord ObsCoordSys::fromFK5J2000(Coord const &coord, Site const &site) const {
@@ -40,6 +59,82 @@ namespace coordConv {
         return _appTopoCoordSys.toFK5J2000(appTopoCoord, site);
     }
 
+    void ObsCoordSys::fromFK5J2000(CoordArray &coordArr, CoordArray const &fk5J2000Arr, Site const &site) const {
+        _appTopoCoordSys.fromFK5J2000(coordArr, fk5J2000Arr, site);
+        obsFromAppTopo(coordArr, coordArr, site);
+    }
+
+    void ObsCoordSys::toFK5J2000(CoordArray &fk5J2000Arr, CoordArray const &coordArr, Site const &site) const {
+        appTopoFromObs(fk5J2000Arr, coordArr, site);
+        _appTopoCoordSys.toFK5J2000(fk5J2000Arr, fk5J2000Arr, site);
+    }
+
+    // the internal apparent topocentric coordinate system is always current,
+    // so its posRate must be ignored if this coordinate system is not
+
+    Coord ObsCoordSys::fromFK5J2000(Eigen::Matrix3d &jacobian, Eigen::Vector3d &posRate, Coord const &coord, Site const &site) const {
+        Eigen::Matrix3d appTopoJacobian, obsJacobian;
+        Eigen::Vector3d appTopoPosRate;
+        Coord appTopoCoord = _appTopoCoordSys.fromFK5J2000(appTopoJacobian, appTopoPosRate, coord, site);
+        Coord obsCoord = obsFromAppTopo(obsJacobian, appTopoCoord, site);
+        jacobian = obsJacobian * appTopoJacobian;
+        if (isCurrent()) {
+            posRate = obsJacobian * appTopoPosRate;
+        } else {
+            posRate.setZero();
+        }
+        return obsCoord;
+    }
+
+    Coord ObsCoordSys::toFK5J2000(Eigen::Matrix3d &jacobian, Eigen::Vector3d &posRate, Coord const &coord, Site const &site) const {
+        Eigen::Matrix3d appTopoJacobian, fk5J2000Jacobian;
+        Eigen::Vector3d fk5J2000PosRate;
+        Coord appTopoCoord = appTopoFromObs(appTopoJacobian, coord, site);
+        Coord fk5J2000Coord = _appTopoCoordSys.toFK5J2000(fk5J2000Jacobian, fk5J2000PosRate, appTopoCoord, site);
+        jacobian = fk5J2000Jacobian * appTopoJacobian;
+        if (isCurrent()) {
+            posRate = fk5J2000PosRate;
+        } else {
+            posRate.setZero();
+        }
+        return fk5J2000Coord;
+    }
+
+    Eigen::VectorXd ObsCoordSys::convertFromMultiRefCo(CoordArray &obsArr, CoordSys const &fromCoordSys,
+        Coord const &fromCoord, Eigen::MatrixXd const &refCoArr, Site const &site, double tai, int refInd
+    ) const {
+        Eigen::VectorXd dispersion;
+        throwIfFailed(tryConvertFromMultiRefCo(dispersion, obsArr, fromCoordSys, fromCoord, refCoArr, site, tai, refInd));
+        return dispersion;
+    }
+
+    ConvertStatusEnum ObsCoordSys::tryConvertFromMultiRefCo(Eigen::VectorXd &dispersion, CoordArray &obsArr,
+        CoordSys const &fromCoordSys, Coord const &fromCoord, Eigen::MatrixXd const &refCoArr, Site const &site,
+        double tai, int refInd
+    ) const {
+        // set dates as CoordSys::tryConvertFrom does; the internal apparent topocentric coordinate system
+        // is then at the date of this coordinate system, so it can be used to convert to apparent topocentric
+        ConvertStatusEnum const status = _prepareConversion(*this, fromCoordSys, tai);
+        if (status != ConvertStatus_OK) {
+            return status;
+        }
+
+        Coord appTopoCoord;
+        ConversionShortcut::ConstPtr const shortcutPtr = findConversionShortcut(fromCoordSys, _appTopoCoordSys);
+        if ((typeid(fromCoordSys) == typeid(AppTopoCoordSys))
+            && (fromCoordSys.getDate(false) == _appTopoCoordSys.getDate(false))) {
+            // already apparent topocentric at the right date (there is no apparent topocentric to
+            // apparent topocentric shortcut, and converting via FK5 J2000 would add round-off error)
+            appTopoCoord = fromCoord;
+        } else if (shortcutPtr) {
+            appTopoCoord = shortcutPtr->convert(fromCoordSys, _appTopoCoordSys, fromCoord, site);
+        } else {
+            appTopoCoord = _appTopoCoordSys.fromFK5J2000(fromCoordSys.toFK5J2000(fromCoord, site), site);
+        }
+        dispersion = obsFromAppTopo(obsArr, appTopoCoord, refCoArr, site, refInd);
+        return ConvertStatus_OK;
+    }
+
     std::string ObsCoordSys::__repr__() const {
         std::ostringstream os;
         os << "ObsCoordSys(" << getDate() << ")";
@@ -1,66 +1,182 @@
+#include <sstream>
 #include <stdexcept>
 #include "coordConv/mathUtils.h"
 #include "coordConv/obsFromAppTopo.h"
 
 namespace coordConv {
 
-    Coord obsFromAppTopo(Coord const &appTopoCoord, Site const &site) {
-        Eigen::Vector3d appTopoPos = appTopoCoord.getVecPos();
+    namespace {
+
+        /**
+        Compute observed position from apparent topocentric position; see obsFromAppTopo for details
+
+        @param[in] appTopoPos  apparent topocentric position
+        @param[in] site  site information
+        @param[in] tablePtr  refraction table; if null then refraction is computed by iteration
+        */
+        Eigen::Vector3d obsPosFromAppTopoPos(Eigen::Vector3d const &appTopoPos, Site const &site,
+            RefractionTable const *tablePtr) {
+            // convert inputs to easy-to-read variables
+            double const xu = appTopoPos(0);
+            double const yu = appTopoPos(1);
+            double const zu = appTopoPos(2);
 
-        // For zdu > ZDu_Max the correction is computed at ZDu_Max.
-        // This is unphysical, but allows working with arbitrary positions.
-        // The model used (at this writing) is not much good beyond 83 degrees
-        // and going beyond ~87 requires more iterations to give reversibility
-        double const ZDu_Max = 85.0;
-
-        // convert inputs to easy-to-read variables
-        double const xu = appTopoPos(0);
-        double const yu = appTopoPos(1);
-        double const zu = appTopoPos(2);
-
-        // useful quantities
-        double const rxymag = hypot(xu, yu);
-        double const rxysq = rxymag * rxymag;
-
-        Eigen::Vector3d obsPos;
-        if (rxysq * std::numeric_limits<double>::epsilon() <= std::numeric_limits<double>::min()) {
-            if ((rxysq + (zu * zu)) * std::numeric_limits<double>::epsilon() <= std::numeric_limits<double>::min()) {
-                // |R| is too small to use -- probably a bug in the calling software
-                throw std::runtime_error("appTopoPos too short");
+            // useful quantities
+            double const rxymag = hypot(xu, yu);
+            double const rxysq = rxymag * rxymag;
+
+            Eigen::Vector3d obsPos;
+            if (rxysq * std::numeric_limits<double>::epsilon() <= std::numeric_limits<double>::min()) {
+                if ((rxysq + (zu * zu)) * std::numeric_limits<double>::epsilon() <= std::numeric_limits<double>::min()) {
+                    // |R| is too small to use -- probably a bug in the calling software
+                    throw std::runtime_error("appTopoPos too short");
+                } else {
+                    // at zenith; set output = input
+                    obsPos = appTopoPos;
+                }
             } else {
-                // at zenith; set output = input
-                obsPos = appTopoPos;
+                // unrefracted zenith distance
+                double zdu = atan2d(rxymag, zu);
+
+                if (tablePtr) {
+                    obsPos << xu, yu, zFromZDChange(rxymag, zu, tablePtr->zdrMinusZDu(zdu));
+                    return obsPos;
+                }
+
+                // Compute the refraction correction using an iterative approximation;
+                // based on tests 2 iterations is plenty, but do one more for paranoia's sake.
+                // Compute it at the unrefracted zenith distance, unless that ZD is too large,
+                // in which case compute the correction at the max unrefracted zenith distance.
+                double zdr_u = 0.0;
+                double zdu_iter = zdu;
+                if (zdu_iter > ZDu_Max) {
+                   zdu_iter = ZDu_Max;
+                }
+                for (int iter = 0; iter < 3; ++iter) {
+                   double zdr_iter = zdu_iter + zdr_u;
+                   double cosZD = cosd(zdr_iter);
+                   double tanZD = tand(zdr_iter);
+                   zdr_u = zdr_u - ((zdr_u + (site.refCoA * tanZD) + (site.refCoB * tanZD * tanZD * tanZD)) /
+                        (1.0 + (RadPerDeg * (site.refCoA + (3.0 * site.refCoB * tanZD * tanZD)) / (cosZD * cosZD))));
+                }
+
+                // compute refracted position as a cartesian vector
+                double zdr = zdu + zdr_u;
+                obsPos <<
+                    xu,
+                    yu,
+                    rxymag * tand(90.0 - zdr);
             }
-        } else {
-            // unrefracted zenith distance
-            double zdu = atan2d(rxymag, zu);
-
-            // Compute the refraction correction using an iterative approximation;
-            // based on tests 2 iterations is plenty, but do one more for paranoia's sake.
-            // Compute it at the unrefracted zenith distance, unless that ZD is too large,
-            // in which case compute the correction at the max unrefracted zenith distance.
-            double zdr_u = 0.0;
-            double zdu_iter = zdu;
-            if (zdu_iter > ZDu_Max) {
-               zdu_iter = ZDu_Max;
+            return obsPos;
+        }
+
+        /**
+        Compute the jacobian of obsPosFromAppTopoPos
+
+        @param[in] appTopoPos  apparent topocentric position
+        @param[in] obsPos  observed position, as computed by obsPosFromAppTopoPos
+        @param[in] site  site information
+        */
+        Eigen::Matrix3d obsJacobianFromAppTopoPos(Eigen::Vector3d const &appTopoPos, Eigen::Vector3d const &obsPos, Site const &site) {
+            // x and y are unchanged, so only the last row of the jacobian differs from the identity matrix
+            Eigen::Matrix3d jacobian = Eigen::Matrix3d::Identity();
+            double const x = appTopoPos(0);
+            double const y = appTopoPos(1);
+            double const z = appTopoPos(2);
+            double const rxymag = hypot(x, y);
+            if (rxymag * rxymag * std::numeric_limits<double>::epsilon() <= std::numeric_limits<double>::min()) {
+                // at zenith; output = input
+                return jacobian;
             }
-            for (int iter = 0; iter < 3; ++iter) {
-               double zdr_iter = zdu_iter + zdr_u;
-               double cosZD = cosd(zdr_iter);
-               double tanZD = tand(zdr_iter);
-               zdr_u = zdr_u - ((zdr_u + (site.refCoA * tanZD) + (site.refCoB * tanZD * tanZD * tanZD)) /
-                    (1.0 + (RadPerDeg * (site.refCoA + (3.0 * site.refCoB * tanZD * tanZD)) / (cosZD * cosZD))));
+            double const zdu = atan2d(rxymag, z);
+            // compute functions of zdr directly from the refracted position, to avoid trig functions
+            double const zOut = obsPos(2);
+            double const rsqOut = (rxymag * rxymag) + (zOut * zOut);
+
+            // zdr = zdu + zdr_u, where zdr_u + (refCoA * tan(zdr)) + (refCoB * tan^3(zdr)) = 0
+            // unless zdu > ZDu_Max, in which case zdr_u is constant
+            double dZDOut_dZDIn = 1.0;
+            if (zdu <= ZDu_Max) {
+                double tanZD = rxymag / zOut;
+                double cosSqZD = zOut * zOut / rsqOut;
+                dZDOut_dZDIn = 1.0 / (1.0 + (RadPerDeg * (site.refCoA + (3.0 * site.refCoB * tanZD * tanZD)) / cosSqZD));
             }
 
-            // compute refracted position as a cartesian vector
-            double zdr = zdu + zdr_u;
-            obsPos <<
-                xu,
-                yu,
-                rxymag * tand(90.0 - zdr);
+            // output z = rxymag * cot(zdr); compute its partial derivatives
+            // with respect to rxymag and zdu (radians), and those with respect to input x, y, z
+            double const rsq = (rxymag * rxymag) + (z * z);
+            double const sinSqZDOut = rxymag * rxymag / rsqOut;
+            double const dZOut_dRxy = zOut / rxymag;
+            double const dZOut_dZDIn = - rxymag * dZDOut_dZDIn / sinSqZDOut;
+            Eigen::Vector3d dRxy(x / rxymag, y / rxymag, 0.0);
+            Eigen::Vector3d dZDIn(z * x / (rxymag * rsq), z * y / (rxymag * rsq), - rxymag / rsq);
+            jacobian.row(2) = ((dZOut_dRxy * dRxy) + (dZOut_dZDIn * dZDIn)).transpose();
+            return jacobian;
         }
+
+    }
+
+    Coord obsFromAppTopo(Coord const &appTopoCoord, Site const &site) {
+        RefractionTable::ConstPtr tablePtr = getRefractionTable(site);
+        return Coord(obsPosFromAppTopoPos(appTopoCoord.getVecPos(), site, tablePtr.get()));
+    }
+
+    void obsFromAppTopo(CoordArray &obsArr, CoordArray const &appTopoArr, Site const &site) {
+        if (obsArr.size() != appTopoArr.size()) {
+            obsArr.resize(appTopoArr.size());
+        }
+        RefractionTable::ConstPtr tablePtr = getRefractionTable(site);
+        for (int i = 0; i < appTopoArr.size(); ++i) {
+            obsArr.pos.row(i) = obsPosFromAppTopoPos(appTopoArr.pos.row(i).transpose(), site, tablePtr.get()).transpose();
+        }
+        obsArr.pm.setZero();
+    }
+
+    Eigen::VectorXd obsFromAppTopo(
+        CoordArray &obsArr,
+        Coord const &appTopoCoord,
+        Eigen::MatrixXd const &refCoArr,
+        Site const &site,
+        int refInd
+    ) {
+        if ((refCoArr.cols() != 2) || (refCoArr.rows() < 1)) {
+            std::ostringstream os;
+            os << "refCoArr has shape (" << refCoArr.rows() << ", " << refCoArr.cols()
+                << "); it must have 2 columns and at least one row";
+            throw std::invalid_argument(os.str());
+        }
+        if ((refInd < 0) || (refInd >= refCoArr.rows())) {
+            std::ostringstream os;
+            os << "refInd = " << refInd << " not in range [0, " << refCoArr.rows() << ")";
+            throw std::invalid_argument(os.str());
+        }
+        int const numRefCo = static_cast<int>(refCoArr.rows());
+        if (obsArr.size() != numRefCo) {
+            obsArr.resize(numRefCo);
+        }
+
+        // refraction only changes z, so compute rxymag once and the zenith distance of each observed position from z
+        Eigen::Vector3d const appTopoPos = appTopoCoord.getVecPos();
+        double const rxymag = hypot(appTopoPos(0), appTopoPos(1));
+        Site refCoSite(site);
+        Eigen::VectorXd zdArr(numRefCo);
+        for (int i = 0; i < numRefCo; ++i) {
+            refCoSite.refCoA = refCoArr(i, 0);
+            refCoSite.refCoB = refCoArr(i, 1);
+            Eigen::Vector3d const obsPos = obsPosFromAppTopoPos(appTopoPos, refCoSite, 0);
+            obsArr.pos.row(i) = obsPos.transpose();
+            zdArr(i) = atan2d(rxymag, obsPos(2));
+        }
+        obsArr.pm.setZero();
+        return Eigen::VectorXd::Constant(numRefCo, zdArr(refInd)) - zdArr;
+    }
+
+    Coord obsFromAppTopo(Eigen::Matrix3d &jacobian, Coord const &appTopoCoord, Site const &site) {
+        Eigen::Vector3d appTopoPos = appTopoCoord.getVecPos();
+        RefractionTable::ConstPtr tablePtr = getRefractionTable(site);
+        Eigen::Vector3d obsPos = obsPosFromAppTopoPos(appTopoPos, site, tablePtr.get());
+        jacobian = obsJacobianFromAppTopoPos(appTopoPos, obsPos, site);
         return Coord(obsPos);
     }
 
 }
-
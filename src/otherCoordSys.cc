@@ -26,6 +26,28 @@ namespace coordConv {
         return Coord(); // null Coord
     }
 
+    void OtherCoordSys::fromFK5J2000(CoordArray &coordArr, CoordArray const &fk5J2000Arr, Site const &site) const {
+        coordArr.resize(fk5J2000Arr.size());
+        coordArr.pm.setConstant(DoubleNaN); // null Coords
+    }
+
+    void OtherCoordSys::toFK5J2000(CoordArray &fk5J2000Arr, CoordArray const &coordArr, Site const &site) const {
+        fk5J2000Arr.resize(coordArr.size());
+        fk5J2000Arr.pm.setConstant(DoubleNaN); // null Coords
+    }
+
+    Coord OtherCoordSys::fromFK5J2000(Eigen::Matrix3d &jacobian, Eigen::Vector3d &posRate, Coord const &coord, Site const &site) const {
+        jacobian.setConstant(DoubleNaN);
+        posRate.setConstant(DoubleNaN);
+        return Coord(); // null Coord
+    }
+
+    Coord OtherCoordSys::toFK5J2000(Eigen::Matrix3d &jacobian, Eigen::Vector3d &posRate, Coord const &coord, Site const &site) const {
+        jacobian.setConstant(DoubleNaN);
+        posRate.setConstant(DoubleNaN);
+        return Coord(); // null Coord
+    }
+
     std::string OtherCoordSys::__repr__() const {
         std::ostringstream os;
         os << "OtherCoordSys(name=" << getName() << ", isMean=" << isMean() << ", date=" << getDate() << ")";
@@ -0,0 +1,262 @@
+#include <algorithm>
+#include <sstream>
+#include <stdexcept>
+#include "boost/bind.hpp"
+#include "boost/function.hpp"
+#include "boost/make_shared.hpp"
+#include "boost/thread/mutex.hpp"
+#include "boost/thread/thread.hpp"
+#include "coordConv/parallelConverter.h"
+
+namespace {
+
+    /*
+    A function that processes one chunk; arguments are worker index and chunk index
+    */
+    typedef boost::function<void (int, std::size_t)> ChunkFunc;
+
+    /*
+    A range of chunk indices [begin, end) owned by one worker
+    */
+    class ChunkRange {
+    public:
+        explicit ChunkRange(std::size_t begin, std::size_t end) : begin(begin), end(end) {}
+        boost::mutex mutex;
+        std::size_t begin;
+        std::size_t end;
+    };
+
+    /*
+    Process chunks in parallel using work stealing
+
+    Each worker is initially given an equal contiguous range of chunks, which it processes from the front.
+    When a worker's range is empty it steals the back half of another worker's range.
+    Ranges only shrink, except when receiving a stolen range, so when a worker finds
+    every range empty all chunks have been (or are being) processed and it may stop.
+    */
+    class WorkStealingScheduler {
+    public:
+        explicit WorkStealingScheduler(int numWorkers, std::size_t numChunks, ChunkFunc const &chunkFunc)
+        :
+            _chunkFunc(chunkFunc),
+            _rangeList(),
+            _errorMutex(),
+            _hasError(false),
+            _errorMsg()
+        {
+            for (int workerInd = 0; workerInd < numWorkers; ++workerInd) {
+                std::size_t const begin = (numChunks * workerInd) / numWorkers;
+                std::size_t const end = (numChunks * (workerInd + 1)) / numWorkers;
+                _rangeList.push_back(boost::make_shared<ChunkRange>(begin, end));
+            }
+        }
+
+        /*
+        Process all chunks; the calling thread is worker 0
+
+        @throw std::runtime_error if processing a chunk threw an exception
+            (after all workers have stopped)
+        */
+        void run() {
+            boost::thread_group threadGroup;
+            for (int workerInd = 1; workerInd < static_cast<int>(_rangeList.size()); ++workerInd) {
+                threadGroup.create_thread(boost::bind(&WorkStealingScheduler::_runWorker, this, workerInd));
+            }
+            _runWorker(0);
+            threadGroup.join_all();
+            if (_hasError) {
+                throw std::runtime_error(_errorMsg);
+            }
+        }
+
+    private:
+        ChunkFunc _chunkFunc;
+        std::vector<boost::shared_ptr<ChunkRange> > _rangeList;
+        boost::mutex _errorMutex;   // protects _hasError and _errorMsg
+        bool _hasError;             // has processing a chunk failed?
+        std::string _errorMsg;      // message of the first failure
+
+        void _runWorker(int workerInd) {
+            try {
+                std::size_t chunkInd = 0;
+                while (true) {
+                    while (_popFront(workerInd, chunkInd)) {
+                        if (_checkError()) {
+                            return;
+                        }
+                        _chunkFunc(workerInd, chunkInd);
+                    }
+                    if (!_steal(workerInd)) {
+                        return;
+                    }
+                }
+            } catch (std::exception const &e) {
+                _setError(e.what());
+            } catch (...) {
+                _setError("unknown error");
+            }
+        }
+
+        /*
+        Pop the first chunk from a worker's own range; return false if the range is empty
+        */
+        bool _popFront(int workerInd, std::size_t &chunkInd) {
+            ChunkRange &range = *_rangeList[workerInd];
+            boost::mutex::scoped_lock lock(range.mutex);
+            if (range.begin >= range.end) {
+                return false;
+            }
+            chunkInd = range.begin++;
+            return true;
+        }
+
+        /*
+        Steal the back half of another worker's range; return false if every other range is empty
+        */
+        bool _steal(int workerInd) {
+            int const numWorkers = static_cast<int>(_rangeList.size());
+            for (int i = 1; i < numWorkers; ++i) {
+                ChunkRange &victim = *_rangeList[(workerInd + i) % numWorkers];
+                std::size_t begin, end;
+                {
+                    boost::mutex::scoped_lock lock(victim.mutex);
+                    if (victim.begin >= victim.end) {
+                        continue;
+                    }
+                    end = victim.end;
+                    begin = end - ((end - victim.begin + 1) / 2);
+                    victim.end = begin;
+                }
+                ChunkRange &range = *_rangeList[workerInd];
+                boost::mutex::scoped_lock lock(range.mutex);
+                range.begin = begin;
+                range.end = end;
+                return true;
+            }
+            return false;
+        }
+
+        bool _checkError() {
+            boost::mutex::scoped_lock lock(_errorMutex);
+            return _hasError;
+        }
+
+        void _setError(std::string const &msg) {
+            boost::mutex::scoped_lock lock(_errorMutex);
+            if (!_hasError) {
+                _hasError = true;
+                _errorMsg = msg;
+            }
+        }
+    };
+
+    /*
+    Return the number of chunks needed for a given number of items
+    */
+    std::size_t numChunksFor(std::size_t numItems, int chunkSize) {
+        return (numItems + chunkSize - 1) / chunkSize;
+    }
+
+}
+
+namespace coordConv {
+
+    ParallelConverter::ParallelConverter(CoordSys const &fromCoordSys, CoordSys const &toCoordSys, Site const &site,
+        double tai, int numThreads, int chunkSize)
+    :
+        _numThreads(numThreads),
+        _chunkSize(chunkSize),
+        _catalogConverterList(),
+        _fromArrList(),
+        _toArrList()
+    {
+        if (numThreads < 0) {
+            std::ostringstream os;
+            os << "numThreads = " << numThreads << " must be >= 0";
+            throw std::invalid_argument(os.str());
+        }
+        if (chunkSize < 1) {
+            std::ostringstream os;
+            os << "chunkSize = " << chunkSize << " must be >= 1";
+            throw std::invalid_argument(os.str());
+        }
+        if (_numThreads == 0) {
+            _numThreads = std::max(1, static_cast<int>(boost::thread::hardware_concurrency()));
+        }
+        for (int workerInd = 0; workerInd < _numThreads; ++workerInd) {
+            _catalogConverterList.push_back(boost::make_shared<CatalogConverter>(
+                fromCoordSys, toCoordSys, site, tai, chunkSize));
+        }
+        _fromArrList.resize(_numThreads);
+        _toArrList.resize(_numThreads);
+    }
+
+    void ParallelConverter::convert(CoordArray &toCoordArr, CoordArray const &fromCoordArr) {
+        std::size_t const numChunks = numChunksFor(fromCoordArr.size(), _chunkSize);
+        if (toCoordArr.size() != fromCoordArr.size()) {
+            toCoordArr.resize(fromCoordArr.size());
+        }
+        int const numWorkers = static_cast<int>(std::min(static_cast<std::size_t>(_numThreads), numChunks));
+        if (numWorkers == 0) {
+            return;
+        }
+        WorkStealingScheduler scheduler(numWorkers, numChunks,
+            boost::bind(&ParallelConverter::_convertArrayChunk, this, _1, _2, &toCoordArr, &fromCoordArr));
+        scheduler.run();
+    }
+
+    void ParallelConverter::convert(CatalogRecord *toRecords, CatalogRecord const *fromRecords, std::size_t numRecords) {
+        std::size_t const numChunks = numChunksFor(numRecords, _chunkSize);
+        int const numWorkers = static_cast<int>(std::min(static_cast<std::size_t>(_numThreads), numChunks));
+        if (numWorkers == 0) {
+            return;
+        }
+        WorkStealingScheduler scheduler(numWorkers, numChunks,
+            boost::bind(&ParallelConverter::_convertRecordChunk, this, _1, _2, toRecords, fromRecords, numRecords));
+        scheduler.run();
+    }
+
+    std::size_t ParallelConverter::convertFile(std::string const &toPath, std::string const &fromPath) {
+        MappedCatalog fromCatalog(fromPath);
+        MappedCatalog toCatalog(toPath, fromCatalog.size());
+        convert(toCatalog.getWritableRecords(), fromCatalog.getRecords(), fromCatalog.size());
+        toCatalog.flush();
+        return fromCatalog.size();
+    }
+
+    std::string ParallelConverter::__repr__() const {
+        std::ostringstream os;
+        os << *this;
+        return os.str();
+    }
+
+    void ParallelConverter::_convertArrayChunk(int workerInd, std::size_t chunkInd,
+        CoordArray *toCoordArr, CoordArray const *fromCoordArr
+    ) {
+        int const startInd = static_cast<int>(chunkInd * _chunkSize);
+        int const numInChunk = std::min(_chunkSize, fromCoordArr->size() - startInd);
+        CoordArray &fromArr = _fromArrList[workerInd];
+        CoordArray &toArr = _toArrList[workerInd];
+        fromArr.pos = fromCoordArr->pos.middleRows(startInd, numInChunk);
+        fromArr.pm = fromCoordArr->pm.middleRows(startInd, numInChunk);
+        _catalogConverterList[workerInd]->getPlan().convert(toArr, fromArr);
+        toCoordArr->pos.middleRows(startInd, numInChunk) = toArr.pos;
+        toCoordArr->pm.middleRows(startInd, numInChunk) = toArr.pm;
+    }
+
+    void ParallelConverter::_convertRecordChunk(int workerInd, std::size_t chunkInd,
+        CatalogRecord *toRecords, CatalogRecord const *fromRecords, std::size_t numRecords
+    ) {
+        std::size_t const startInd = chunkInd * _chunkSize;
+        std::size_t const numInChunk = std::min(static_cast<std::size_t>(_chunkSize), numRecords - startInd);
+        _catalogConverterList[workerInd]->convert(toRecords + startInd, fromRecords + startInd, numInChunk);
+    }
+
+    std::ostream &operator<<(std::ostream &os, ParallelConverter const &parallelConverter) {
+        os << "ParallelConverter(" << parallelConverter.getPlan()
+            << ", numThreads=" << parallelConverter.getNumThreads()
+            << ", chunkSize=" << parallelConverter.getChunkSize() << ")";
+        return os;
+    }
+
+}
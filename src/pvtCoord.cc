@@ -2,7 +2,6 @@
 #include <iomanip>
 #include <limits>
 #include <stdexcept>
-#include <vector>
 #include <boost/tr1/array.hpp> // so array works with old and new compilers
 
 #include "coordConv/mathUtils.h"
@@ -34,16 +33,16 @@ namespace coordConv {
             throw std::runtime_error(os.str());
         }
         double const tai = equatPVT.t;
-        std::vector<Coord> coordArr;
+        Coord coordPair[2];
         for (int i = 0; i < 2; ++i) {
             double evalTAI = tai + (i * DeltaT);
             double parallax = 0;
             if (distPVT.isfinite()) {
                 parallax = parallaxFromDistance(distPVT.getPos(evalTAI));
             }
-            coordArr.push_back(Coord(equatPVT.getPos(evalTAI), polarPVT.getPos(evalTAI), parallax));
+            coordPair[i] = Coord(equatPVT.getPos(evalTAI), polarPVT.getPos(evalTAI), parallax);
         }
-        _setFromCoordPair(coordArr[0], coordArr[1], tai, DeltaT);
+        _setFromCoordPair(coordPair[0], coordPair[1], tai, DeltaT);
     }
 
     PVTCoord::PVTCoord(PVT const &equatPVT, PVT const &polarPVT, PVT const &distPVT, double equatPM, double polarPM, double radVel) {
@@ -57,17 +56,17 @@ namespace coordConv {
             os << "distPVT is finite and distPVT.t = " << distPVT.t << " != " << equatPVT.t << " = equatPVT.t";
             throw std::runtime_error(os.str());
         }
-        std::vector<Coord> coordArr;
         double const tai = equatPVT.t;
+        Coord coordPair[2];
         for (int i = 0; i < 2; ++i) {
             double evalTAI = tai + (i * DeltaT);
             double parallax = 0;
             if (distPVT.isfinite()) {
                 parallax = parallaxFromDistance(distPVT.getPos(evalTAI));
             }
-            coordArr.push_back(Coord(equatPVT.getPos(evalTAI), polarPVT.getPos(evalTAI), parallax, equatPM, polarPM, radVel));
+            coordPair[i] = Coord(equatPVT.getPos(evalTAI), polarPVT.getPos(evalTAI), parallax, equatPM, polarPM, radVel);
         }
-        _setFromCoordPair(coordArr[0], coordArr[1], tai, DeltaT);
+        _setFromCoordPair(coordPair[0], coordPair[1], tai, DeltaT);
     }
 
     PVTCoord::PVTCoord() :
@@ -162,15 +161,29 @@ namespace coordConv {
     }
 
     PVTCoord PVTCoord::offset(PVT &toOrient, PVT const &fromOrient, PVT const &dist) const {
-        std::vector<Coord> coordArr;
+        PVTCoord toPVTCoord;
+        throwIfFailed(tryOffset(toPVTCoord, toOrient, fromOrient, dist));
+        return toPVTCoord;
+    }
+
+    ConvertStatusEnum PVTCoord::tryOffset(PVTCoord &toPVTCoord, PVT &toOrient, PVT const &fromOrient, PVT const &dist) const {
+        Coord coordPair[2];
         double toOrientArr[2];
         for (int i = 0; i < 2; ++i) {
             double evalTAI = _tai + (i * DeltaT);
             Coord unoffCoord = getCoord(evalTAI);
-            coordArr.push_back(unoffCoord.offset(toOrientArr[i], fromOrient.getPos(evalTAI), dist.getPos(evalTAI)));
+            ConvertStatusEnum const status = unoffCoord.tryOffset(coordPair[i], toOrientArr[i],
+                fromOrient.getPos(evalTAI), dist.getPos(evalTAI));
+            if (status != ConvertStatus_OK) {
+                toPVTCoord = PVTCoord();
+                toOrient.invalidate(_tai);
+                return status;
+            }
         }
-        toOrient.setFromPair(toOrientArr, _tai, DeltaT, true);
-        return PVTCoord(coordArr[0], coordArr[1], _tai, DeltaT);
+        double const tai = _tai; // in case toPVTCoord is this PVTCoord
+        toOrient.setFromPair(toOrientArr, tai, DeltaT, true);
+        toPVTCoord = PVTCoord(coordPair[0], coordPair[1], tai, DeltaT);
+        return ConvertStatus_OK;
     }
 
     std::string PVTCoord::__repr__() const {
@@ -0,0 +1,211 @@
+#include <cmath>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include "boost/functional/hash.hpp"
+#include "slalib.h"
+#include "coordConv/mathUtils.h"
+#include "coordConv/physConst.h"
+#include "coordConv/site.h"
+#include "coordConv/refCo.h"
+
+namespace {
+
+    // precision to which slaRefco computes refraction (rad); 2e-5 arcsec
+    double const RefCoPrecision = 1.0e-10;
+
+    /*
+    Throw std::invalid_argument if a resolution is not finite and > 0
+
+    @param[in] name  name of resolution argument
+    @param[in] res  value of resolution argument
+    */
+    void checkRes(char const *name, double res) {
+        if (!(res > 0) || !std::isfinite(res)) {
+            std::ostringstream os;
+            os << name << " = " << res << " must be finite and > 0";
+            throw std::invalid_argument(os.str());
+        }
+    }
+
+    /*
+    Round a value to the nearest multiple of a resolution
+
+    @param[in] name  name of value (for the error message)
+    @param[in] val  value
+    @param[in] res  resolution
+    @return val / res, rounded to the nearest integer
+    @throw std::invalid_argument if val is not finite or val / res is too large to represent
+    */
+    long quantize(char const *name, double val, double res) {
+        double const scaledVal = std::floor((val / res) + 0.5);
+        if (!std::isfinite(scaledVal) || (std::abs(scaledVal) > std::numeric_limits<long>::max() / 2)) {
+            std::ostringstream os;
+            os << name << " = " << val << " is not finite or is too large";
+            throw std::invalid_argument(os.str());
+        }
+        return static_cast<long>(scaledVal);
+    }
+}
+
+namespace coordConv {
+
+    void refCoFromWeather(
+        double &refCoA,
+        double &refCoB,
+        Site const &site,
+        double pressure,
+        double temp,
+        double relHumidity,
+        double wavelen,
+        double lapseRate
+    ) {
+        if (!std::isfinite(pressure) || !std::isfinite(temp) || !std::isfinite(relHumidity)
+            || !std::isfinite(wavelen) || !std::isfinite(lapseRate)) {
+            std::ostringstream os;
+            os << "pressure=" << pressure << ", temp=" << temp << ", relHumidity=" << relHumidity
+                << ", wavelen=" << wavelen << ", lapseRate=" << lapseRate << ": all must be finite";
+            throw std::invalid_argument(os.str());
+        }
+        if (pressure < 0) {
+            std::ostringstream os;
+            os << "pressure = " << pressure << " must be >= 0";
+            throw std::invalid_argument(os.str());
+        }
+        if (temp <= -DegK_DegC) {
+            std::ostringstream os;
+            os << "temp = " << temp << " must be > " << -DegK_DegC;
+            throw std::invalid_argument(os.str());
+        }
+        if ((relHumidity < 0) || (relHumidity > 1)) {
+            std::ostringstream os;
+            os << "relHumidity = " << relHumidity << " not in range [0, 1]";
+            throw std::invalid_argument(os.str());
+        }
+        if (wavelen <= 0) {
+            std::ostringstream os;
+            os << "wavelen = " << wavelen << " must be > 0";
+            throw std::invalid_argument(os.str());
+        }
+
+        double refCoARad, refCoBRad;
+        slaRefco(
+            site.elev,
+            temp + DegK_DegC,
+            pressure,
+            relHumidity,
+            wavelen / AngstromsPerMicron,
+            site.corrLat * RadPerDeg,
+            lapseRate,
+            RefCoPrecision,
+            &refCoARad,
+            &refCoBRad
+        );
+        refCoA = refCoARad / RadPerDeg;
+        refCoB = refCoBRad / RadPerDeg;
+    }
+
+    bool RefCoCache::Key::operator==(Key const &rhs) const {
+        return (pressure == rhs.pressure) && (temp == rhs.temp) && (relHumidity == rhs.relHumidity)
+            && (wavelen == rhs.wavelen) && (lapseRate == rhs.lapseRate)
+            && (elev == rhs.elev) && (corrLat == rhs.corrLat);
+    }
+
+    std::size_t RefCoCache::KeyHash::operator()(Key const &key) const {
+        std::size_t seed = 0;
+        boost::hash_combine(seed, key.pressure);
+        boost::hash_combine(seed, key.temp);
+        boost::hash_combine(seed, key.relHumidity);
+        boost::hash_combine(seed, key.wavelen);
+        boost::hash_combine(seed, key.lapseRate);
+        boost::hash_combine(seed, key.elev);
+        boost::hash_combine(seed, key.corrLat);
+        return seed;
+    }
+
+    RefCoCache::RefCoCache(
+        double pressureRes,
+        double tempRes,
+        double relHumidityRes,
+        double wavelenRes,
+        double lapseRateRes,
+        int maxSize
+    ) :
+        _pressureRes(pressureRes),
+        _tempRes(tempRes),
+        _relHumidityRes(relHumidityRes),
+        _wavelenRes(wavelenRes),
+        _lapseRateRes(lapseRateRes),
+        _maxSize(maxSize),
+        _mutex(),
+        _refCoMap()
+    {
+        checkRes("pressureRes", pressureRes);
+        checkRes("tempRes", tempRes);
+        checkRes("relHumidityRes", relHumidityRes);
+        checkRes("wavelenRes", wavelenRes);
+        checkRes("lapseRateRes", lapseRateRes);
+        if (maxSize < 1) {
+            std::ostringstream os;
+            os << "maxSize = " << maxSize << " must be >= 1";
+            throw std::invalid_argument(os.str());
+        }
+    }
+
+    double RefCoCache::getRefCo(
+        double &refCoA,
+        double &refCoB,
+        Site const &site,
+        double pressure,
+        double temp,
+        double relHumidity,
+        double wavelen,
+        double lapseRate
+    ) const {
+        Key key;
+        key.pressure = quantize("pressure", pressure, _pressureRes);
+        key.temp = quantize("temp", temp, _tempRes);
+        key.relHumidity = quantize("relHumidity", relHumidity, _relHumidityRes);
+        key.wavelen = quantize("wavelen", wavelen, _wavelenRes);
+        key.lapseRate = quantize("lapseRate", lapseRate, _lapseRateRes);
+        key.elev = site.elev;
+        key.corrLat = site.corrLat;
+
+        {
+            boost::mutex::scoped_lock lock(_mutex);
+            RefCoMap::const_iterator const it = _refCoMap.find(key);
+            if (it != _refCoMap.end()) {
+                refCoA = it->second.first;
+                refCoB = it->second.second;
+                return key.wavelen * _wavelenRes;
+            }
+        }
+
+        // compute outside the lock, since slaRefco is slow; if two threads compute the same entry
+        // at the same time they get the same answer, so it does not matter which one is kept
+        refCoFromWeather(refCoA, refCoB, site,
+            key.pressure * _pressureRes,
+            key.temp * _tempRes,
+            key.relHumidity * _relHumidityRes,
+            key.wavelen * _wavelenRes,
+            key.lapseRate * _lapseRateRes);
+
+        boost::mutex::scoped_lock lock(_mutex);
+        if (static_cast<int>(_refCoMap.size()) >= _maxSize) {
+            _refCoMap.clear();
+        }
+        _refCoMap[key] = std::make_pair(refCoA, refCoB);
+        return key.wavelen * _wavelenRes;
+    }
+
+    int RefCoCache::size() const {
+        boost::mutex::scoped_lock lock(_mutex);
+        return static_cast<int>(_refCoMap.size());
+    }
+
+    void RefCoCache::clear() {
+        boost::mutex::scoped_lock lock(_mutex);
+        _refCoMap.clear();
+    }
+
+}
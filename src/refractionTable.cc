@@ -0,0 +1,177 @@
+#include <cmath>
+#include <sstream>
+#include <stdexcept>
+#include "coordConv/mathUtils.h"
+#include "coordConv/physConst.h"
+#include "coordConv/site.h"
+#include "coordConv/refractionTable.h"
+
+namespace {
+
+    // maximum number of Newton-Raphson iterations used to compute refraction at one grid point;
+    // far more than needed for any sensible refraction coefficients
+    int const MaxIter = 20;
+
+    // Newton-Raphson iteration stops when the change in zdr is no larger than this (deg)
+    double const ZDTol = 1e-14;
+
+    /*
+    Compute zdu - zdr and its derivative with respect to zdr, given zdr
+
+    @param[out] deriv  d(zdu - zdr)/d(zdr)
+    @param[in] zdr  refracted zenith distance (deg)
+    @param[in] refCoA  A refraction coefficient (deg)
+    @param[in] refCoB  B refraction coefficient (deg)
+    @return zdu - zdr (deg)
+    */
+    double zduMinusZDrExact(double &deriv, double zdr, double refCoA, double refCoB) {
+        double const tanZD = coordConv::tand(zdr);
+        double const cosZD = coordConv::cosd(zdr);
+        deriv = coordConv::RadPerDeg * (refCoA + (3.0 * refCoB * tanZD * tanZD)) / (cosZD * cosZD);
+        return (refCoA * tanZD) + (refCoB * tanZD * tanZD * tanZD);
+    }
+
+    /*
+    Compute zdr - zdu and its derivative with respect to zdu, given zdu
+
+    Uses Newton-Raphson iteration, starting from zdr = zdu, as does obsFromAppTopo, but iterates to convergence.
+
+    @param[out] deriv  d(zdr - zdu)/d(zdu)
+    @param[in] zdu  unrefracted zenith distance (deg)
+    @param[in] refCoA  A refraction coefficient (deg)
+    @param[in] refCoB  B refraction coefficient (deg)
+    @return zdr - zdu (deg)
+    @throw std::runtime_error if the iteration does not converge
+    */
+    double zdrMinusZDuExact(double &deriv, double zdu, double refCoA, double refCoB) {
+        double zdr_u = 0.0;
+        for (int iter = 0; iter < MaxIter; ++iter) {
+            double gDeriv;
+            double const g = zduMinusZDrExact(gDeriv, zdu + zdr_u, refCoA, refCoB);
+            double const delta = (zdr_u + g) / (1.0 + gDeriv);
+            zdr_u -= delta;
+            if (std::abs(delta) <= ZDTol) {
+                zduMinusZDrExact(gDeriv, zdu + zdr_u, refCoA, refCoB);
+                deriv = - gDeriv / (1.0 + gDeriv);
+                return zdr_u;
+            }
+        }
+        std::ostringstream os;
+        os << "Refraction did not converge at zdu=" << zdu << " with refCoA=" << refCoA << ", refCoB=" << refCoB;
+        throw std::runtime_error(os.str());
+    }
+
+    /*
+    Set the coefficients of one interval of a cubic Hermite spline
+
+    @param[out] coeffs  4 coefficients, constant term first, as a function of fractional position in the interval
+    @param[in] val0, val1  value at start and end of interval
+    @param[in] deriv0, deriv1  derivative at start and end of interval, in units of value per interval
+    */
+    void setHermiteCoeffs(double *coeffs, double val0, double val1, double deriv0, double deriv1) {
+        coeffs[0] = val0;
+        coeffs[1] = deriv0;
+        coeffs[2] = (3.0 * (val1 - val0)) - (2.0 * deriv0) - deriv1;
+        coeffs[3] = (2.0 * (val0 - val1)) + deriv0 + deriv1;
+    }
+
+    /*
+    Set the coefficients of the final (constant) interval of a table
+    */
+    void setConstCoeffs(double *coeffs, double val) {
+        coeffs[0] = val;
+        coeffs[1] = 0.0;
+        coeffs[2] = 0.0;
+        coeffs[3] = 0.0;
+    }
+}
+
+namespace coordConv {
+
+    RefractionTable::RefractionTable(double refCoA, double refCoB, int numIntervals)
+    :
+        refCoA(refCoA),
+        refCoB(refCoB),
+        _numIntervals(numIntervals),
+        _obsScale(),
+        _appTopoScale(),
+        _obsCoeffs(),
+        _appTopoCoeffs()
+    {
+        if (numIntervals < 1) {
+            std::ostringstream os;
+            os << "numIntervals = " << numIntervals << " must be >= 1";
+            throw std::invalid_argument(os.str());
+        }
+        _obsCoeffs.resize(4 * (numIntervals + 1));
+        _appTopoCoeffs.resize(4 * (numIntervals + 1));
+
+        // zdr - zdu as a function of zdu, on a grid from 0 to ZDu_Max
+        double const obsStep = ZDu_Max / numIntervals;
+        _obsScale = 1.0 / obsStep;
+        double deriv0;
+        double val0 = zdrMinusZDuExact(deriv0, 0.0, refCoA, refCoB);
+        for (int i = 0; i < numIntervals; ++i) {
+            double deriv1;
+            double const val1 = zdrMinusZDuExact(deriv1, ZDu_Max * (i + 1) / numIntervals, refCoA, refCoB);
+            setHermiteCoeffs(&_obsCoeffs[4 * i], val0, val1, deriv0 * obsStep, deriv1 * obsStep);
+            val0 = val1;
+            deriv0 = deriv1;
+        }
+        double const maxZDr_u = val0;
+        setConstCoeffs(&_obsCoeffs[4 * numIntervals], maxZDr_u);
+
+        // zdu - zdr as a function of zdr, on a grid from 0 to the zdr at which zdu = ZDu_Max
+        double const maxZDr = ZDu_Max + maxZDr_u;
+        if (!(maxZDr > 0)) {
+            std::ostringstream os;
+            os << "Refraction at zdu=" << ZDu_Max << " with refCoA=" << refCoA << ", refCoB=" << refCoB
+                << " gives zdr=" << maxZDr << " <= 0";
+            throw std::runtime_error(os.str());
+        }
+        double const appTopoStep = maxZDr / numIntervals;
+        _appTopoScale = 1.0 / appTopoStep;
+        val0 = zduMinusZDrExact(deriv0, 0.0, refCoA, refCoB);
+        for (int i = 0; i < numIntervals; ++i) {
+            double deriv1;
+            double const val1 = zduMinusZDrExact(deriv1, maxZDr * (i + 1) / numIntervals, refCoA, refCoB);
+            setHermiteCoeffs(&_appTopoCoeffs[4 * i], val0, val1, deriv0 * appTopoStep, deriv1 * appTopoStep);
+            val0 = val1;
+            deriv0 = deriv1;
+        }
+        setConstCoeffs(&_appTopoCoeffs[4 * numIntervals], -maxZDr_u);
+    }
+
+    RefractionCache::RefractionCache(int numIntervals)
+    :
+        _numIntervals(numIntervals),
+        _tablePtr()
+    {
+        if (numIntervals < 1) {
+            std::ostringstream os;
+            os << "numIntervals = " << numIntervals << " must be >= 1";
+            throw std::invalid_argument(os.str());
+        }
+    }
+
+    RefractionTable::ConstPtr RefractionCache::getTable(double refCoA, double refCoB) const {
+        RefractionTable::ConstPtr tablePtr = getTable();
+        if (!tablePtr || (tablePtr->refCoA != refCoA) || (tablePtr->refCoB != refCoB)) {
+            tablePtr.reset(new RefractionTable(refCoA, refCoB, _numIntervals));
+            boost::atomic_store(&_tablePtr, tablePtr);
+        }
+        return tablePtr;
+    }
+
+    RefractionTable::ConstPtr RefractionCache::getTable() const {
+        return boost::atomic_load(&_tablePtr);
+    }
+
+    RefractionTable::ConstPtr getRefractionTable(Site const &site) {
+        if (!site.refractionCachePtr) {
+            return RefractionTable::ConstPtr();
+        }
+        return site.refractionCachePtr->getTable(site.refCoA, site.refCoB);
+    }
+
+}
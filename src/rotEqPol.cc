@@ -3,10 +3,10 @@
 namespace coordConv {
 
     void rotEqPol(Eigen::Vector3d &toVec, Eigen::Vector3d const &fromVec, double eqAng, double polarAng) {
-        double const sinEq = sind(eqAng);
-        double const cosEq = cosd(eqAng);
-        double const sinPol = sind(polarAng);
-        double const cosPol = cosd(polarAng);
+        double sinEq, cosEq;
+        sincosd(sinEq, cosEq, eqAng);
+        double sinPol, cosPol;
+        sincosd(sinPol, cosPol, polarAng);
 
         Eigen::Matrix3d rotMat;
         rotMat <<
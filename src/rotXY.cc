@@ -4,10 +4,10 @@ namespace coordConv {
 
     void rotXY(Eigen::Vector3d &toVec, Eigen::Vector3d const &fromVec, double xAng, double yAng) {
 
-        double const sinX = sind(xAng);
-        double const cosX = cosd(xAng);
-        double const sinY = sind(yAng);
-        double const cosY = cosd(yAng);
+        double sinX, cosX;
+        sincosd(sinX, cosX, xAng);
+        double sinY, cosY;
+        sincosd(sinY, cosY, yAng);
 
         Eigen::Matrix3d rotMat;
         rotMat <<
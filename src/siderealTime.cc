@@ -0,0 +1,69 @@
+#include <cmath>
+#include <sstream>
+#include <stdexcept>
+#include "slalib.h"
+#include "coordConv/mathUtils.h"
+#include "coordConv/physConst.h"
+#include "coordConv/site.h"
+#include "coordConv/siderealTime.h"
+
+namespace {
+    // half of the interval over which to compute the rate of GMST by finite differences (days);
+    // long, to reduce the effect of round-off error in GMST
+    const double GMSTHalfInterval = 1.0;
+    // half of the interval over which to compute the rate of the equation of the equinoxes
+    // by finite differences (days); short compared to the shortest nutation period
+    const double EqEquinoxHalfInterval = 0.01;
+}
+
+namespace coordConv {
+
+    SiderealTimeData::SiderealTimeData(double ut1, double tt)
+    :
+        ut1(ut1),
+        tt(tt)
+    {
+        double const ut1Days = ut1 / SecPerDay;
+        gmst = slaGmst(ut1Days) / RadPerDeg;
+        // GMST wraps many times over the interval, so correct a nominal change rather than computing it directly
+        double const nominalDelta = 2 * GMSTHalfInterval * 360.0 * SiderealPerSolar;
+        double const gmstDelta = nominalDelta + wrapCtr(
+            ((slaGmst(ut1Days + GMSTHalfInterval) - slaGmst(ut1Days - GMSTHalfInterval)) / RadPerDeg) - nominalDelta);
+        gmstRate = gmstDelta / (2 * GMSTHalfInterval * SecPerDay);
+
+        double const ttDays = tt / SecPerDay;
+        eqEquinox = slaEqeqx(ttDays) / RadPerDeg;
+        double const eqEquinoxDelta = (slaEqeqx(ttDays + EqEquinoxHalfInterval) - slaEqeqx(ttDays - EqEquinoxHalfInterval)) / RadPerDeg;
+        eqEquinoxRate = eqEquinoxDelta / (2 * EqEquinoxHalfInterval * SecPerDay);
+    }
+
+    SiderealTimeCache::SiderealTimeCache(double maxAge)
+    :
+        _maxAge(maxAge),
+        _dataPtr()
+    {
+        if (maxAge < 0) {
+            std::ostringstream os;
+            os << "maxAge = " << maxAge << " must be >= 0";
+            throw std::invalid_argument(os.str());
+        }
+    }
+
+    double SiderealTimeCache::getLAST(double tai, Site const &site) const {
+        double const ut1 = tai + site.ut1_tai;
+        double const tt = tai + TT_TAI;
+        SiderealTimeData::ConstPtr dataPtr = getData();
+        if (!dataPtr || (std::abs(tt - dataPtr->tt) > _maxAge)) {
+            dataPtr.reset(new SiderealTimeData(ut1, tt));
+            boost::atomic_store(&_dataPtr, dataPtr);
+        }
+        double const gmst = dataPtr->gmst + (dataPtr->gmstRate * (ut1 - dataPtr->ut1));
+        double const appMinusMean = dataPtr->eqEquinox + (dataPtr->eqEquinoxRate * (tt - dataPtr->tt));
+        return wrapPos(gmst + site.corrLong + appMinusMean);
+    }
+
+    SiderealTimeData::ConstPtr SiderealTimeCache::getData() const {
+        return boost::atomic_load(&_dataPtr);
+    }
+
+}
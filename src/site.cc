@@ -23,7 +23,10 @@ namespace coordConv {
             refCoB(0),
             azCorr(0),
             diurAbMag(0),
-            pos(Eigen::Vector3d::Constant(0.0))
+            pos(Eigen::Vector3d::Constant(0.0)),
+            lastCachePtr(),
+            refractionCachePtr(),
+            refCoCachePtr()
         {
             if ((meanLat < -90) || (meanLat > 90)) {
                 std::ostringstream os;
@@ -59,6 +62,22 @@ namespace coordConv {
         diurAbMag = polarDist * SidRate / VLight;
     }
 
+    void Site::setRefCoFromWeather(double pressure, double temp, double relHumidity, double wavelen,
+        double lapseRate
+    ) {
+        double newRefCoA, newRefCoB;
+        double newWavelen = wavelen;
+        if (refCoCachePtr) {
+            newWavelen = refCoCachePtr->getRefCo(newRefCoA, newRefCoB, *this,
+                pressure, temp, relHumidity, wavelen, lapseRate);
+        } else {
+            refCoFromWeather(newRefCoA, newRefCoB, *this, pressure, temp, relHumidity, wavelen, lapseRate);
+        }
+        this->wavelen = newWavelen;
+        refCoA = newRefCoA;
+        refCoB = newRefCoB;
+    }
+
     std::string Site::__repr__() const {
         std::ostringstream os;
         os << "site.meanLong=" << meanLong << "\n";
@@ -0,0 +1,91 @@
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+#include "coordConv/coord.h"
+#include "coordConv/catalogConverter.h"
+#include "coordConv/parallelConverter.h"
+#include "coordConv/sphArray.h"
+
+namespace {
+
+    /*
+    Check that an array of spherical coordinates has 6 columns
+
+    @throw std::invalid_argument if not
+    */
+    void checkSphArray(Eigen::MatrixXd const &sphArr) {
+        if (sphArr.cols() != 6) {
+            std::ostringstream os;
+            os << "sphArr has " << sphArr.cols() << " columns; must have 6: "
+                << "equatAng, polarAng, parallax, equatPM, polarPM, radVel";
+            throw std::invalid_argument(os.str());
+        }
+    }
+
+}
+
+namespace coordConv {
+
+    Eigen::MatrixXd convertSphArray(CoordSys const &fromCoordSys, CoordSys const &toCoordSys,
+        Eigen::MatrixXd const &fromSphArr, Site const &site, double tai, int numThreads
+    ) {
+        checkSphArray(fromSphArr);
+        int const numPos = fromSphArr.rows();
+        ParallelConverter converter(fromCoordSys, toCoordSys, site, tai, numThreads);
+
+        // CatalogRecord is a row of 6 doubles, whereas Eigen::MatrixXd is column-major, so copy
+        std::vector<CatalogRecord> recordList(numPos);
+        for (int i = 0; i < numPos; ++i) {
+            CatalogRecord &rec = recordList[i];
+            rec.equatAng = fromSphArr(i, 0);
+            rec.polarAng = fromSphArr(i, 1);
+            rec.parallax = fromSphArr(i, 2);
+            rec.equatPM  = fromSphArr(i, 3);
+            rec.polarPM  = fromSphArr(i, 4);
+            rec.radVel   = fromSphArr(i, 5);
+        }
+        if (numPos > 0) {
+            converter.convert(&recordList[0], &recordList[0], numPos);
+        }
+
+        Eigen::MatrixXd toSphArr(numPos, 6);
+        for (int i = 0; i < numPos; ++i) {
+            CatalogRecord const &rec = recordList[i];
+            toSphArr.row(i) << rec.equatAng, rec.polarAng, rec.parallax, rec.equatPM, rec.polarPM, rec.radVel;
+        }
+        return toSphArr;
+    }
+
+    Eigen::MatrixXd convertSphDirArray(CoordSys const &fromCoordSys, CoordSys const &toCoordSys,
+        Eigen::MatrixXd const &fromSphArr, Eigen::VectorXd const &fromDirArr, Site const &site, double tai,
+        OrientationMethodEnum orientMethod
+    ) {
+        checkSphArray(fromSphArr);
+        int const numPos = fromSphArr.rows();
+        if (fromDirArr.size() != numPos) {
+            std::ostringstream os;
+            os << "fromDirArr has " << fromDirArr.size() << " elements; must have " << numPos
+                << " (one per row of fromSphArr)";
+            throw std::invalid_argument(os.str());
+        }
+        // use copies of the coordinate systems, since converting sets the date of current coordinate systems
+        CoordSys::Ptr fromCoordSysPtr = fromCoordSys.clone();
+        CoordSys::Ptr toCoordSysPtr = toCoordSys.clone();
+
+        Eigen::MatrixXd toSphDirArr(numPos, 8);
+        for (int i = 0; i < numPos; ++i) {
+            Coord const fromCoord(fromSphArr(i, 0), fromSphArr(i, 1), fromSphArr(i, 2),
+                fromSphArr(i, 3), fromSphArr(i, 4), fromSphArr(i, 5));
+            double toDir, scaleChange;
+            Coord const toCoord = toCoordSysPtr->convertFrom(toDir, scaleChange,
+                *fromCoordSysPtr, fromCoord, fromDirArr(i), site, tai, orientMethod);
+            double equatAng, polarAng, equatPM, polarPM;
+            toCoord.getSphPos(equatAng, polarAng);
+            toCoord.getPM(equatPM, polarPM);
+            toSphDirArr.row(i) << equatAng, polarAng, toCoord.getParallax(), equatPM, polarPM, toCoord.getRadVel(),
+                toDir, scaleChange;
+        }
+        return toSphDirArr;
+    }
+
+}
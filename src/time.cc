@@ -16,6 +16,10 @@ namespace {
 namespace coordConv {
 
     double lastFromTAI(double tai, Site const &site) {
+        if (site.lastCachePtr) {
+            return site.lastCachePtr->getLAST(tai, site);
+        }
+
         // compute Greenwich mean sidereal time, in degrees
         double ut1Days = (tai + site.ut1_tai) / SecPerDay;
         double gmst = slaGmst(ut1Days) / RadPerDeg;
@@ -0,0 +1,136 @@
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+#include "coordConv/mathUtils.h"
+#include "coordConv/physConst.h"
+#include "coordConv/time.h"
+#include "coordConv/appTopoFromAppGeo.h"
+#include "coordConv/obsFromAppTopo.h"
+#include "coordConv/tracker.h"
+
+namespace {
+    // rate of change of local apparent sidereal time with TAI (deg/sec)
+    const double LASTRate = 360.0 * coordConv::SiderealPerSolar / coordConv::SecPerDay;
+}
+
+namespace coordConv {
+
+    Tracker::Tracker(CoordSys const &fromCoordSys, CoordSys const &toCoordSys, Site const &site, double maxDTAI)
+    :
+        _fromCoordSysPtr(fromCoordSys.clone()),
+        _toCoordSysPtr(toCoordSys.clone()),
+        _isObs(toCoordSys.getName() == "obs"),
+        _site(site),
+        _maxDTAI(maxDTAI),
+        _prepTAI(DoubleNaN),
+        _prepLAST(DoubleNaN),
+        _appGeoCoordSys()
+    {
+        if (!fromCoordSys.isMean()) {
+            std::ostringstream os;
+            os << "fromCoordSys = " << fromCoordSys.getName() << " must be a mean coordinate system";
+            throw std::invalid_argument(os.str());
+        }
+        if ((toCoordSys.getName() != "apptopo") && (toCoordSys.getName() != "obs")) {
+            std::ostringstream os;
+            os << "toCoordSys = " << toCoordSys.getName() << " must be apptopo or obs";
+            throw std::invalid_argument(os.str());
+        }
+        if (!toCoordSys.isCurrent()) {
+            std::ostringstream os;
+            os << "toCoordSys = " << toCoordSys.getName() << " must be current (date = 0)";
+            throw std::invalid_argument(os.str());
+        }
+        if (!(maxDTAI > 0)) {
+            std::ostringstream os;
+            os << "maxDTAI = " << maxDTAI << " must be > 0";
+            throw std::invalid_argument(os.str());
+        }
+    }
+
+    void Tracker::prepare(double taiAhead) {
+        double const startTime = monotonicSec();
+        _appGeoCoordSys.setDate(_appGeoCoordSys.dateFromTAI(taiAhead));
+        _prepLAST = lastFromTAI(taiAhead, _site);
+        _prepTAI = taiAhead;
+        _histList[TrackerStage_Prepare].record(monotonicSec() - startTime);
+    }
+
+    bool Tracker::isPrepared(double tai) const {
+        return std::abs(tai - _prepTAI) <= _maxDTAI; // false if _prepTAI is NaN
+    }
+
+    Coord Tracker::convert(Coord const &fromCoord, double tai) {
+        double const startTime = monotonicSec();
+        if (!isPrepared(tai)) {
+            std::ostringstream os;
+            os << std::setprecision(15) << "not prepared for tai = " << tai << "; prepared tai = " << _prepTAI
+                << " and maxDTAI = " << _maxDTAI;
+            throw std::runtime_error(os.str());
+        }
+
+        // convert to apparent geocentric; setting the date of a current mean coordinate system is cheap
+        if (_fromCoordSysPtr->isCurrent()) {
+            _fromCoordSysPtr->setCurrDate(_fromCoordSysPtr->dateFromTAI(tai));
+        }
+        Coord fk5J2000Coord = _fromCoordSysPtr->toFK5J2000(fromCoord, _site);
+        Coord appGeoCoord = _appGeoCoordSys.fromFK5J2000(fk5J2000Coord, _site);
+        double const appGeoTime = monotonicSec();
+        _histList[TrackerStage_AppGeo].record(appGeoTime - startTime);
+
+        // convert to apparent topocentric using extrapolated LAST
+        double const last = wrapPos(_prepLAST + (LASTRate * (tai - _prepTAI)));
+        Coord appTopoCoord = appTopoFromAppGeoAtLAST(appGeoCoord, _site, last);
+        double const appTopoTime = monotonicSec();
+        _histList[TrackerStage_AppTopo].record(appTopoTime - appGeoTime);
+
+        if (!_isObs) {
+            _histList[TrackerStage_Convert].record(appTopoTime - startTime);
+            return appTopoCoord;
+        }
+
+        Coord obsCoord = obsFromAppTopo(appTopoCoord, _site);
+        double const obsTime = monotonicSec();
+        _histList[TrackerStage_Obs].record(obsTime - appTopoTime);
+        _histList[TrackerStage_Convert].record(obsTime - startTime);
+        return obsCoord;
+    }
+
+    LatencyStats Tracker::getStats(TrackerStageEnum stage) const {
+        if ((stage < 0) || (stage >= TrackerStage_NumStages)) {
+            std::ostringstream os;
+            os << "stage = " << stage << " invalid";
+            throw std::invalid_argument(os.str());
+        }
+        return _histList[stage].getStats();
+    }
+
+    void Tracker::resetStats() {
+        for (int i = 0; i < TrackerStage_NumStages; ++i) {
+            _histList[i].reset();
+        }
+    }
+
+    void Tracker::setSite(Site const &site) {
+        _site = site;
+        _prepTAI = DoubleNaN;
+        _prepLAST = DoubleNaN;
+    }
+
+    std::string Tracker::__repr__() const {
+        std::ostringstream os;
+        os << *this;
+        return os.str();
+    }
+
+    std::ostream &operator<<(std::ostream &os, Tracker const &tracker) {
+        std::streamsize const oldPrecision = os.precision();
+        os << "Tracker(" << *tracker.getFromCoordSys() << ", " << *tracker.getToCoordSys()
+            << ", maxDTAI=" << tracker.getMaxDTAI()
+            << ", preparedTAI=" << std::setprecision(15) << tracker.getPreparedTAI() << ")"
+            << std::setprecision(oldPrecision);
+        return os;
+    }
+
+}
@@ -0,0 +1,33 @@
+#!/usr/bin/env python
+from __future__ import absolute_import, division
+
+import unittest
+import numpy
+import coordConv
+
+class TestAberration(unittest.TestCase):
+    """Test addAnnualAberration, removeAnnualAberration and removeAnnualAberrationIter
+    """
+    def testRoundTrip(self):
+        """Test that removeAnnualAberration inverts addAnnualAberration and matches removeAnnualAberrationIter
+        """
+        for bcBeta in (
+            numpy.array((0, 0, 0)),
+            numpy.array((1.0e-4, 0, 0)),
+            numpy.array((-6.2e-5, 7.1e-5, 3.0e-5)),
+            numpy.array((0.02, -0.01, 0.005)), # much larger than the Earth's velocity
+        ):
+            gammaI = numpy.sqrt(1.0 - numpy.dot(bcBeta, bcBeta))
+            for equatAng in (0, 45, 190):
+                for polarAng in (-89.9, -30, 0, 60, 90):
+                    for parallax in (0, 1e-3, 1):
+                        pos = coordConv.Coord(equatAng, polarAng, parallax).getVecPos()
+                        posMag = numpy.linalg.norm(pos)
+                        aberPos = coordConv.addAnnualAberration(pos, bcBeta, gammaI)
+                        self.assertAlmostEqual(numpy.linalg.norm(aberPos) / posMag, 1.0)
+                        for removeFunc in (coordConv.removeAnnualAberration, coordConv.removeAnnualAberrationIter):
+                            predPos = removeFunc(aberPos, bcBeta, gammaI)
+                            self.assertLess(numpy.linalg.norm(predPos - pos) / posMag, 1e-10)
+
+if __name__ == '__main__':
+    unittest.main()
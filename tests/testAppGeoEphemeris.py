@@ -0,0 +1,106 @@
+#!/usr/bin/env python
+from __future__ import absolute_import, division
+
+import os
+import shutil
+import tempfile
+import unittest
+
+import numpy
+
+import coordConv
+
+class TestAppGeoEphemeris(unittest.TestCase):
+    def setUp(self):
+        self.startDate = 2015.3
+        self.endDate = self.startDate + (1.2 / coordConv.DaysPerYear)
+        self.ephem = coordConv.AppGeoEphemeris(self.startDate, self.endDate)
+        self.tempDir = tempfile.mkdtemp()
+
+    def tearDown(self):
+        shutil.rmtree(self.tempDir)
+
+    def assertDataAlmostEqual(self, data1, data2):
+        self.assertAlmostEqual(data1.date, data2.date)
+        self.assertAlmostEqual(data1.pmSpan, data2.pmSpan)
+        self.assertAlmostEqual(data1.gravRad, data2.gravRad)
+        self.assertAlmostEqual(data1.gammaI, data2.gammaI, 14)
+        for name in ("bcPos", "hcDir", "bcBeta", "pnMat"):
+            self.assertLess(numpy.max(numpy.abs(getattr(data1, name) - getattr(data2, name))), 1e-11)
+
+    def testBasics(self):
+        """Test construction, range and interpolation
+        """
+        ephem = self.ephem
+        self.assertEqual(ephem.getStartDate(), self.startDate)
+        self.assertAlmostEqual(ephem.getInterval(), coordConv.AppGeoEphemerisInterval)
+        self.assertEqual(ephem.size(), 6)
+        self.assertGreaterEqual(ephem.getEndDate(), self.endDate)
+        self.assertTrue(ephem.contains(self.startDate))
+        self.assertTrue(ephem.contains(self.endDate))
+        self.assertFalse(ephem.contains(self.startDate - 1e-9))
+        self.assertFalse(ephem.contains(ephem.getEndDate() + 1e-9))
+        self.assertEqual(ephem.getPath(), "")
+
+        for date in numpy.linspace(ephem.getStartDate(), ephem.getEndDate(), 37):
+            self.assertDataAlmostEqual(ephem.getData(date), coordConv.AppGeoData(date))
+
+        self.assertRaises(RuntimeError, ephem.getData, self.startDate - 0.1)
+        self.assertRaises(RuntimeError, ephem.getData, ephem.getEndDate() + 0.1)
+        self.assertRaises(ValueError, coordConv.AppGeoEphemeris, self.endDate, self.startDate)
+        self.assertRaises(ValueError, coordConv.AppGeoEphemeris, self.startDate, self.endDate, 0)
+
+    def testFile(self):
+        """Test writing and reading ephemeris files
+        """
+        path = os.path.join(self.tempDir, "ephem.bin")
+        self.ephem.writeFile(path)
+        fileEphem = coordConv.AppGeoEphemeris(path)
+        self.assertEqual(fileEphem.getPath(), path)
+        self.assertEqual(fileEphem.getStartDate(), self.ephem.getStartDate())
+        self.assertEqual(fileEphem.getInterval(), self.ephem.getInterval())
+        self.assertEqual(fileEphem.size(), self.ephem.size())
+        for date in numpy.linspace(self.ephem.getStartDate(), self.ephem.getEndDate(), 11):
+            data1 = self.ephem.getData(date)
+            data2 = fileEphem.getData(date)
+            self.assertTrue(numpy.array_equal(data1.bcPos, data2.bcPos))
+            self.assertTrue(numpy.array_equal(data1.pnMat, data2.pnMat))
+
+        badPath = os.path.join(self.tempDir, "bad.bin")
+        with open(badPath, "wb") as badFile:
+            badFile.write("not an ephemeris file; it only has text in it")
+        self.assertRaises(RuntimeError, coordConv.AppGeoEphemeris, badPath)
+        with open(path, "rb") as goodFile:
+            truncatedData = goodFile.read()[:-8]
+        with open(badPath, "wb") as badFile:
+            badFile.write(truncatedData)
+        self.assertRaises(RuntimeError, coordConv.AppGeoEphemeris, badPath)
+        self.assertRaises(RuntimeError, coordConv.AppGeoEphemeris, os.path.join(self.tempDir, "missing.bin"))
+
+    def testConvert(self):
+        """Test that conversions using an AppGeoCache with an ephemeris match conversions without
+        """
+        site = coordConv.makeTestSite()
+        cache = coordConv.AppGeoCache(self.ephem)
+        self.assertTrue(cache.getEphemeris() is not None)
+        icrsCoordSys = coordConv.ICRSCoordSys()
+        startTAI = icrsCoordSys.taiFromDate(self.startDate)
+        for name, ephemCoordSys, coordSys in (
+            ("appgeo", coordConv.AppGeoCoordSys(cache), coordConv.AppGeoCoordSys()),
+            ("apptopo", coordConv.AppTopoCoordSys(cache), coordConv.AppTopoCoordSys()),
+            ("obs", coordConv.ObsCoordSys(cache), coordConv.ObsCoordSys()),
+        ):
+            for i, tai in enumerate(numpy.linspace(startTAI, startTAI + 86400, 17)):
+                fromCoord = coordConv.Coord(i * 21.1, 30 + i, 0.01, 3, -5, 20)
+                predCoord = coordSys.convertFrom(icrsCoordSys, fromCoord, site, tai)
+                ephemCoord = ephemCoordSys.convertFrom(icrsCoordSys, fromCoord, site, tai)
+                self.assertLess(predCoord.angularSeparation(ephemCoord) * 3600, 1e-6, name)
+
+        # dates outside the ephemeris are computed as usual
+        appGeoCoordSys = coordConv.AppGeoCoordSys(cache)
+        appGeoCoordSys.setCurrDate(self.startDate - 1)
+        self.assertAlmostEqual(appGeoCoordSys.getCacheDate(), self.startDate - 1)
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,92 @@
+#!/usr/bin/env python
+from __future__ import absolute_import, division
+
+import os
+import shutil
+import tempfile
+import unittest
+
+import numpy
+
+import coordConv
+
+class TestCatalogConverter(unittest.TestCase):
+    def setUp(self):
+        self.tempDir = tempfile.mkdtemp()
+        self.site = coordConv.makeTestSite()
+        self.tai = coordConv.TestTAI
+
+    def tearDown(self):
+        shutil.rmtree(self.tempDir)
+
+    def makeCatalog(self, path):
+        """Write a catalog file and return the records as an N x 6 numpy array
+        """
+        recList = []
+        for equatAng in (0, 71, -123.4, 300):
+            for polarAng in (-89, -75, 0, 33.3, 90):
+                recList.append((equatAng, polarAng, 0, 0, 0, 0))
+                recList.append((equatAng, polarAng, 0.012, 3.1, -4.2, 15))
+        recArr = numpy.array(recList, dtype=float)
+        recArr.tofile(path)
+        return recArr
+
+    def testConvertFile(self):
+        """Test that CatalogConverter.convertFile matches CoordSys.convertFrom
+        """
+        fromPath = os.path.join(self.tempDir, "fromCat.bin")
+        toPath = os.path.join(self.tempDir, "toCat.bin")
+        fromRecArr = self.makeCatalog(fromPath)
+
+        coordSysList = coordConv.makeCoordSysList()
+        for fromCoordSys in coordSysList:
+            for toCoordSys in coordSysList:
+                for chunkSize in (1, 7, 1024):
+                    converter = coordConv.CatalogConverter(fromCoordSys, toCoordSys, self.site, self.tai, chunkSize)
+                    self.assertEqual(converter.getChunkSize(), chunkSize)
+                    numRecords = converter.convertFile(toPath, fromPath)
+                    self.assertEqual(numRecords, len(fromRecArr))
+                    toRecArr = numpy.fromfile(toPath, dtype=float).reshape(-1, 6)
+                    self.assertEqual(toRecArr.shape, fromRecArr.shape)
+                    for fromRec, toRec in zip(fromRecArr, toRecArr):
+                        fromCoord = coordConv.Coord(*fromRec)
+                        predToCoord = toCoordSys.convertFrom(fromCoordSys, fromCoord, self.site, self.tai)
+                        toCoord = coordConv.Coord(*toRec)
+                        self.assertLess(predToCoord.angularSeparation(toCoord), 1e-9)
+                        self.assertAlmostEqual(predToCoord.getParallax(), toRec[2])
+                        self.assertAlmostEqual(predToCoord.getRadVel(), toRec[5])
+                        if not predToCoord.atPole():
+                            atPole, equatPM, polarPM = predToCoord.getPM()
+                            self.assertAlmostEqual(equatPM, toRec[3])
+                            self.assertAlmostEqual(polarPM, toRec[4])
+
+    def testEdgeCases(self):
+        """Test empty and invalid catalogs and invalid chunkSize
+        """
+        icrsCoordSys = coordConv.ICRSCoordSys()
+        galCoordSys = coordConv.GalCoordSys()
+        converter = coordConv.CatalogConverter(icrsCoordSys, galCoordSys, self.site, self.tai)
+        toPath = os.path.join(self.tempDir, "toCat.bin")
+
+        emptyPath = os.path.join(self.tempDir, "empty.bin")
+        open(emptyPath, "wb").close()
+        self.assertEqual(converter.convertFile(toPath, emptyPath), 0)
+        self.assertEqual(os.path.getsize(toPath), 0)
+
+        truncatedPath = os.path.join(self.tempDir, "truncated.bin")
+        numpy.zeros(7, dtype=float).tofile(truncatedPath)
+        self.assertRaises(RuntimeError, converter.convertFile, toPath, truncatedPath)
+
+        badPolarPath = os.path.join(self.tempDir, "badPolar.bin")
+        numpy.array([(0, 91, 0, 0, 0, 0)], dtype=float).tofile(badPolarPath)
+        self.assertRaises(RuntimeError, converter.convertFile, toPath, badPolarPath)
+
+        self.assertRaises(RuntimeError, converter.convertFile, toPath, os.path.join(self.tempDir, "missing.bin"))
+
+        for chunkSize in (0, -1):
+            self.assertRaises(ValueError, coordConv.CatalogConverter, icrsCoordSys, galCoordSys, self.site, self.tai,
+                chunkSize)
+
+
+if __name__ == '__main__':
+    unittest.main()
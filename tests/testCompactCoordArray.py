@@ -0,0 +1,97 @@
+#!/usr/bin/env python
+from __future__ import absolute_import, division
+
+import unittest
+
+import numpy
+
+import coordConv
+
+class TestCompactCoordArray(unittest.TestCase):
+    def makeCoordArr(self):
+        return coordConv.makeCoordArr(numpy.arange(0, 360, 23.7), (-89.9, -75, 0, 33.3, 89, 90),
+            ((0, 0, 0, 0), (0.012, 3.1, -4.2, 15), (1.5, -250, 80, -60)))
+
+    def assertCoordsAlmostEqual(self, coord1, coord2):
+        """Assert that two coords are equal to within the precision of CompactCoordArray
+        """
+        self.assertLess(coord1.angularSeparation(coord2) * 3600, coordConv.CompactDirErr)
+        self.assertEqual(coord1.atInfinity(), coord2.atInfinity())
+        self.assertAlmostEqual(coord1.getParallax(), coord2.getParallax(), 6)
+        self.assertAlmostEqual(coord1.getRadVel(), coord2.getRadVel(), 4)
+        pmRate1 = coord1.getVecPM() / coord1.getDistance()
+        pmRate2 = coord2.getVecPM() / coord2.getDistance()
+        self.assertLessEqual(numpy.linalg.norm(pmRate1 - pmRate2), 1.2e-7 * numpy.linalg.norm(pmRate1))
+
+    def testBasics(self):
+        """Test constructors, getCoord, setCoord and error bounds
+        """
+        compactArr = coordConv.CompactCoordArray(5)
+        self.assertEqual(compactArr.size(), 5)
+        self.assertFalse(compactArr.getCoord(0).isfinite())
+
+        coordArr = self.makeCoordArr()
+        compactArr = coordConv.CompactCoordArray(coordArr)
+        self.assertEqual(compactArr.size(), coordArr.size())
+        expandedArr = coordConv.CoordArray()
+        compactArr.getCoordArray(expandedArr)
+        self.assertEqual(expandedArr.size(), coordArr.size())
+        for i in range(coordArr.size()):
+            coord = coordArr.getCoord(i)
+            self.assertCoordsAlmostEqual(coord, compactArr.getCoord(i))
+            self.assertCoordsAlmostEqual(coord, expandedArr.getCoord(i))
+            self.assertEqual(coord.hasPM(), expandedArr.getCoord(i).hasPM())
+
+        compactArr.setCoord(3, coordArr.getCoord(7))
+        self.assertCoordsAlmostEqual(compactArr.getCoord(3), coordArr.getCoord(7))
+
+        compactArr.getCoordArray(expandedArr, 4, 6)
+        self.assertEqual(expandedArr.size(), 6)
+        for i in range(6):
+            self.assertCoordsAlmostEqual(coordArr.getCoord(4 + i), expandedArr.getCoord(i))
+
+        compactArr.resize(3)
+        self.assertEqual(compactArr.size(), 3)
+        self.assertFalse(compactArr.getCoord(2).isfinite())
+
+    def testErrors(self):
+        """Test invalid indices and ranges
+        """
+        coordArr = self.makeCoordArr()
+        compactArr = coordConv.CompactCoordArray(coordArr)
+        numPos = compactArr.size()
+        expandedArr = coordConv.CoordArray()
+        self.assertRaises(IndexError, compactArr.getCoord, numPos)
+        self.assertRaises(IndexError, compactArr.getCoord, -1)
+        self.assertRaises(IndexError, compactArr.setCoord, numPos, coordConv.Coord(0, 0))
+        self.assertRaises(IndexError, compactArr.getCoordArray, expandedArr, numPos - 2, 3)
+        self.assertRaises(IndexError, compactArr.getCoordArray, expandedArr, -1, 3)
+        self.assertRaises(IndexError, compactArr.setCoordArray, 1, coordArr)
+
+    def testConvert(self):
+        """Test that ConversionPlan.convert of a CompactCoordArray matches converting the CoordArray
+        """
+        site = coordConv.makeTestSite()
+        tai = coordConv.TestTAI
+        coordSysList = coordConv.makeCoordSysList()
+
+        fromCompactArr = coordConv.CompactCoordArray(self.makeCoordArr())
+        fromCoordArr = coordConv.CoordArray()
+        fromCompactArr.getCoordArray(fromCoordArr)
+        for fromCoordSys in coordSysList:
+            for toCoordSys in coordSysList:
+                plan = coordConv.ConversionPlan(fromCoordSys, toCoordSys, site, tai)
+                predToCoordArr = coordConv.CoordArray()
+                plan.convert(predToCoordArr, fromCoordArr)
+                for chunkSize in (1, 17, 1024):
+                    toCompactArr = coordConv.CompactCoordArray()
+                    plan.convert(toCompactArr, fromCompactArr, chunkSize)
+                    self.assertEqual(toCompactArr.size(), fromCompactArr.size())
+                    for i in range(toCompactArr.size()):
+                        self.assertLess(predToCoordArr.getCoord(i).angularSeparation(toCompactArr.getCoord(i)) * 3600,
+                            coordConv.CompactDirErr)
+                self.assertRaises(ValueError, plan.convert, toCompactArr, fromCompactArr, 0)
+
+
+if __name__ == '__main__':
+    unittest.main()
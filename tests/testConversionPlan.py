@@ -0,0 +1,89 @@
+#!/usr/bin/env python
+from __future__ import absolute_import, division
+
+import unittest
+
+import numpy
+
+import coordConv
+
+class TestConversionPlan(unittest.TestCase):
+    def setUp(self):
+        self.site = coordConv.makeTestSite()
+        self.tai = coordConv.TestTAI
+
+    def makeCoordArr(self, pmArgsList=((0, 0, 0, 0), (0.012, 3.1, -4.2, 15))):
+        return coordConv.makeCoordArr((0, 71, -123.4), (-75, 0, 33.3, 89), pmArgsList)
+
+    def testConvert(self):
+        """Test that ConversionPlan.convert matches CoordSys.convertFrom
+        """
+        rotationNameSet = set(("icrs", "fk5", "gal"))
+        fromCoordArr = self.makeCoordArr()
+
+        for fromCoordSys in coordConv.makeCoordSysList(includeOtherDates=True):
+            for toCoordSys in coordConv.makeCoordSysList(includeOtherDates=True):
+                plan = coordConv.ConversionPlan(fromCoordSys, toCoordSys, self.site, self.tai)
+                self.assertEqual(plan.getTAI(), self.tai)
+                self.assertEqual(plan.isRotation(),
+                    fromCoordSys.getName() in rotationNameSet and toCoordSys.getName() in rotationNameSet)
+                toCoordArr = coordConv.CoordArray()
+                plan.convert(toCoordArr, fromCoordArr)
+                for i in range(fromCoordArr.size()):
+                    fromCoord = fromCoordArr.getCoord(i)
+                    predToCoord = toCoordSys.convertFrom(fromCoordSys, fromCoord, self.site, self.tai)
+                    for toCoord in (plan.convert(fromCoord), toCoordArr.getCoord(i)):
+                        self.assertLess(predToCoord.angularSeparation(toCoord), 1e-9)
+                        self.assertTrue(numpy.allclose(predToCoord.getVecPM(), toCoord.getVecPM()))
+                        self.assertAlmostEqual(predToCoord.getParallax(), toCoord.getParallax())
+
+    def testFixedTargets(self):
+        """Test that converting fixed targets (which skips the velocity terms) matches converting targets
+        with negligible proper motion
+        """
+        fixedCoordArr = self.makeCoordArr(pmArgsList=((0, 0, 0, 0),))
+        tinyPM = numpy.array([0, 0, 1e-300])
+        fixedCoordList = [fixedCoordArr.getCoord(i) for i in range(fixedCoordArr.size())]
+        movingCoordList = [coordConv.Coord(coord.getVecPos(), tinyPM) for coord in fixedCoordList]
+        movingCoordArr = coordConv.CoordArray(len(movingCoordList))
+        for i, coord in enumerate(movingCoordList):
+            movingCoordArr.setCoord(i, coord)
+        self.assertFalse(fixedCoordArr.hasPM())
+        self.assertTrue(movingCoordArr.hasPM())
+
+        for fromCoordSys in coordConv.makeCoordSysList(includeOtherDates=True):
+            if fromCoordSys.getName() == "fk4":
+                # FK4 deliberately handles zero proper motion differently (fictitious proper motion)
+                continue
+            for toCoordSys in coordConv.makeCoordSysList(includeOtherDates=True):
+                plan = coordConv.ConversionPlan(fromCoordSys, toCoordSys, self.site, self.tai)
+                fixedToCoordArr = coordConv.CoordArray()
+                plan.convert(fixedToCoordArr, fixedCoordArr)
+                movingToCoordArr = coordConv.CoordArray()
+                plan.convert(movingToCoordArr, movingCoordArr)
+                for i in range(len(fixedCoordList)):
+                    for fixedToCoord, movingToCoord in (
+                        (plan.convert(fixedCoordList[i]), plan.convert(movingCoordList[i])),
+                        (fixedToCoordArr.getCoord(i), movingToCoordArr.getCoord(i)),
+                    ):
+                        self.assertLess(fixedToCoord.angularSeparation(movingToCoord), 1e-12)
+                        self.assertTrue(numpy.allclose(fixedToCoord.getVecPM(), movingToCoord.getVecPM()))
+
+    def testCopies(self):
+        """Test that a ConversionPlan uses its own copies of the coordinate systems
+        """
+        fromCoordSys = coordConv.ICRSCoordSys()
+        toCoordSys = coordConv.AppTopoCoordSys()
+        plan = coordConv.ConversionPlan(fromCoordSys, toCoordSys, self.site, self.tai)
+        self.assertTrue(plan.getFromCoordSys().isCurrent())
+        self.assertAlmostEqual(plan.getToCoordSys().getDate(False), self.tai)
+        fromCoord = coordConv.Coord(10, 30)
+        predToCoord = toCoordSys.convertFrom(fromCoordSys, fromCoord, self.site, self.tai)
+
+        # converting at another date must not affect the plan
+        toCoordSys.convertFrom(fromCoordSys, fromCoord, self.site, self.tai + 1000)
+        self.assertLess(predToCoord.angularSeparation(plan.convert(fromCoord)), 1e-9)
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,96 @@
+#!/usr/bin/env python
+from __future__ import absolute_import, division
+
+import unittest
+
+import coordConv
+
+class TestConversionShortcut(unittest.TestCase):
+    """Test direct conversions that bypass FK5 J2000
+    """
+    def setUp(self):
+        self.site = coordConv.makeTestSite()
+        self.tai = coordConv.TestTAI
+
+    def testBuiltInShortcuts(self):
+        """Test that built-in shortcuts are registered, and match converting via FK5 J2000
+        """
+        appNameList = ("appgeo", "apptopo", "obs")
+        for fromName in appNameList:
+            for toName in appNameList:
+                fromCoordSys = coordConv.makeCoordSys(fromName, 0)
+                toCoordSys = coordConv.makeCoordSys(toName, 0)
+                self.assertEqual(coordConv.hasConversionShortcut(fromCoordSys, toCoordSys), fromName != toName)
+                if fromName == toName:
+                    continue
+
+                fromCoord = coordConv.Coord(125, 45)
+                toCoord = toCoordSys.convertFrom(fromCoordSys, fromCoord, self.site, self.tai)
+                self.assertTrue(coordConv.findConversionShortcut(fromCoordSys, toCoordSys) is not None)
+                fk5J2000Coord = fromCoordSys.toFK5J2000(fromCoord, self.site)
+                predToCoord = toCoordSys.fromFK5J2000(fk5J2000Coord, self.site)
+                self.assertLess(toCoord.angularSeparation(predToCoord) * 3600, 1e-6)
+
+                plan = coordConv.ConversionPlan(fromCoordSys, toCoordSys, self.site, self.tai)
+                self.assertLess(plan.convert(fromCoord).angularSeparation(toCoord) * 3600, 1e-9)
+
+        for name, date in (("icrs", 2010), ("fk5", 1950), ("gal", 2010)):
+            fromCoordSys = coordConv.makeCoordSys(name, 2000)
+            toCoordSys = coordConv.makeCoordSys(name, date)
+            self.assertTrue(coordConv.hasConversionShortcut(fromCoordSys, toCoordSys))
+            fromCoord = coordConv.Coord(35, 45, 0.05, 3.5, -2.1, 15)
+            toCoord = toCoordSys.convertFrom(fromCoordSys, fromCoord, self.site, self.tai)
+            predToCoord = toCoordSys.fromFK5J2000(fromCoordSys.toFK5J2000(fromCoord, self.site), self.site)
+            self.assertLess(toCoord.angularSeparation(predToCoord) * 3600, 1e-6)
+
+        self.assertFalse(coordConv.hasConversionShortcut(coordConv.ICRSCoordSys(), coordConv.FK5CoordSys()))
+        self.assertFalse(coordConv.hasConversionShortcut(coordConv.FK4CoordSys(), coordConv.FK4CoordSys(1900)))
+
+    def testDates(self):
+        """Test that apparent shortcuts are only used if the coordinate systems have the same date
+        """
+        obsCoordSys = coordConv.ObsCoordSys(self.tai)
+        self.assertTrue(coordConv.findConversionShortcut(obsCoordSys, coordConv.AppTopoCoordSys(self.tai)))
+        self.assertFalse(coordConv.findConversionShortcut(obsCoordSys, coordConv.AppTopoCoordSys(self.tai + 100)))
+        appGeoDate = coordConv.AppGeoCoordSys().dateFromTAI(self.tai)
+        self.assertTrue(coordConv.findConversionShortcut(obsCoordSys, coordConv.AppGeoCoordSys(appGeoDate)))
+        self.assertFalse(coordConv.findConversionShortcut(obsCoordSys, coordConv.AppGeoCoordSys(appGeoDate + 0.1)))
+
+        # conversions between apparent systems at different dates go via FK5 J2000, so the sky rotates
+        appTopoCoordSys = coordConv.AppTopoCoordSys(self.tai + 3600)
+        fromCoord = coordConv.Coord(125, 45)
+        toCoord = appTopoCoordSys.convertFrom(obsCoordSys, fromCoord, self.site, self.tai)
+        self.assertGreater(toCoord.angularSeparation(fromCoord), 1)
+
+    def testVelocityAndOrientation(self):
+        """Test analytic velocity and orientation using shortcuts against the two-point and offset methods
+        """
+        appNameList = ("appgeo", "apptopo", "obs")
+        fromPVTCoord = coordConv.PVTCoord(coordConv.PVT(125, 0.01, self.tai), coordConv.PVT(45, -0.003, self.tai),
+            coordConv.PVT())
+        for fromName in appNameList:
+            for toName in appNameList:
+                fromCoordSys = coordConv.makeCoordSys(fromName, 0)
+                toCoordSys = coordConv.makeCoordSys(toName, 0)
+                analyticPVTCoord = toCoordSys.convertFrom(fromCoordSys, fromPVTCoord, self.site,
+                    coordConv.VelocityMethod_Analytic)
+                twoPointPVTCoord = toCoordSys.convertFrom(fromCoordSys, fromPVTCoord, self.site,
+                    coordConv.VelocityMethod_TwoPoint)
+                analyticPVTPair = [coordConv.PVT(), coordConv.PVT()]
+                analyticPVTCoord.getSphPVT(analyticPVTPair[0], analyticPVTPair[1])
+                twoPointPVTPair = [coordConv.PVT(), coordConv.PVT()]
+                twoPointPVTCoord.getSphPVT(twoPointPVTPair[0], twoPointPVTPair[1])
+                for analyticPVT, twoPointPVT in zip(analyticPVTPair, twoPointPVTPair):
+                    self.assertAlmostEqual(analyticPVT.vel, twoPointPVT.vel, 5)
+
+                fromCoord = fromPVTCoord.getCoord()
+                analyticCoord, analyticDir, analyticScale = toCoordSys.convertFrom(fromCoordSys, fromCoord, 30,
+                    self.site, self.tai, coordConv.OrientationMethod_Analytic)
+                offsetCoord, offsetDir, offsetScale = toCoordSys.convertFrom(fromCoordSys, fromCoord, 30,
+                    self.site, self.tai, coordConv.OrientationMethod_Offset)
+                self.assertAlmostEqual(analyticDir, offsetDir, 3)
+                self.assertAlmostEqual(analyticScale, offsetScale, 5)
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,136 @@
+#!/usr/bin/env python
+from __future__ import absolute_import, division
+
+import unittest
+
+import coordConv
+
+class TestConvertStatus(unittest.TestCase):
+    """Test the non-throwing (try) conversion methods and the status codes they return
+    """
+    def setUp(self):
+        self.site = coordConv.makeTestSite()
+        self.tai = coordConv.TestTAI
+
+    def testMessages(self):
+        """Test convertStatusMessage and throwIfFailed
+        """
+        coordConv.throwIfFailed(coordConv.ConvertStatus_OK)
+        self.assertEqual(coordConv.convertStatusMessage(coordConv.ConvertStatus_OK), "OK")
+        for status in (
+            coordConv.ConvertStatus_NotCurrent,
+            coordConv.ConvertStatus_BadDate,
+            coordConv.ConvertStatus_DateTooLarge,
+            coordConv.ConvertStatus_CacheNotValid,
+            coordConv.ConvertStatus_AtPole,
+        ):
+            self.assertTrue(len(coordConv.convertStatusMessage(status)) > 0)
+            self.assertRaises(RuntimeError, coordConv.throwIfFailed, status)
+        self.assertRaises(ValueError, coordConv.throwIfFailed, coordConv.ConvertStatus_UnknownMethod)
+
+    def testTrySetCurrDate(self):
+        """Test trySetCurrDate
+        """
+        fk5CoordSys = coordConv.FK5CoordSys(2000)
+        self.assertEqual(fk5CoordSys.trySetCurrDate(2010), coordConv.ConvertStatus_NotCurrent)
+        for name in ("appgeo", "apptopo", "obs"):
+            coordSys = coordConv.makeCoordSys(name, 0)
+            for badDate in (-1, float("nan"), float("inf")):
+                self.assertEqual(coordSys.trySetCurrDate(badDate), coordConv.ConvertStatus_BadDate)
+            date = coordSys.dateFromTAI(self.tai)
+            self.assertEqual(coordSys.trySetCurrDate(date), coordConv.ConvertStatus_OK)
+            self.assertEqual(coordSys.getDate(False), date)
+            # a common mistake: using TAI for apparent geocentric date
+            badDate = self.tai if name == "appgeo" else self.tai * 1e5
+            self.assertEqual(coordSys.trySetCurrDate(badDate), coordConv.ConvertStatus_DateTooLarge)
+            self.assertEqual(coordSys.getDate(False), date)
+            self.assertRaises(RuntimeError, coordSys.setCurrDate, badDate)
+
+    def testTryConvertFrom(self):
+        """Test that tryConvertFrom matches convertFrom
+        """
+        fromCoord = coordConv.Coord(35, 45, 0.05, 3.5, -2.1, 15)
+        fromPVTCoord = coordConv.PVTCoord(coordConv.PVT(35, 0.01, self.tai), coordConv.PVT(45, -0.003, self.tai),
+            coordConv.PVT(coordConv.distanceFromParallax(0.05), 0, self.tai), 3.5, -2.1, 15)
+        fromDirPVT = coordConv.PVT(30, 0.02, self.tai)
+        for fromCoordSys in coordConv.makeCoordSysList():
+            for toCoordSys in coordConv.makeCoordSysList():
+                predToCoord = toCoordSys.convertFrom(fromCoordSys, fromCoord, self.site, self.tai)
+                toCoord = coordConv.Coord()
+                status = toCoordSys.tryConvertFrom(toCoord, fromCoordSys, fromCoord, self.site, self.tai)
+                self.assertEqual(status, coordConv.ConvertStatus_OK)
+                self.assertTrue(toCoord == predToCoord)
+
+                for orientMethod in (coordConv.OrientationMethod_Analytic, coordConv.OrientationMethod_Offset):
+                    predToCoord, predToDir, predScaleChange = toCoordSys.convertFrom(
+                        fromCoordSys, fromCoord, 30, self.site, self.tai, orientMethod)
+                    status, toDir, scaleChange = toCoordSys.tryConvertFrom(
+                        toCoord, fromCoordSys, fromCoord, 30, self.site, self.tai, orientMethod)
+                    self.assertEqual(status, coordConv.ConvertStatus_OK)
+                    self.assertTrue(toCoord == predToCoord)
+                    self.assertEqual(toDir, predToDir)
+                    self.assertEqual(scaleChange, predScaleChange)
+
+                for velMethod in (coordConv.VelocityMethod_Analytic, coordConv.VelocityMethod_TwoPoint):
+                    predToPVTCoord = toCoordSys.convertFrom(fromCoordSys, fromPVTCoord, self.site, velMethod)
+                    toPVTCoord = coordConv.PVTCoord()
+                    status = toCoordSys.tryConvertFrom(toPVTCoord, fromCoordSys, fromPVTCoord, self.site, velMethod)
+                    self.assertEqual(status, coordConv.ConvertStatus_OK)
+                    self.assertTrue(toPVTCoord.getCoord() == predToPVTCoord.getCoord())
+
+                predToDir = coordConv.PVT()
+                predToPVTCoord, predScaleChange = toCoordSys.convertFrom(predToDir,
+                    fromCoordSys, fromPVTCoord, fromDirPVT, self.site)
+                toDir = coordConv.PVT()
+                status, scaleChange = toCoordSys.tryConvertFrom(toPVTCoord, toDir,
+                    fromCoordSys, fromPVTCoord, fromDirPVT, self.site)
+                self.assertEqual(status, coordConv.ConvertStatus_OK)
+                self.assertTrue(toPVTCoord.getCoord() == predToPVTCoord.getCoord())
+                self.assertEqual(toDir.pos, predToDir.pos)
+                self.assertEqual(scaleChange, predScaleChange)
+
+    def testFailures(self):
+        """Test that tryConvertFrom and tryOffset report failures and convertFrom and offset raise
+        """
+        icrsCoordSys = coordConv.ICRSCoordSys()
+        appGeoCoordSys = coordConv.AppGeoCoordSys()
+        poleCoord = coordConv.Coord(0, 90)
+        toCoord = coordConv.Coord()
+
+        status, toDir, scaleChange = appGeoCoordSys.tryConvertFrom(toCoord, icrsCoordSys, poleCoord, 30,
+            self.site, self.tai)
+        self.assertEqual(status, coordConv.ConvertStatus_AtPole)
+        self.assertFalse(toCoord.isfinite())
+        self.assertRaises(RuntimeError, appGeoCoordSys.convertFrom, icrsCoordSys, poleCoord, 30,
+            self.site, self.tai)
+
+        status = appGeoCoordSys.tryConvertFrom(toCoord, icrsCoordSys, coordConv.Coord(10, 20), self.site, 1e15)
+        self.assertEqual(status, coordConv.ConvertStatus_DateTooLarge)
+        self.assertRaises(RuntimeError, appGeoCoordSys.convertFrom, icrsCoordSys, coordConv.Coord(10, 20),
+            self.site, 1e15)
+
+        badAppGeoCoordSys = coordConv.AppGeoCoordSys(float("nan"))
+        status = icrsCoordSys.tryConvertFrom(toCoord, badAppGeoCoordSys, coordConv.Coord(10, 20), self.site, self.tai)
+        self.assertEqual(status, coordConv.ConvertStatus_CacheNotValid)
+
+        fromPVTCoord = coordConv.PVTCoord(coordConv.PVT(10, 0, self.tai), coordConv.PVT(20, 0, self.tai),
+            coordConv.PVT())
+        toPVTCoord = coordConv.PVTCoord()
+        status = appGeoCoordSys.tryConvertFrom(toPVTCoord, icrsCoordSys, fromPVTCoord, self.site, 5)
+        self.assertEqual(status, coordConv.ConvertStatus_UnknownMethod)
+        self.assertRaises(ValueError, appGeoCoordSys.convertFrom, icrsCoordSys, fromPVTCoord, self.site, 5)
+
+        status, toOrient = poleCoord.tryOffset(toCoord, 30, 1)
+        self.assertEqual(status, coordConv.ConvertStatus_AtPole)
+        self.assertRaises(RuntimeError, poleCoord.offset, 30, 1)
+
+        coord = coordConv.Coord(10, 20)
+        predOffCoord, predToOrient = coord.offset(30, 1)
+        status, toOrient = coord.tryOffset(toCoord, 30, 1)
+        self.assertEqual(status, coordConv.ConvertStatus_OK)
+        self.assertTrue(toCoord == predOffCoord)
+        self.assertEqual(toOrient, predToOrient)
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -115,6 +115,19 @@ class TestCoord(unittest.TestCase):
                 predAtPole = fracXYMag**2 < DoubleEpsilon
                 self.assertEqual(predAtPole, coord.atPole())
     
+    def testHasPM(self):
+        """Test hasPM
+        """
+        self.assertFalse(Coord(43, 23).hasPM())
+        self.assertFalse(Coord(43, 23, 0.5, 0, 0, 0).hasPM())
+        self.assertFalse(Coord(Coord(43, 23).getVecPos()).hasPM())
+        self.assertFalse(Coord(Coord(43, 23).getVecPos(), numpy.zeros(3)).hasPM())
+        self.assertTrue(Coord().hasPM())
+        for pmArgs in ((3, 0, 0), (0, -5, 0), (0, 0, 2)):
+            coord = Coord(43, 23, 0.5, *pmArgs)
+            self.assertTrue(coord.hasPM())
+            self.assertTrue(Coord(coord.getVecPos(), coord.getVecPM()).hasPM())
+
     def testDist(self):
         """Test distance
         """
@@ -0,0 +1,87 @@
+#!/usr/bin/env python
+from __future__ import absolute_import, division
+
+import unittest
+
+import numpy
+
+import coordConv
+
+class TestCoordArray(unittest.TestCase):
+    def setUp(self):
+        self.site = coordConv.makeTestSite()
+        self.tai = coordConv.TestTAI
+
+    def makeCoordList(self):
+        coordArr = coordConv.makeCoordArr((0, 71, -123.4), (-75, 0, 33.3, 89))
+        return [coordArr.getCoord(i) for i in range(coordArr.size())]
+
+    def testConstructors(self):
+        """Test CoordArray constructors, getCoord and setCoord
+        """
+        coordArr = coordConv.CoordArray(5)
+        self.assertEqual(coordArr.size(), 5)
+
+        coordList = self.makeCoordList()
+        coordArr.resize(len(coordList))
+        self.assertEqual(coordArr.size(), len(coordList))
+        for i, coord in enumerate(coordList):
+            coordArr.setCoord(i, coord)
+        for i, coord in enumerate(coordList):
+            self.assertTrue(numpy.allclose(coordArr.getCoord(i).getVecPos(), coord.getVecPos()))
+            self.assertTrue(numpy.allclose(coordArr.getCoord(i).getVecPM(), coord.getVecPM()))
+        self.assertRaises(Exception, coordArr.getCoord, -1)
+        self.assertRaises(Exception, coordArr.getCoord, len(coordList))
+
+        posArr = numpy.array([coord.getVecPos() for coord in coordList])
+        pmArr = numpy.array([coord.getVecPM() for coord in coordList])
+        coordArr2 = coordConv.CoordArray(posArr, pmArr)
+        coordArr3 = coordConv.CoordArray(posArr)
+        for i, coord in enumerate(coordList):
+            self.assertTrue(numpy.allclose(coordArr2.getCoord(i).getVecPos(), coord.getVecPos()))
+            self.assertTrue(numpy.allclose(coordArr2.getCoord(i).getVecPM(), coord.getVecPM()))
+            self.assertTrue(numpy.allclose(coordArr3.getCoord(i).getVecPos(), coord.getVecPos()))
+            self.assertTrue(numpy.allclose(coordArr3.getCoord(i).getVecPM(), (0, 0, 0)))
+        self.assertRaises(Exception, coordConv.CoordArray, posArr, pmArr[1:])
+
+    def testConvertFrom(self):
+        """Test that converting a CoordArray matches converting one Coord at a time
+        """
+        fromCoordArr = coordConv.makeCoordArr((0, 71, -123.4), (-75, 0, 33.3, 89))
+
+        for fromCoordSys in coordConv.makeCoordSysList():
+            for toCoordSys in coordConv.makeCoordSysList():
+                toCoordArr = coordConv.CoordArray()
+                toCoordSys.convertFrom(toCoordArr, fromCoordSys, fromCoordArr, self.site, self.tai)
+                self.assertEqual(toCoordArr.size(), fromCoordArr.size())
+                for i in range(fromCoordArr.size()):
+                    predToCoord = toCoordSys.convertFrom(fromCoordSys, fromCoordArr.getCoord(i), self.site, self.tai)
+                    toCoord = toCoordArr.getCoord(i)
+                    self.assertLess(predToCoord.angularSeparation(toCoord), 1e-9)
+                    self.assertTrue(numpy.allclose(predToCoord.getVecPM(), toCoord.getVecPM()))
+                    self.assertAlmostEqual(predToCoord.getParallax(), toCoord.getParallax())
+
+    def testAppGeoArraySizes(self):
+        """Test AppGeoCoordSys array conversions for sizes that are not a multiple of the group size
+        """
+        appGeoSys = coordConv.AppGeoCoordSys(2012.3)
+        coordList = self.makeCoordList()
+        for size in (0, 1, 7, 8, 9, 17):
+            fk5Arr = coordConv.CoordArray(size)
+            for i in range(size):
+                fk5Arr.setCoord(i, coordList[i])
+            appGeoArr = coordConv.CoordArray()
+            appGeoSys.fromFK5J2000(appGeoArr, fk5Arr, self.site)
+            roundTripArr = coordConv.CoordArray()
+            appGeoSys.toFK5J2000(roundTripArr, appGeoArr, self.site)
+            self.assertEqual(appGeoArr.size(), size)
+            self.assertEqual(roundTripArr.size(), size)
+            for i in range(size):
+                predAppGeoCoord = appGeoSys.fromFK5J2000(coordList[i], self.site)
+                self.assertLess(predAppGeoCoord.angularSeparation(appGeoArr.getCoord(i)), 1e-9)
+                predFK5Coord = appGeoSys.toFK5J2000(predAppGeoCoord, self.site)
+                self.assertLess(predFK5Coord.angularSeparation(roundTripArr.getCoord(i)), 1e-9)
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -200,6 +200,162 @@ class TestCoordSys(unittest.TestCase):
                 raise
             prevDate = date
 
+    def testAppGeoCacheSharing(self):
+        """Test that clones of apparent coordinate systems share one AppGeoCache
+        """
+        defAGSys = coordConv.AppGeoCoordSys()
+        cache = coordConv.AppGeoCache(defAGSys.getMaxAge(), defAGSys.getMaxDDate())
+        self.assertFalse(cache.get())
+        agSys = coordConv.AppGeoCoordSys(cache)
+        self.assertFalse(agSys.cacheOK())
+
+        date = 2020.12345
+        agSys.setCurrDate(date)
+        self.assertTrue(cache.get())
+        self.assertAlmostEqual(cache.get().date, date)
+
+        # another coordinate system using the cache at a nearby date reuses the snapshot instead of computing a new one
+        agSys2 = coordConv.AppGeoCoordSys(agSys.getCache(), date + (cache.getMaxAge() * 0.5))
+        self.assertAlmostEqual(agSys2.getCacheDate(), date)
+        self.assertEqual(agSys2.getMaxAge(), agSys.getMaxAge())
+
+        site = coordConv.makeTestSite()
+        tai = coordConv.TestTAI
+        fk5Sys = coordConv.FK5CoordSys(2000)
+        fk5Coord = coordConv.Coord(45, 30)
+        for csys in (coordConv.AppTopoCoordSys(cache), coordConv.ObsCoordSys(cache)):
+            refSys = coordConv.makeCoordSys(csys.getName(), 0)
+            csysClone = csys.clone()
+            csysClone.setCurrDate(csys.dateFromTAI(tai))
+            csysCopy = type(csys)(csys)
+            self.assertEqual(csysCopy.getAppGeoCache().getMaxAge(), cache.getMaxAge())
+            predCoord = refSys.convertFrom(fk5Sys, fk5Coord, site, tai)
+            for sysToTest in (csys, csysClone, csysCopy):
+                coord = sysToTest.convertFrom(fk5Sys, fk5Coord, site, tai)
+                self.assertLess(coord.angularSeparation(predCoord), 1e-9)
+
+        self.assertRaises(Exception, cache.set, None)
+
+    def testAppGeoCacheInterpolate(self):
+        """Test an AppGeoCache in interpolate mode
+        """
+        interval = 60 / (coordConv.SecPerDay * coordConv.DaysPerYear)
+        cache = coordConv.AppGeoCache(interval, 0, coordConv.AppGeoCacheMode_Interpolate)
+        self.assertEqual(cache.getMode(), coordConv.AppGeoCacheMode_Interpolate)
+        self.assertEqual(coordConv.AppGeoCache().getMode(), coordConv.AppGeoCacheMode_Hold)
+        self.assertRaises(ValueError, coordConv.AppGeoCache, 0, 0, coordConv.AppGeoCacheMode_Interpolate)
+        agSys = coordConv.AppGeoCoordSys(cache)
+        refSys = coordConv.AppGeoCoordSys(0, 1e-12, 0) # always computes fresh data
+        icrsSys = coordConv.ICRSCoordSys()
+        site = coordConv.makeTestSite()
+        fromCoord = coordConv.Coord(45, 30)
+
+        startTAI = coordConv.TestTAI
+        for tai in numpy.linspace(startTAI, startTAI + 600, 37):
+            coord = agSys.convertFrom(icrsSys, fromCoord, site, tai)
+            predCoord = refSys.convertFrom(icrsSys, fromCoord, site, tai)
+            self.assertLess(coord.angularSeparation(predCoord) * 3600, 1e-6)
+
+            # the snapshot in use is at the grid point at or before the date
+            date = agSys.getDate(False)
+            cacheDate = agSys.getCacheDate()
+            self.assertAlmostEqual(cacheDate / interval, round(cacheDate / interval))
+            self.assertLessEqual(cacheDate, date)
+            self.assertLess(date - cacheDate, interval)
+
+        # position changes continuously with date, so PVTCoord velocity matches a two-point velocity,
+        # in both directions
+        zeroVel = numpy.zeros(3)
+        dTAI = 1.0
+        for tai in (startTAI, startTAI + 95.3):
+            for fromSys, toSys in ((icrsSys, agSys), (agSys, icrsSys)):
+                toPVTCoord = toSys.convertFrom(fromSys, coordConv.PVTCoord(fromCoord, zeroVel, tai), site)
+                toCoord0 = toSys.convertFrom(fromSys, fromCoord, site, tai - dTAI)
+                toCoord1 = toSys.convertFrom(fromSys, fromCoord, site, tai + dTAI)
+                predVel = (toCoord1.getVecPos() - toCoord0.getVecPos()) / (2 * dTAI)
+                velErr = numpy.linalg.norm(toPVTCoord.getVel() - predVel)
+                self.assertGreater(numpy.linalg.norm(predVel), 0)
+                self.assertLess(velErr, 1e-3 * numpy.linalg.norm(predVel))
+
+        # interpolated data matches the snapshots at the grid points
+        data0 = coordConv.AppGeoData(2020.1)
+        data1 = coordConv.AppGeoData(2020.1 + interval)
+        for data in (data0, data1):
+            interpData = coordConv.AppGeoData(data0, data1, data.date)
+            self.assertTrue(numpy.allclose(interpData.bcPos, data.bcPos, rtol=0, atol=1e-15))
+            self.assertTrue(numpy.allclose(interpData.pnMat, data.pnMat, rtol=0, atol=1e-15))
+
+    def testConvertFromMultiRefCo(self):
+        """Test ObsCoordSys.convertFromMultiRefCo against convertFrom with each set of refraction coefficients
+        """
+        site = coordConv.makeTestSite()
+        tai = coordConv.TestTAI
+        wavelenList = (3500, 5000, 7000, 10000)
+        refCoArr = numpy.array([coordConv.refCoFromWeather(site, 730, 10, 0.3, wavelen) for wavelen in wavelenList])
+        obsSys = coordConv.ObsCoordSys()
+        for fromSysName in ("icrs", "gal", "appgeo", "apptopo", "obs"):
+            fromSys = coordConv.makeCoordSys(fromSysName, 0 if fromSysName != "gal" else 2000)
+            for fromCoord in (coordConv.Coord(120, 30), coordConv.Coord(250, -10), coordConv.Coord(0, 85)):
+                obsArr = coordConv.CoordArray()
+                dispersion = obsSys.convertFromMultiRefCo(obsArr, fromSys, fromCoord, refCoArr, site, tai, 1)
+                self.assertEqual(obsArr.size(), len(wavelenList))
+                self.assertEqual(len(dispersion), len(wavelenList))
+                self.assertEqual(dispersion[1], 0)
+                appTopoCoord = coordConv.AppTopoCoordSys().convertFrom(fromSys, fromCoord, site, tai)
+                refAlt = obsArr.getCoord(1).getSphPos()[2]
+                for i, (refCoA, refCoB) in enumerate(refCoArr):
+                    refCoSite = coordConv.Site(site)
+                    refCoSite.refCoA = refCoA
+                    refCoSite.refCoB = refCoB
+                    predCoord = obsSys.convertFrom(coordConv.AppTopoCoordSys(), appTopoCoord, refCoSite, tai)
+                    obsCoord = obsArr.getCoord(i)
+                    self.assertLess(obsCoord.angularSeparation(predCoord) * 3600, 1e-6)
+                    self.assertAlmostEqual(dispersion[i], obsCoord.getSphPos()[2] - refAlt)
+                # shorter wavelengths are refracted more, so appear higher
+                if appTopoCoord.getSphPos()[2] > 5:
+                    self.assertGreater(dispersion[0], dispersion[1])
+                    self.assertLess(dispersion[3], dispersion[2])
+
+        obsArr = coordConv.CoordArray()
+        icrsSys = coordConv.ICRSCoordSys()
+        fromCoord = coordConv.Coord(120, 30)
+        self.assertRaises(ValueError, obsSys.convertFromMultiRefCo, obsArr, icrsSys, fromCoord, refCoArr, site, tai, 4)
+        self.assertRaises(ValueError, obsSys.convertFromMultiRefCo, obsArr, icrsSys, fromCoord, refCoArr[:, 0:1],
+            site, tai)
+
+    def testSnapshot(self):
+        """Test snapshot
+        """
+        site = coordConv.makeTestSite()
+        tai = coordConv.TestTAI
+        fromCoord = coordConv.Coord(45, 30)
+        for csysName in FullNameList:
+            for date in (0, 1000.5):
+                if date == 0 and csysName in ("fk4", "fk5"):
+                    continue
+                csys = coordConv.makeCoordSys(csysName, date)
+                snapshot = csys.snapshot(tai)
+                self.assertFalse(snapshot.isCurrent())
+                self.assertEqual(snapshot.getName(), csysName)
+                if csys.isCurrent():
+                    self.assertAlmostEqual(snapshot.getDate(), csys.dateFromTAI(tai))
+                    if csysName in ("apptopo", "obs", "none"):
+                        # date is TAI, so TAI = 0 gives date = 0, which is not a valid snapshot date
+                        self.assertRaises(Exception, csys.snapshot, 0)
+                    else:
+                        # date is Julian epoch, so TAI = 0 gives a valid date (about 1858.9)
+                        self.assertAlmostEqual(csys.snapshot(0).getDate(), csys.dateFromTAI(0))
+                else:
+                    self.assertEqual(snapshot.getDate(), date)
+                self.assertRaises(Exception, snapshot.setCurrDate, csys.dateFromTAI(tai))
+
+                if not csys.canConvert():
+                    continue
+                fk5Sys = coordConv.FK5CoordSys(2000)
+                predCoord = csys.convertFrom(fk5Sys, fromCoord, site, tai)
+                coord = snapshot.convertFrom(fk5Sys, fromCoord, site, tai)
+                self.assertLess(coord.angularSeparation(predCoord), 1e-10)
+
     def testDefaultConstructor(self):
         """Test default constructor
         """
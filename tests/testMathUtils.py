@@ -57,6 +57,44 @@ class TestMathUtils(unittest.TestCase):
             self.assertAlmostEqual(coordConv.asind(val) * coordConv.RadPerDeg, math.asin(val))
             self.assertAlmostEqual(coordConv.acosd(val) * coordConv.RadPerDeg, math.acos(val))
     
+    def testHypotExtremes(self):
+        """Test hypot for sides whose squares overflow or underflow, and for non-finite sides
+        """
+        for x, y in ((3e200, 4e200), (3e-200, 4e-200), (-3e200, 4e-200), (1e308, 1e308), (5e-324, 0)):
+            self.assertAlmostEqual(coordConv.hypot(x, y) / math.hypot(x, y), 1, places=14)
+        self.assertEqual(coordConv.hypot(0, 0), 0)
+        self.assertTrue(math.isinf(coordConv.hypot(float("inf"), 1)))
+        self.assertTrue(math.isinf(coordConv.hypot(float("nan"), float("-inf"))))
+        self.assertTrue(math.isnan(coordConv.hypot(float("nan"), 1)))
+        self.assertTrue(math.isnan(coordConv.hypot(float("nan"), 0)))
+        self.assertTrue(math.isnan(coordConv.hypot(0, float("nan"))))
+
+    def testSinCosD(self):
+        """Test sincosd
+        """
+        # exact at multiples of 90 degrees
+        for i in range(-12, 13):
+            sinAng, cosAng = coordConv.sincosd(i * 90)
+            self.assertEqual(sinAng, (0, 1, 0, -1)[i % 4])
+            self.assertEqual(cosAng, (1, 0, -1, 0)[i % 4])
+            self.assertEqual(coordConv.sincosd(i * 90 + 360 * 1e12), (sinAng, cosAng))
+
+        for ang in (0.5, -1, 31.2, 44.9999, 45, 45.0001, 89.99999, -235, 234324, 1e12 + 30, 123456789012.25):
+            sinAng, cosAng = coordConv.sincosd(ang)
+            # reduce large angles first, since sind and cosd lose accuracy for them
+            self.assertAlmostEqual(sinAng, coordConv.sind(math.fmod(ang, 360)))
+            self.assertAlmostEqual(cosAng, coordConv.cosd(math.fmod(ang, 360)))
+            self.assertAlmostEqual(sinAng**2 + cosAng**2, 1, places=15)
+
+        self.assertAlmostEqual(coordConv.sincosd(30)[0], 0.5, places=15)
+        self.assertAlmostEqual(coordConv.sincosd(60)[1], 0.5, places=15)
+        self.assertAlmostEqual(coordConv.sincosd(1e20)[0], coordConv.sind(math.fmod(1e20, 360)), places=15)
+
+        for ang in (float("nan"), float("inf"), float("-inf")):
+            sinAng, cosAng = coordConv.sincosd(ang)
+            self.assertTrue(math.isnan(sinAng))
+            self.assertTrue(math.isnan(cosAng))
+
     def testPolarFromXY(self):
         """Test polarFromXY and xyFromPolar
         """
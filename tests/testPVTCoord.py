@@ -347,6 +347,68 @@ class TestCoord(unittest.TestCase):
                 measToCoord = toPVTCoord.getCoord(tai)
                 self.assertAlmostEqual(predToCoord.angularSeparation(measToCoord), 0)
 
+    def testVelocityMethod(self):
+        """Test that analytic velocity in CoordSys.convertFrom matches velocity computed from two positions
+
+        The two-point method is only accurate to a few parts in 10^5 at typical TAI dates,
+        because tai + DeltaTForPos cannot be represented exactly.
+        """
+        tai = coordConv.TestTAI
+        site = coordConv.makeTestSite()
+
+        coordSysList = coordConv.makeCoordSysList(includeOtherDates=True)
+        coordSysList += [coordConv.AppTopoCoordSys(tai - 500), coordConv.ObsCoordSys(tai - 500)]
+
+        for fromCoordSys in coordSysList:
+            for toCoordSys in coordSysList:
+                for equatAng in (0, 71, -123.4):
+                    for polarAng in (-60, 0, 45):
+                        for equatVel in (0, 0.023):
+                            equatPVT = coordConv.PVT(equatAng, equatVel, tai)
+                            polarPVT = coordConv.PVT(polarAng, -0.012, tai)
+                            fromPVTCoord = coordConv.PVTCoord(equatPVT, polarPVT, coordConv.PVT(), 15, -21, 33)
+                            analyticPVTCoord = toCoordSys.convertFrom(fromCoordSys, fromPVTCoord, site,
+                                coordConv.VelocityMethod_Analytic)
+                            twoPointPVTCoord = toCoordSys.convertFrom(fromCoordSys, fromPVTCoord, site,
+                                coordConv.VelocityMethod_TwoPoint)
+                            self.assertAlmostEqual(
+                                analyticPVTCoord.getCoord().angularSeparation(twoPointPVTCoord.getCoord()), 0)
+                            analyticVel = numpy.array(analyticPVTCoord.getVel())
+                            twoPointVel = numpy.array(twoPointPVTCoord.getVel())
+                            posMag = numpy.linalg.norm(analyticPVTCoord.getCoord().getVecPos())
+                            velErr = numpy.linalg.norm(analyticVel - twoPointVel)
+                            self.assertLess(velErr, (1e-4 * numpy.linalg.norm(twoPointVel)) + (1e-12 * posMag))
+
+    def testOrientationMethod(self):
+        """Test that analytic orientation in CoordSys.convertFrom matches orientation computed from an offset position
+
+        Observed positions near altitude 5 degrees are avoided, because refraction has a kink there
+        (the offset method then measures a chord, rather than the local derivative).
+        """
+        tai = coordConv.TestTAI
+        site = coordConv.makeTestSite()
+        coordSysList = coordConv.makeCoordSysList(includeOtherDates=True)
+
+        for fromCoordSys in coordSysList:
+            for toCoordSys in coordSysList:
+                for equatAng in (0, 71, -123.4):
+                    for polarAng in (20, 45, 80):
+                        for pmRA in (0, 15):
+                            fromCoord = coordConv.Coord(equatAng, polarAng, 0.01, pmRA, -21, 33)
+                            for fromDir in (0, 37, -135):
+                                analyticCoord, analyticDir, analyticScale = toCoordSys.convertFrom(
+                                    fromCoordSys, fromCoord, fromDir, site, tai, coordConv.OrientationMethod_Analytic)
+                                offsetCoord, offsetDir, offsetScale = toCoordSys.convertFrom(
+                                    fromCoordSys, fromCoord, fromDir, site, tai, coordConv.OrientationMethod_Offset)
+                                self.assertEqual(analyticCoord, offsetCoord)
+                                if toCoordSys.getName() == "obs" and analyticCoord.getSphPos()[2] < 7:
+                                    continue
+                                self.assertAlmostEqual(analyticDir, coordConv.wrapNear(offsetDir, analyticDir), places=4)
+                                self.assertAlmostEqual(analyticScale, offsetScale, places=5)
+
+        icrsCoordSys = coordConv.ICRSCoordSys()
+        self.assertRaises(Exception, icrsCoordSys.convertFrom, icrsCoordSys, coordConv.Coord(10, 30), 0, site, tai, 99)
+
     def testLunarVel(self):
         """Sanity-check lunar tracking velocity
 
@@ -0,0 +1,207 @@
+/*
+Test that PVTCoord construction, methods and conversions do not allocate heap memory,
+nor do the non-throwing (try) methods when they fail
+
+Real-time control loops may forbid heap allocation after startup, so once the coordinate systems
+have been constructed and their caches filled (by one warm-up conversion), converting PVTCoords
+must not allocate, even as the date advances and the caches are refreshed. This test counts calls
+to the global operator new (which is used by std::vector, std::string, boost::shared_ptr, etc.);
+fixed-size Eigen objects never allocate.
+
+Returns 0 on success, 1 on failure.
+*/
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <string>
+#include "coordConv/coordConv.h"
+
+namespace {
+    bool countAllocs = false;   // count allocations?
+    long numAllocs = 0;         // number of allocations counted
+    int numFailures = 0;
+
+    void *countedAlloc(std::size_t size) {
+        if (countAllocs) {
+            ++numAllocs;
+        }
+        void *ptr = std::malloc(size == 0 ? 1 : size);
+        if (!ptr) {
+            throw std::bad_alloc();
+        }
+        return ptr;
+    }
+
+    /*
+    Start counting allocations
+    */
+    void startCounting() {
+        numAllocs = 0;
+        countAllocs = true;
+    }
+
+    /*
+    Stop counting allocations and report a failure if any were counted since startCounting was called
+
+    @param[in] desc  description of the code that was run
+    */
+    void checkNoAllocs(char const *desc) {
+        countAllocs = false;
+        if (numAllocs != 0) {
+            ++numFailures;
+            std::cout << "FAILED: " << desc << " made " << numAllocs << " heap allocations" << std::endl;
+        }
+    }
+}
+
+// the replacement operators must match the declarations in <new>, which differ between C++98 and C++11
+#if __cplusplus < 201103L
+#define COUNTALLOC_NEW_SPEC throw(std::bad_alloc)
+#define COUNTALLOC_DELETE_SPEC throw()
+#else
+#define COUNTALLOC_NEW_SPEC
+#define COUNTALLOC_DELETE_SPEC noexcept
+#endif
+
+void *operator new(std::size_t size) COUNTALLOC_NEW_SPEC {
+    return countedAlloc(size);
+}
+
+void *operator new[](std::size_t size) COUNTALLOC_NEW_SPEC {
+    return countedAlloc(size);
+}
+
+void operator delete(void *ptr) COUNTALLOC_DELETE_SPEC {
+    std::free(ptr);
+}
+
+void operator delete[](void *ptr) COUNTALLOC_DELETE_SPEC {
+    std::free(ptr);
+}
+
+int main() {
+    using namespace coordConv;
+
+    Site site(-105.822616, 32.780988, 2788);
+    site.setPoleWander(1.1e-4, -0.5e-4);
+    site.ut1_tai = -34.782;
+    site.refCoA = 1.2e-2;
+    site.refCoB = -1.3e-5;
+    double const startTAI = 4889900000.205;
+
+    char const * const nameList[] = {"icrs", "fk5", "fk4", "gal", "appgeo", "apptopo", "obs"};
+    int const numNames = sizeof(nameList) / sizeof(nameList[0]);
+    CoordSys::Ptr coordSysList[numNames];
+    for (int i = 0; i < numNames; ++i) {
+        std::string const name(nameList[i]);
+        double const date = (name == "fk5") ? 1980 : ((name == "fk4") ? 1950 : 0);
+        coordSysList[i] = makeCoordSys(name, date);
+    }
+
+    PVT const equatPVT(35.0, 0.01, startTAI);
+    PVT const polarPVT(45.0, -0.003, startTAI);
+    PVT const distPVT(distanceFromParallax(0.05), 0, startTAI);
+    PVT const orientPVT(30.0, 0.02, startTAI);
+    PVT const offsetDistPVT(0.5, 0.001, startTAI);
+
+    // the first pass fills caches; later passes must not allocate. Each pass advances the date by more than
+    // the maximum age of the AppGeoCache, so every pass after the first refreshes the apparent geocentric data
+    double const passDTAI = 1.0;
+    for (int pass = 0; pass < 4; ++pass) {
+        bool const doCheck = pass > 0;
+        double const tai = startTAI + (pass * passDTAI);
+
+        if (doCheck) startCounting();
+        PVTCoord const fixedPVTCoord(equatPVT, polarPVT, PVT());
+        PVTCoord const pvtCoord(equatPVT, polarPVT, distPVT, 3.5, -2.1, 15.0);
+        PVTCoord const pairPVTCoord(Coord(35.0, 45.0), Coord(35.001, 45.002), tai, 0.01);
+        PVTCoord const copiedPVTCoord = pvtCoord.copy(tai);
+        if (doCheck) checkNoAllocs("PVTCoord constructors and copy");
+
+        if (doCheck) startCounting();
+        PVT equatRes, polarRes, toOrient;
+        pvtCoord.getSphPVT(equatRes, polarRes);
+        pvtCoord.getDistance();
+        pvtCoord.angularSeparation(fixedPVTCoord);
+        pvtCoord.orientationTo(fixedPVTCoord);
+        PVTCoord const offsetPVTCoord = pvtCoord.offset(toOrient, orientPVT, offsetDistPVT);
+        if (doCheck) checkNoAllocs("PVTCoord methods");
+
+        for (int fromInd = 0; fromInd < numNames; ++fromInd) {
+            CoordSys &fromCoordSys = *coordSysList[fromInd];
+            for (int toInd = 0; toInd < numNames; ++toInd) {
+                CoordSys const &toCoordSys = *coordSysList[toInd];
+                std::string const desc = std::string(nameList[fromInd]) + " to " + nameList[toInd];
+                std::string const orientDesc = desc + " with orientation";
+                PVTCoord const fromPVTCoord = pvtCoord.copy(tai);
+                PVT toDir;
+                double scaleChange;
+
+                if (doCheck) startCounting();
+                toCoordSys.convertFrom(fromCoordSys, fromPVTCoord, site, VelocityMethod_Analytic);
+                toCoordSys.convertFrom(fromCoordSys, fromPVTCoord, site, VelocityMethod_TwoPoint);
+                if (doCheck) checkNoAllocs(desc.c_str());
+
+                if (doCheck) startCounting();
+                toCoordSys.convertFrom(toDir, scaleChange, fromCoordSys, fromPVTCoord, orientPVT, site,
+                    OrientationMethod_Analytic);
+                toCoordSys.convertFrom(toDir, scaleChange, fromCoordSys, fromPVTCoord, orientPVT, site,
+                    OrientationMethod_Offset);
+                if (doCheck) checkNoAllocs(orientDesc.c_str());
+            }
+
+            std::string const removePMDesc = std::string(nameList[fromInd]) + " removePM";
+            if (doCheck) startCounting();
+            fromCoordSys.removePM(pvtCoord.copy(tai));
+            if (doCheck) checkNoAllocs(removePMDesc.c_str());
+        }
+
+        // failures reported by the try methods must not allocate, either
+        if (doCheck) startCounting();
+        CoordSys const &icrsCoordSys = *coordSysList[0];
+        CoordSys const &appGeoCoordSys = *coordSysList[4];
+        PVTCoord const polePVTCoord(PVT(0, 0, tai), PVT(90, 0, tai), PVT());
+        PVTCoord toPVTCoord;
+        PVT toDir;
+        double scaleChange;
+        int numOK = 0;
+        numOK += appGeoCoordSys.tryConvertFrom(toPVTCoord, icrsCoordSys, polePVTCoord, site,
+            VelocityMethodEnum(-1)) == ConvertStatus_OK;
+        numOK += appGeoCoordSys.tryConvertFrom(toPVTCoord, toDir, scaleChange, icrsCoordSys, polePVTCoord,
+            orientPVT, site) == ConvertStatus_OK;
+        numOK += polePVTCoord.tryOffset(toPVTCoord, toDir, orientPVT, offsetDistPVT) == ConvertStatus_OK;
+        Coord toCoord;
+        numOK += appGeoCoordSys.tryConvertFrom(toCoord, icrsCoordSys, polePVTCoord.getCoord(), site, 1e15)
+            == ConvertStatus_OK;
+        numOK += appGeoCoordSys.trySetCurrDate(tai) == ConvertStatus_OK;
+        numOK += coordSysList[1]->trySetCurrDate(1980) == ConvertStatus_OK;
+        if (doCheck) checkNoAllocs("try methods that fail");
+        if (numOK != 0) {
+            ++numFailures;
+            std::cout << "FAILED: " << numOK << " try methods that should have failed succeeded" << std::endl;
+        }
+    }
+
+    // an interpolating AppGeoCache must not allocate, even when a coordinate system enters a new grid interval
+    AppGeoCache::Ptr interpCachePtr(new AppGeoCache(60.0 / (SecPerDay * DaysPerYear), 0, AppGeoCacheMode_Interpolate));
+    AppGeoCoordSys interpCoordSys(interpCachePtr);
+    CoordSys const &icrsCoordSys = *coordSysList[0];
+    double const gridTAI = interpCoordSys.taiFromDate(
+        (std::floor(interpCoordSys.dateFromTAI(startTAI) / interpCachePtr->getMaxAge()) + 0.1)
+        * interpCachePtr->getMaxAge());
+    Coord const fromCoord(35.0, 45.0, 0.05, 3.5, -2.1, 15.0);
+    interpCoordSys.convertFrom(icrsCoordSys, fromCoord, site, gridTAI);
+    startCounting();
+    for (int i = 0; i < 100; ++i) {
+        interpCoordSys.convertFrom(icrsCoordSys, fromCoord, site, gridTAI + (i * 3.0));
+    }
+    checkNoAllocs("appgeo with an interpolating cache");
+
+    if (numFailures > 0) {
+        std::cout << numFailures << " failures" << std::endl;
+        return 1;
+    }
+    std::cout << "no heap allocations" << std::endl;
+    return 0;
+}
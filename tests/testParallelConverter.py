@@ -0,0 +1,81 @@
+#!/usr/bin/env python
+from __future__ import absolute_import, division
+
+import os
+import shutil
+import tempfile
+import unittest
+
+import numpy
+
+import coordConv
+
+class TestParallelConverter(unittest.TestCase):
+    def setUp(self):
+        self.site = coordConv.makeTestSite()
+        self.tai = coordConv.TestTAI
+
+    def makeCoordArr(self):
+        return coordConv.makeCoordArr(numpy.arange(0, 360, 17.3), (-75, -10, 0, 4, 33.3, 89))
+
+    def testConvert(self):
+        """Test that ParallelConverter.convert matches ConversionPlan.convert
+        """
+        fromCoordArr = self.makeCoordArr()
+        coordSysList = coordConv.makeCoordSysList()
+        for fromCoordSys in coordSysList:
+            for toCoordSys in coordSysList:
+                plan = coordConv.ConversionPlan(fromCoordSys, toCoordSys, self.site, self.tai)
+                predToCoordArr = coordConv.CoordArray()
+                plan.convert(predToCoordArr, fromCoordArr)
+                for numThreads in (1, 3, 8):
+                    for chunkSize in (1, 10, 1024):
+                        converter = coordConv.ParallelConverter(fromCoordSys, toCoordSys, self.site, self.tai,
+                            numThreads, chunkSize)
+                        self.assertEqual(converter.getNumThreads(), numThreads)
+                        self.assertEqual(converter.getChunkSize(), chunkSize)
+                        toCoordArr = coordConv.CoordArray()
+                        converter.convert(toCoordArr, fromCoordArr)
+                        self.assertEqual(toCoordArr.size(), fromCoordArr.size())
+                        for i in range(toCoordArr.size()):
+                            predToCoord = predToCoordArr.getCoord(i)
+                            toCoord = toCoordArr.getCoord(i)
+                            self.assertLess(predToCoord.angularSeparation(toCoord), 1e-12)
+                            self.assertTrue(numpy.allclose(predToCoord.getVecPM(), toCoord.getVecPM()))
+
+    def testConvertFile(self):
+        """Test that ParallelConverter.convertFile matches CatalogConverter.convertFile
+        """
+        tempDir = tempfile.mkdtemp()
+        try:
+            fromPath = os.path.join(tempDir, "fromCat.bin")
+            predToPath = os.path.join(tempDir, "predToCat.bin")
+            toPath = os.path.join(tempDir, "toCat.bin")
+            recList = [(equatAng, polarAng, 0.01, 1.5, -2.5, 10)
+                for equatAng in numpy.arange(0, 360, 3.7) for polarAng in (-60, 0, 45)]
+            numpy.array(recList, dtype=float).tofile(fromPath)
+
+            fromCoordSys = coordConv.ICRSCoordSys()
+            toCoordSys = coordConv.ObsCoordSys()
+            catalogConverter = coordConv.CatalogConverter(fromCoordSys, toCoordSys, self.site, self.tai)
+            catalogConverter.convertFile(predToPath, fromPath)
+            converter = coordConv.ParallelConverter(fromCoordSys, toCoordSys, self.site, self.tai, 4, 16)
+            self.assertEqual(converter.convertFile(toPath, fromPath), len(recList))
+            predToRecArr = numpy.fromfile(predToPath, dtype=float)
+            toRecArr = numpy.fromfile(toPath, dtype=float)
+            self.assertTrue(numpy.array_equal(toRecArr, predToRecArr))
+        finally:
+            shutil.rmtree(tempDir)
+
+    def testErrors(self):
+        """Test invalid arguments
+        """
+        icrsCoordSys = coordConv.ICRSCoordSys()
+        galCoordSys = coordConv.GalCoordSys()
+        self.assertGreaterEqual(coordConv.ParallelConverter(icrsCoordSys, galCoordSys, self.site, self.tai).getNumThreads(), 1)
+        self.assertRaises(ValueError, coordConv.ParallelConverter, icrsCoordSys, galCoordSys, self.site, self.tai, -1)
+        self.assertRaises(ValueError, coordConv.ParallelConverter, icrsCoordSys, galCoordSys, self.site, self.tai, 2, 0)
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -50,8 +50,115 @@ class TestSite(unittest.TestCase):
                         else:
                             # make sure Site construction raises an exception
                             self.assertRaises(Exception, coordConv.Site, long, lat, elev)
-                    
-        
+
+    def testRefractionCache(self):
+        """Test refraction with Site.refractionCachePtr set against refraction computed by iteration
+        """
+        site = coordConv.makeTestSite()
+        exactSite = coordConv.Site(site)
+        site.refractionCachePtr = coordConv.RefractionCache()
+        self.assertEqual(site.refractionCachePtr.getNumIntervals(), coordConv.RefractionTableSize)
+        self.assertTrue(site.refractionCachePtr.getTable() is None)
+        siteCopy = coordConv.Site(site)
+
+        appTopoCoordSys = coordConv.AppTopoCoordSys(0)
+        obsCoordSys = coordConv.ObsCoordSys(0)
+        tai = coordConv.TestTAI
+        for alt in (90, 89.9, 60, 45.3, 20, 10, 5.1, 5, 4.9, 2, 0, -5, -45, -90):
+            for az in (0, 35.7, 181):
+                fromCoord = coordConv.Coord(az, alt)
+                for fromCoordSys, toCoordSys in (
+                    (appTopoCoordSys, obsCoordSys),
+                    (obsCoordSys, appTopoCoordSys),
+                ):
+                    tableCoord = toCoordSys.convertFrom(fromCoordSys, fromCoord, site, tai)
+                    exactCoord = toCoordSys.convertFrom(fromCoordSys, fromCoord, exactSite, tai)
+                    self.assertLess(tableCoord.angularSeparation(exactCoord) * 3600, 1e-6)
+                    roundTripCoord = fromCoordSys.convertFrom(toCoordSys, tableCoord, site, tai)
+                    self.assertLess(roundTripCoord.angularSeparation(fromCoord) * 3600, 1e-6)
+
+        # copies of a site share the cache, and the table is only rebuilt if the coefficients change
+        table = siteCopy.refractionCachePtr.getTable()
+        self.assertEqual(table.refCoA, site.refCoA)
+        self.assertEqual(table.refCoB, site.refCoB)
+        self.assertAlmostEqual(table.zdrMinusZDu(0), 0)
+        self.assertAlmostEqual(table.zduMinusZDr(0), 0)
+        self.assertAlmostEqual(table.zdrMinusZDu(85), table.zdrMinusZDu(95))
+        self.assertAlmostEqual(table.zdrMinusZDu(85), -table.zduMinusZDr(95))
+        self.assertTrue(site.refractionCachePtr.getTable(site.refCoA, site.refCoB) is not None)
+        self.assertEqual(site.refractionCachePtr.getTable().zdrMinusZDu(45.0), table.zdrMinusZDu(45.0))
+        site.refCoA = 1.1e-2
+        obsCoordSys.convertFrom(appTopoCoordSys, coordConv.Coord(0, 45), site, tai)
+        self.assertEqual(siteCopy.refractionCachePtr.getTable().refCoA, 1.1e-2)
+
+        self.assertRaises(Exception, coordConv.RefractionCache, 0)
+        self.assertRaises(Exception, coordConv.RefractionTable, 1.2e-2, -1.3e-5, 0)
+
+    def testRefCoFromWeather(self):
+        """Test refCoFromWeather, Site.setRefCoFromWeather and RefCoCache
+        """
+        site = coordConv.makeTestSite()
+        refCoA, refCoB = coordConv.refCoFromWeather(site, 730, 10, 0.3, 5500)
+        self.assertGreater(refCoA, 0)
+        self.assertLess(refCoB, 0)
+        # refraction increases with pressure and decreases with temperature
+        self.assertGreater(coordConv.refCoFromWeather(site, 740, 10, 0.3, 5500)[0], refCoA)
+        self.assertLess(coordConv.refCoFromWeather(site, 730, 20, 0.3, 5500)[0], refCoA)
+
+        site.setRefCoFromWeather(730, 10, 0.3, 5500)
+        self.assertEqual(site.refCoA, refCoA)
+        self.assertEqual(site.refCoB, refCoB)
+        self.assertEqual(site.wavelen, 5500)
+        for badArgs in (
+            (-1, 10, 0.3, 5500),
+            (730, -300, 0.3, 5500),
+            (730, 10, 1.1, 5500),
+            (730, 10, 0.3, 0),
+            (730, 10, float("nan"), 5500),
+        ):
+            self.assertRaises(ValueError, coordConv.refCoFromWeather, site, *badArgs)
+            self.assertRaises(ValueError, site.setRefCoFromWeather, *badArgs)
+        self.assertEqual(site.refCoA, refCoA)
+
+        # weather that rounds the same way gives identical coefficients, so refraction tables are not rebuilt
+        site.refCoCachePtr = coordConv.RefCoCache()
+        site.refractionCachePtr = coordConv.RefractionCache()
+        siteCopy = coordConv.Site(site)
+        obsCoordSys = coordConv.ObsCoordSys(0)
+        appTopoCoordSys = coordConv.AppTopoCoordSys(0)
+        tai = coordConv.TestTAI
+        table = None
+        for pressure, temp, relHumidity, wavelen in (
+            (730.001, 10.002, 0.3002, 5500.3),
+            (729.998, 9.997, 0.2996, 5499.6),
+            (730, 10, 0.3, 5500),
+        ):
+            site.setRefCoFromWeather(pressure, temp, relHumidity, wavelen)
+            self.assertEqual(site.refCoA, refCoA)
+            self.assertEqual(site.refCoB, refCoB)
+            self.assertEqual(site.wavelen, 5500) # the wavelength for which refCoA and refCoB were computed
+            obsCoordSys.convertFrom(appTopoCoordSys, coordConv.Coord(0, 45), site, tai)
+            if table is None:
+                table = site.refractionCachePtr.getTable()
+            else:
+                self.assertTrue(site.refractionCachePtr.getTable() is table)
+        self.assertEqual(siteCopy.refCoCachePtr.size(), 1)
+        site.setRefCoFromWeather(735, 10, 0.3, 5500)
+        self.assertEqual(siteCopy.refCoCachePtr.size(), 2)
+        self.assertGreater(site.refCoA, refCoA)
+        site.refCoCachePtr.clear()
+        self.assertEqual(site.refCoCachePtr.size(), 0)
+
+        smallCache = coordConv.RefCoCache(0.01, 0.01, 0.001, 1.0, 1.0e-5, 2)
+        self.assertEqual(smallCache.getMaxSize(), 2)
+        for pressure in (700, 710, 720, 730):
+            smallWavelen = smallCache.getRefCo(site, pressure, 10, 0.3, 5500.4)[0]
+            self.assertEqual(smallWavelen, 5500)
+            self.assertLessEqual(smallCache.size(), 2)
+        self.assertRaises(ValueError, coordConv.RefCoCache, 0)
+        self.assertRaises(ValueError, coordConv.RefCoCache, 0.01, 0.01, 0.001, 1.0, 1.0e-5, 0)
+
+
 
 if __name__ == '__main__':
     unittest.main()
@@ -0,0 +1,116 @@
+#!/usr/bin/env python
+from __future__ import absolute_import, division
+
+import threading
+import unittest
+
+import numpy
+
+import coordConv
+
+class TestSphArrays(unittest.TestCase):
+    def setUp(self):
+        self.site = coordConv.makeTestSite()
+        self.tai = coordConv.TestTAI
+
+        self.equatAng = numpy.arange(0, 360, 13.7)
+        numPos = len(self.equatAng)
+        self.polarAng = numpy.linspace(-70, 80, numPos)
+        self.parallax = numpy.linspace(0, 0.02, numPos)
+        self.equatPM = numpy.linspace(-3, 5, numPos)
+        self.polarPM = numpy.linspace(4, -2, numPos)
+        self.radVel = numpy.linspace(-20, 30, numPos)
+        self.fromDir = numpy.linspace(-170, 170, numPos)
+
+    def testConvertSphArrays(self):
+        """Test that convertSphArrays matches CoordSys.convertFrom
+        """
+        for fromCoordSys in coordConv.makeCoordSysList():
+            for toCoordSys in coordConv.makeCoordSysList():
+                for fromDir in (None, self.fromDir):
+                    for numThreads in (1, 3):
+                        res = coordConv.convertSphArrays(fromCoordSys, toCoordSys, self.site, self.tai,
+                            self.equatAng, self.polarAng, self.parallax, self.equatPM, self.polarPM, self.radVel,
+                            fromDir=fromDir, numThreads=numThreads)
+                        self.assertEqual(len(res.equatAng), len(self.equatAng))
+                        if fromDir is None:
+                            self.assertIsNone(res.dir)
+                            self.assertIsNone(res.scaleChange)
+                        for i in range(len(self.equatAng)):
+                            fromCoord = coordConv.Coord(self.equatAng[i], self.polarAng[i], self.parallax[i],
+                                self.equatPM[i], self.polarPM[i], self.radVel[i])
+                            if fromDir is None:
+                                predToCoord = toCoordSys.convertFrom(fromCoordSys, fromCoord, self.site, self.tai)
+                            else:
+                                predToCoord, predToDir, predScaleChange = toCoordSys.convertFrom(
+                                    fromCoordSys, fromCoord, fromDir[i], self.site, self.tai)
+                                coordConv.assertAnglesAlmostEqual(res.dir[i], predToDir)
+                                self.assertAlmostEqual(res.scaleChange[i], predScaleChange)
+                            toCoord = coordConv.Coord(res.equatAng[i], res.polarAng[i], res.parallax[i])
+                            self.assertLess(predToCoord.angularSeparation(toCoord), 1e-9)
+                            self.assertAlmostEqual(predToCoord.getParallax(), res.parallax[i])
+                            self.assertAlmostEqual(predToCoord.getRadVel(), res.radVel[i])
+                            atPole, predEquatPM, predPolarPM = predToCoord.getPM()
+                            self.assertAlmostEqual(predEquatPM, res.equatPM[i])
+                            self.assertAlmostEqual(predPolarPM, res.polarPM[i])
+
+    def testBroadcast(self):
+        """Test that scalar arguments are broadcast
+        """
+        icrsCoordSys = coordConv.ICRSCoordSys()
+        galCoordSys = coordConv.GalCoordSys()
+        res = coordConv.convertSphArrays(icrsCoordSys, galCoordSys, self.site, self.tai, self.equatAng, 45)
+        res2 = coordConv.convertSphArrays(icrsCoordSys, galCoordSys, self.site, self.tai,
+            self.equatAng, numpy.ones(len(self.equatAng)) * 45, numpy.zeros(len(self.equatAng)))
+        for i in range(6):
+            self.assertTrue(numpy.array_equal(res[i], res2[i]))
+
+        res = coordConv.convertSphArrays(icrsCoordSys, galCoordSys, self.site, self.tai, 10, 20, fromDir=30)
+        self.assertEqual(len(res.equatAng), 1)
+        toCoord, toDir, scaleChange = galCoordSys.convertFrom(icrsCoordSys, coordConv.Coord(10, 20), 30,
+            self.site, self.tai)
+        coordConv.assertAnglesAlmostEqual(res.dir[0], toDir)
+
+        res = coordConv.convertSphArrays(icrsCoordSys, galCoordSys, self.site, self.tai, [], [])
+        self.assertEqual(len(res.equatAng), 0)
+
+    def testErrors(self):
+        """Test invalid arguments
+        """
+        icrsCoordSys = coordConv.ICRSCoordSys()
+        galCoordSys = coordConv.GalCoordSys()
+        self.assertRaises(ValueError, coordConv.convertSphArrays, icrsCoordSys, galCoordSys, self.site, self.tai,
+            [1, 2, 3], [4, 5])
+        self.assertRaises(ValueError, coordConv.convertSphArrays, icrsCoordSys, galCoordSys, self.site, self.tai,
+            numpy.zeros((2, 2)), 0)
+        self.assertRaises(RuntimeError, coordConv.convertSphArrays, icrsCoordSys, galCoordSys, self.site, self.tai,
+            [1, 2], [3, 95])
+        self.assertRaises(ValueError, coordConv.convertSphArray, icrsCoordSys, galCoordSys,
+            numpy.zeros((3, 5)), self.site, self.tai)
+        self.assertRaises(ValueError, coordConv.convertSphDirArray, icrsCoordSys, galCoordSys,
+            numpy.zeros((3, 6)), numpy.zeros(2), self.site, self.tai)
+
+    def testThreads(self):
+        """Test calling convertSphArrays from several Python threads at once (it releases the GIL)
+        """
+        icrsCoordSys = coordConv.ICRSCoordSys()
+        obsCoordSys = coordConv.ObsCoordSys()
+        equatAng = numpy.linspace(0, 360, 5000)
+        predRes = coordConv.convertSphArrays(icrsCoordSys, obsCoordSys, self.site, self.tai, equatAng, 30)
+        resList = [None]*4
+
+        def runConversion(ind):
+            resList[ind] = coordConv.convertSphArrays(icrsCoordSys, obsCoordSys, self.site, self.tai, equatAng, 30)
+
+        threadList = [threading.Thread(target=runConversion, args=(ind,)) for ind in range(len(resList))]
+        for thread in threadList:
+            thread.start()
+        for thread in threadList:
+            thread.join()
+        for res in resList:
+            for i in range(6):
+                self.assertTrue(numpy.array_equal(res[i], predRes[i]))
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -76,6 +76,25 @@ class TestTestUtils(unittest.TestCase):
                                             tPlaces = tPlaces,
                                         )
 
+    def testFixtures(self):
+        site = coordConv.makeTestSite()
+        self.assertEqual(site.ut1_tai, -34.782)
+        self.assertEqual((site.refCoA, site.refCoB), (1.2e-2, -1.3e-5))
+
+        coordSysList = coordConv.makeCoordSysList()
+        self.assertEqual([csys.getName() for csys in coordSysList],
+            ["icrs", "gal", "appgeo", "apptopo", "obs", "fk5", "fk4"])
+        coordSysList = coordConv.makeCoordSysList(includeOtherDates=True)
+        self.assertEqual([csys.getName() for csys in coordSysList],
+            ["icrs", "gal", "appgeo", "apptopo", "obs", "fk5", "fk4", "icrs", "fk5", "gal"])
+
+        coordArr = coordConv.makeCoordArr((0, 45, 90), (-30, 60))
+        self.assertEqual(coordArr.size(), 3 * 2 * 2)
+        self.assertEqual(coordArr.getCoord(0).angularSeparation(coordConv.Coord(0, -30)), 0)
+        self.assertFalse(coordArr.getCoord(0).hasPM())
+        self.assertTrue(coordArr.getCoord(1).hasPM())
+        self.assertAlmostEqual(coordArr.getCoord(1).getParallax(), 0.012)
+
 
 
 
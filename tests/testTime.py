@@ -542,5 +542,32 @@ class TestTime(unittest.TestCase):
             for tai in (4232.89, 20000.32, 56350.03, 74222.9):
                 self.assertAlmostEqual(coordConv.lastFromTAI(tai, site), lastFromTAI(tai, site), places=3)
 
+    def testSiderealTimeCache(self):
+        """Test lastFromTAI with Site.lastCachePtr set
+        """
+        site = coordConv.makeTestSite()
+        exactSite = coordConv.Site(site)
+        site.lastCachePtr = coordConv.SiderealTimeCache(600)
+        self.assertEqual(site.lastCachePtr.getMaxAge(), 600)
+        self.assertTrue(site.lastCachePtr.getData() is None)
+        siteCopy = coordConv.Site(site)
+        for ut1_tai in (0, -10.5, 0.3):
+            site.ut1_tai = ut1_tai
+            exactSite.ut1_tai = ut1_tai
+            for startTAI in (4232.89 * 86400, 56350.03 * 86400, 74222.9 * 86400):
+                for dTAI in (0, 0.1, 1.5, 299.9, -599.9, 600.1, 3000.0, -1e5):
+                    tai = startTAI + dTAI
+                    cachedLAST = coordConv.lastFromTAI(tai, site)
+                    exactLAST = coordConv.lastFromTAI(tai, exactSite)
+                    self.assertLess(abs(coordConv.wrapCtr(cachedLAST - exactLAST)) * 3600, 1e-4)
+                    self.assertGreaterEqual(cachedLAST, 0)
+                    self.assertLess(cachedLAST, 360)
+                    self.assertLessEqual(abs(tai + coordConv.TT_TAI - site.lastCachePtr.getData().tt), 600)
+
+        # copies of a site share the cache
+        self.assertTrue(siteCopy.lastCachePtr.getData() is not None)
+
+        self.assertRaises(Exception, coordConv.SiderealTimeCache, -1.0)
+
 if __name__ == '__main__':
     unittest.main()
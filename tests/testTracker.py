@@ -0,0 +1,99 @@
+#!/usr/bin/env python
+from __future__ import absolute_import, division
+
+import unittest
+
+import numpy
+
+import coordConv
+
+class TestTracker(unittest.TestCase):
+    def setUp(self):
+        self.site = coordConv.makeTestSite()
+        self.tai = coordConv.TestTAI
+
+    def testConvert(self):
+        """Test that Tracker.convert matches CoordSys.convertFrom
+        """
+        for fromCoordSys in (coordConv.ICRSCoordSys(), coordConv.FK5CoordSys(1980), coordConv.GalCoordSys(2000)):
+            for toCoordSys in (coordConv.AppTopoCoordSys(), coordConv.ObsCoordSys()):
+                tracker = coordConv.Tracker(fromCoordSys, toCoordSys, self.site)
+                self.assertFalse(tracker.isPrepared(self.tai))
+                self.assertRaises(Exception, tracker.convert, coordConv.Coord(10, 20), self.tai)
+                for taiAhead in (self.tai, self.tai + 15):
+                    tracker.prepare(taiAhead)
+                    self.assertEqual(tracker.getPreparedTAI(), taiAhead)
+                    for dTAI in (-tracker.getMaxDTAI(), -1.1, 0, 5.3, tracker.getMaxDTAI()):
+                        tai = taiAhead + dTAI
+                        self.assertTrue(tracker.isPrepared(tai))
+                        for equatAng in (0, 95, 233):
+                            for polarAng in (-30, 0, 45, 80):
+                                fromCoord = coordConv.Coord(equatAng, polarAng, 0.01, 3.1, -4.2, 15)
+                                predCoord = toCoordSys.convertFrom(fromCoordSys, fromCoord, self.site, tai)
+                                coord = tracker.convert(fromCoord, tai)
+                                self.assertLess(predCoord.angularSeparation(coord) * 3600, 1e-3)
+                    self.assertFalse(tracker.isPrepared(taiAhead + tracker.getMaxDTAI() * 1.01))
+                    self.assertRaises(Exception, tracker.convert, fromCoord, taiAhead + tracker.getMaxDTAI() * 1.01)
+
+                # setSite invalidates prepared data
+                tracker.setSite(self.site)
+                self.assertFalse(tracker.isPrepared(taiAhead))
+
+    def testStats(self):
+        """Test Tracker latency statistics
+        """
+        tracker = coordConv.Tracker(coordConv.ICRSCoordSys(), coordConv.ObsCoordSys(), self.site)
+        tracker.prepare(self.tai)
+        numConv = 100
+        for i in range(numConv):
+            tracker.convert(coordConv.Coord(i, 45), self.tai + (i * 0.05))
+        for stage, predCount in (
+            (coordConv.TrackerStage_Prepare, 1),
+            (coordConv.TrackerStage_AppGeo, numConv),
+            (coordConv.TrackerStage_AppTopo, numConv),
+            (coordConv.TrackerStage_Obs, numConv),
+            (coordConv.TrackerStage_Convert, numConv),
+        ):
+            stats = tracker.getStats(stage)
+            self.assertEqual(stats.count, predCount)
+            self.assertTrue(0 <= stats.min <= stats.p50 <= stats.p99 <= stats.max)
+            self.assertTrue(stats.min <= stats.mean <= stats.max)
+        self.assertRaises(Exception, tracker.getStats, coordConv.TrackerStage_NumStages)
+
+        tracker.resetStats()
+        stats = tracker.getStats(coordConv.TrackerStage_Convert)
+        self.assertEqual(stats.count, 0)
+        self.assertTrue(numpy.isnan(stats.max))
+
+    def testLatencyHistogram(self):
+        """Test LatencyHistogram percentiles
+        """
+        hist = coordConv.LatencyHistogram()
+        for i in range(1, 1001):
+            hist.record(i * 1e-6)
+        stats = hist.getStats()
+        self.assertEqual(stats.count, 1000)
+        self.assertAlmostEqual(stats.min, 1e-6)
+        self.assertAlmostEqual(stats.max, 1e-3)
+        self.assertAlmostEqual(stats.mean, 500.5e-6)
+        # percentiles are accurate to one bin (a factor of 10**0.05)
+        binRatio = 10**0.05
+        self.assertTrue(500e-6 <= stats.p50 <= 500e-6 * binRatio)
+        self.assertTrue(990e-6 <= stats.p99 <= 990e-6 * binRatio)
+
+    def testInvalidArgs(self):
+        """Test invalid constructor arguments
+        """
+        for fromCoordSys, toCoordSys in (
+            (coordConv.AppGeoCoordSys(), coordConv.ObsCoordSys()),
+            (coordConv.ICRSCoordSys(), coordConv.AppGeoCoordSys()),
+            (coordConv.ICRSCoordSys(), coordConv.FK5CoordSys(2000)),
+            (coordConv.ICRSCoordSys(), coordConv.AppTopoCoordSys(self.tai)),
+            (coordConv.ICRSCoordSys(), coordConv.ObsCoordSys(self.tai)),
+        ):
+            self.assertRaises(Exception, coordConv.Tracker, fromCoordSys, toCoordSys, self.site)
+        self.assertRaises(Exception, coordConv.Tracker, coordConv.ICRSCoordSys(), coordConv.ObsCoordSys(), self.site, 0)
+
+
+if __name__ == '__main__':
+    unittest.main()